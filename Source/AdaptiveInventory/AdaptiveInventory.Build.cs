@@ -19,11 +19,18 @@ public class AdaptiveInventory : ModuleRules
 			"GameplayStateTreeModule",
 			"UMG",
 			"Slate",
-			"SlateCore"
+			"SlateCore",
+			"NetCore"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
 
+		// The PIE replication tests drive the editor's play session
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+
 		PublicIncludePaths.AddRange(new string[] {
 			"AdaptiveInventory",
 			"AdaptiveInventory/Variant_Platforming",
@@ -3,9 +3,97 @@
 #include "Core/InventoryBlueprintLibrary.h"
 #include "Core/InventoryManagerSubsystem.h"
 #include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
 #include "Engine/GameInstance.h"
 #include "Kismet/GameplayStatics.h"
 
+UInventoryItemDefinition* UInventoryBlueprintLibrary::GetOrCreateItemDefinition(
+	UObject* WorldContextObject,
+	FText ItemName,
+	FText ItemDescription,
+	EItemCategory Category,
+	EItemRarity Rarity,
+	bool bStackable,
+	int32 MaxStackSize)
+{
+	UInventoryManagerSubsystem* InventoryManager = GetInventoryManager(WorldContextObject);
+	if (!InventoryManager)
+	{
+		return nullptr;
+	}
+
+	MaxStackSize = bStackable ? FMath::Max(1, MaxStackSize) : 1;
+
+	const FName BaseId = MakeItemDefinitionId(ItemName, ItemDescription, Category, Rarity, MaxStackSize);
+	FName DefinitionId = BaseId;
+	int32 Suffix = 0;
+
+	// The ID only hashes the text - a different definition under it gets the next free suffix instead
+	while (UInventoryItemDefinition* Existing = InventoryManager->FindItemDefinition(DefinitionId))
+	{
+		if (Existing->DisplayName.ToString().Equals(ItemName.ToString(), ESearchCase::CaseSensitive) &&
+			Existing->Description.ToString().Equals(ItemDescription.ToString(), ESearchCase::CaseSensitive) &&
+			Existing->Category == Category && Existing->Rarity == Rarity &&
+			Existing->bIsStackable == bStackable && Existing->MaxStackSize == MaxStackSize)
+		{
+			return Existing;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("GetOrCreateItemDefinition: %s is already used by a different definition"), *DefinitionId.ToString());
+		DefinitionId = FName(*FString::Printf(TEXT("%s_%d"), *BaseId.ToString(), ++Suffix));
+	}
+
+	UInventoryItemDefinition* Definition = NewObject<UInventoryItemDefinition>(InventoryManager->GetGameInstance());
+	Definition -> DefinitionId = DefinitionId;
+	Definition -> DisplayName = ItemName;
+	Definition -> Description = ItemDescription;
+	Definition -> Category = Category;
+	Definition -> Rarity = Rarity;
+	Definition -> bIsStackable = bStackable;
+	Definition -> MaxStackSize = MaxStackSize;
+
+	InventoryManager->RegisterItemDefinition(Definition);
+
+	UE_LOG(LogTemp, Log, TEXT("Created item definition: %s"), *DefinitionId.ToString());
+	return Definition;
+}
+
+FName UInventoryBlueprintLibrary::MakeItemDefinitionId(const FText& ItemName, const FText& ItemDescription, EItemCategory Category,
+	EItemRarity Rarity, int32 MaxStackSize)
+{
+	// Everything that affects display or stacking is part of the ID
+	const FString ItemNameString = ItemName.ToString();
+	const uint32 TextHash = FCrc::StrCrc32(*ItemDescription.ToString(), FCrc::StrCrc32(*ItemNameString));
+
+	return FName(*FString::Printf(TEXT("%s.%s.%s.%d.%08x"),
+		*StaticEnum<EItemCategory>()->GetNameStringByValue(static_cast<int64>(Category)),
+		*ItemNameString,
+		*StaticEnum<EItemRarity>()->GetNameStringByValue(static_cast<int64>(Rarity)),
+		MaxStackSize,
+		TextHash));
+}
+
+UInventoryItemData* UInventoryBlueprintLibrary::CreateItemFromDefinition(
+	UObject* WorldContextObject,
+	UInventoryItemDefinition* Definition,
+	int32 StackSize)
+{
+	if (!WorldContextObject || !Definition)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CreateItemFromDefinition: Invalid world context or definition"));
+		return nullptr;
+	}
+
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+	UInventoryItemData* NewItem = NewObject<UInventoryItemData>(GameInstance);
+
+	if (NewItem)
+	{
+		NewItem -> InitializeFromDefinition(Definition, StackSize);
+	}
+	return NewItem;
+}
+
 UInventoryItemData* UInventoryBlueprintLibrary::CreateInventoryItem(
 	UObject* WorldContextObject,
 	FText ItemName,
@@ -22,6 +110,13 @@ UInventoryItemData* UInventoryBlueprintLibrary::CreateInventoryItem(
 		return nullptr;
 	}
 		
+	// Share one definition per item type when the inventory manager is available
+	if (UInventoryItemDefinition* Definition = GetOrCreateItemDefinition(
+		WorldContextObject, ItemName, ItemDescription, Category, Rarity, bStackable, MaxStackSize))
+	{
+		return CreateItemFromDefinition(WorldContextObject, Definition, InitialStackSize);
+	}
+
 	// Create the item as an outer of the GameInstance so it persists
 	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
 	UInventoryItemData* NewItem = NewObject<UInventoryItemData>(GameInstance);
@@ -71,7 +166,7 @@ UInventoryItemData* UInventoryBlueprintLibrary::CreateWeaponItem(
 	UInventoryItemData* Weapon = CreateInventoryItem(
 		WorldContextObject,
 		ItemName,
-		FText::FromString(FString::Printf(TEXT("Damage: %.0f-%.0f"), MinDamage, MaxDamage)),
+		FText::FromString(FString::Printf(TEXT("Weapon: %s"), *ItemName.ToString())),
 		EItemCategory::Weapon,
 		Rarity,
 		false,  // Weapons don't stack
@@ -84,6 +179,9 @@ UInventoryItemData* UInventoryBlueprintLibrary::CreateWeaponItem(
 		Weapon->MinDamage = MinDamage;
 		Weapon->MaxDamage = MaxDamage;
 		Weapon->AttackSpeed = AttackSpeed;
+
+		// Rolled stats are per-instance, so the damage line overrides the shared description
+		Weapon->ItemDescription = FText::FromString(FString::Printf(TEXT("Damage: %.0f-%.0f"), MinDamage, MaxDamage));
 	}
 	return Weapon;
 }
@@ -132,7 +230,7 @@ void UInventoryBlueprintLibrary::DebugPrintInventory(UObject* WorldContextObject
 		return;
 	}
 
-	TArray<UInventoryItemData*> AllItems = InventoryManager->GetAllItems();
+	TConstArrayView<UInventoryItemData*> AllItems = InventoryManager->GetItems();
 	
 	UE_LOG(LogTemp, Log, TEXT("========== INVENTORY DEBUG =========="));
 	UE_LOG(LogTemp, Log, TEXT("Total Slots Used: %d / %d"), 
@@ -172,6 +270,9 @@ void UInventoryBlueprintLibrary::AddTestItemsToInventory(
 		return;
 	}
 
+	// One consolidated inventory update for the whole test drop
+	InventoryManager->BeginBatch();
+
 	// Material names for testing
 	TArray<FString> MaterialNames = {
 		TEXT("Iron Ore"),
@@ -274,6 +375,8 @@ void UInventoryBlueprintLibrary::AddTestItemsToInventory(
 		}
 	}
 
+	InventoryManager->EndBatch();
+
 	UE_LOG(LogTemp, Log, TEXT("Added %d materials, %d weapons, %d consumables to inventory"),
 		NumMaterials, NumWeapons, NumConsumables);
 	
@@ -0,0 +1,95 @@
+// InventoryCommand.cpp
+
+#include "Core/InventoryCommand.h"
+#include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
+#include "Core/InventoryManagerSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "UObject/CoreNet.h"
+
+FInventoryCommand FInventoryCommand::MakeAdd(UInventoryItemDefinition* InDefinition, int32 InQuantity)
+{
+	FInventoryCommand Command;
+	Command.Op = EInventoryCommandOp::Add;
+	Command.ItemGUID = FGuid::NewGuid();
+	Command.Definition = InDefinition;
+	Command.Quantity = InQuantity;
+	return Command;
+}
+
+FInventoryCommand FInventoryCommand::MakeRemove(const FGuid& InItemGUID)
+{
+	FInventoryCommand Command;
+	Command.Op = EInventoryCommandOp::Remove;
+	Command.ItemGUID = InItemGUID;
+	return Command;
+}
+
+FInventoryCommand FInventoryCommand::MakeRemoveQuantity(const FGuid& InItemGUID, int32 InQuantity)
+{
+	FInventoryCommand Command;
+	Command.Op = EInventoryCommandOp::RemoveQuantity;
+	Command.ItemGUID = InItemGUID;
+	Command.Quantity = InQuantity;
+	return Command;
+}
+
+bool FInventoryCommand::Apply(UInventoryManagerSubsystem& InventoryManager) const
+{
+	switch (Op)
+	{
+		case EInventoryCommandOp::Add:
+		{
+			if (!Definition || Quantity < 1 || !ItemGUID.IsValid() || InventoryManager.FindItemByGUID(ItemGUID))
+			{
+				return false;
+			}
+
+			UInventoryItemData* NewItem = NewObject<UInventoryItemData>(InventoryManager.GetGameInstance());
+			NewItem->InitializeFromDefinition(Definition, Quantity);
+
+			FInventoryItemInstance Instance = NewItem->ToInstance();
+			Instance.ItemGUID = ItemGUID;
+			NewItem->ApplyInstance(Instance);
+
+			return InventoryManager.AddItem(NewItem);
+		}
+
+		case EInventoryCommandOp::Remove:
+			return InventoryManager.RemoveItem(ItemGUID);
+
+		case EInventoryCommandOp::RemoveQuantity:
+			return InventoryManager.RemoveItemQuantity(ItemGUID, Quantity);
+
+		default:
+			return false;
+	}
+}
+
+bool FInventoryCommand::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint8 OpBits = static_cast<uint8>(Op);
+	Ar.SerializeBits(&OpBits, 2);
+	Op = static_cast<EInventoryCommandOp>(OpBits);
+
+	Ar.SerializeIntPacked(Sequence);
+	Ar << ItemGUID;
+
+	if (Op == EInventoryCommandOp::Add)
+	{
+		UObject* DefinitionObject = Definition;
+		bOutSuccess &= Map && Map->SerializeObject(Ar, UInventoryItemDefinition::StaticClass(), DefinitionObject);
+		Definition = Cast<UInventoryItemDefinition>(DefinitionObject);
+	}
+
+	if (Op != EInventoryCommandOp::Remove)
+	{
+		uint32 PackedQuantity = static_cast<uint32>(FMath::Max(Quantity, 0));
+		Ar.SerializeIntPacked(PackedQuantity);
+		Quantity = static_cast<int32>(PackedQuantity);
+	}
+
+	return true;
+}
@@ -0,0 +1,707 @@
+// InventoryFilterExpression.cpp
+
+#include "Core/InventoryFilterExpression.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+static_assert(static_cast<int32>(EInventoryItemStat::Weight) + 1 == FInventoryColumnarView::NumStats,
+	"FInventoryColumnarView needs a column per EInventoryItemStat");
+
+// ----------------------------------------
+// Columnar view
+// ----------------------------------------
+
+void FInventoryColumnarView::Build(TConstArrayView<UInventoryItemData*> InItems)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryColumnarView::Build);
+
+	Reset();
+
+	Items.Reserve(InItems.Num());
+	Categories.Reserve(InItems.Num());
+	Rarities.Reserve(InItems.Num());
+	NameIds.Reserve(InItems.Num());
+	for (TArray<float>& Column : Stats)
+	{
+		Column.Reserve(InItems.Num());
+	}
+
+	TMap<FString, int32> NameIdsByName;
+	for (UInventoryItemData* Item : InItems)
+	{
+		if (!Item)
+		{
+			continue;
+		}
+
+		Items.Add(Item);
+		Categories.Add(static_cast<uint8>(Item->GetItemCategory()));
+		Rarities.Add(static_cast<uint8>(Item->GetItemRarity()));
+
+		for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+		{
+			Stats[StatIndex].Add(FInventoryItemPredicate::GetStat(*Item, static_cast<EInventoryItemStat>(StatIndex)));
+		}
+
+		const FString& Name = Item->GetNormalizedName();
+		int32 NameId = INDEX_NONE;
+		if (const int32* ExistingId = NameIdsByName.Find(Name))
+		{
+			NameId = *ExistingId;
+		}
+		else
+		{
+			NameId = Names.Add(Name);
+			NameIdsByName.Add(Name, NameId);
+		}
+		NameIds.Add(NameId);
+	}
+}
+
+void FInventoryColumnarView::Reset()
+{
+	Items.Reset();
+	Categories.Reset();
+	Rarities.Reset();
+	NameIds.Reset();
+	Names.Reset();
+	for (TArray<float>& Column : Stats)
+	{
+		Column.Reset();
+	}
+}
+
+// ----------------------------------------
+// Parser
+// ----------------------------------------
+
+/** Recursive-descent parser that emits the postfix program as it goes */
+class FInventoryFilterParser
+{
+public:
+	using EOpCode = FInventoryFilterProgram::EOpCode;
+	using ECompare = FInventoryFilterProgram::ECompare;
+	using FInstruction = FInventoryFilterProgram::FInstruction;
+
+	FInventoryFilterParser(const FString& InText, FInventoryFilterProgram& InProgram)
+		: Text(InText)
+		, Program(InProgram)
+	{
+	}
+
+	bool Parse(FString& OutError)
+	{
+		Advance();
+
+		if (Token.Type == ETokenType::End)
+		{
+			FInstruction Instruction;
+			Instruction.Op = EOpCode::MatchAll;
+			Emit(MoveTemp(Instruction));
+		}
+		else if (ParseOr() && Token.Type != ETokenType::End)
+		{
+			Fail(FString::Printf(TEXT("Unexpected '%s'"), *Token.Text));
+		}
+
+		OutError = Error;
+		return Error.IsEmpty();
+	}
+
+private:
+	enum class ETokenType : uint8
+	{
+		End,
+		Identifier,
+		Number,
+		String,
+		Compare,
+		LeftParen,
+		RightParen
+	};
+
+	struct FToken
+	{
+		ETokenType Type = ETokenType::End;
+		FString Text;
+		double Number = 0.0;
+		ECompare Compare = ECompare::Equal;
+		int32 Start = 0;
+	};
+
+	const FString& Text;
+	FInventoryFilterProgram& Program;
+
+	int32 Position = 0;
+	FToken Token;
+	FString Error;
+
+	/** Bit sets on the evaluation stack after the instructions emitted so far */
+	int32 StackDepth = 0;
+
+	// Tokens
+
+	void Advance()
+	{
+		while (Position < Text.Len() && FChar::IsWhitespace(Text[Position]))
+		{
+			++Position;
+		}
+
+		Token = FToken();
+		Token.Start = Position;
+
+		if (Position >= Text.Len())
+		{
+			return;
+		}
+
+		const TCHAR Char = Text[Position];
+		const TCHAR Next = Position + 1 < Text.Len() ? Text[Position + 1] : TEXT('\0');
+
+		if (FChar::IsAlpha(Char) || Char == TEXT('_'))
+		{
+			while (Position < Text.Len() && (FChar::IsAlnum(Text[Position]) || Text[Position] == TEXT('_')))
+			{
+				++Position;
+			}
+			Token.Type = ETokenType::Identifier;
+			Token.Text = Text.Mid(Token.Start, Position - Token.Start);
+		}
+		else if (FChar::IsDigit(Char) || ((Char == TEXT('-') || Char == TEXT('.')) && FChar::IsDigit(Next)))
+		{
+			++Position;
+			while (Position < Text.Len() && (FChar::IsDigit(Text[Position]) || Text[Position] == TEXT('.')))
+			{
+				++Position;
+			}
+			Token.Type = ETokenType::Number;
+			Token.Text = Text.Mid(Token.Start, Position - Token.Start);
+			Token.Number = FCString::Atod(*Token.Text);
+		}
+		else if (Char == TEXT('\'') || Char == TEXT('"'))
+		{
+			const int32 End = Text.Find(FString::Chr(Char), ESearchCase::CaseSensitive, ESearchDir::FromStart, Position + 1);
+			if (End == INDEX_NONE)
+			{
+				Position = Text.Len();
+				Fail(TEXT("Unterminated string"));
+				return;
+			}
+			Token.Type = ETokenType::String;
+			Token.Text = Text.Mid(Position + 1, End - Position - 1);
+			Position = End + 1;
+		}
+		else if (Char == TEXT('('))
+		{
+			++Position;
+			Token.Type = ETokenType::LeftParen;
+			Token.Text = TEXT("(");
+		}
+		else if (Char == TEXT(')'))
+		{
+			++Position;
+			Token.Type = ETokenType::RightParen;
+			Token.Text = TEXT(")");
+		}
+		else if (Char == TEXT('=') || Char == TEXT('!') || Char == TEXT('<') || Char == TEXT('>'))
+		{
+			Token.Type = ETokenType::Compare;
+			const bool bTwoChars = Next == TEXT('=') || (Char == TEXT('<') && Next == TEXT('>'));
+			Position += bTwoChars ? 2 : 1;
+			Token.Text = Text.Mid(Token.Start, Position - Token.Start);
+
+			if (Token.Text == TEXT("=") || Token.Text == TEXT("=="))
+			{
+				Token.Compare = ECompare::Equal;
+			}
+			else if (Token.Text == TEXT("!=") || Token.Text == TEXT("<>"))
+			{
+				Token.Compare = ECompare::NotEqual;
+			}
+			else if (Token.Text == TEXT("<"))
+			{
+				Token.Compare = ECompare::Less;
+			}
+			else if (Token.Text == TEXT("<="))
+			{
+				Token.Compare = ECompare::LessEqual;
+			}
+			else if (Token.Text == TEXT(">"))
+			{
+				Token.Compare = ECompare::Greater;
+			}
+			else if (Token.Text == TEXT(">="))
+			{
+				Token.Compare = ECompare::GreaterEqual;
+			}
+			else
+			{
+				Fail(FString::Printf(TEXT("Unknown operator '%s'"), *Token.Text));
+			}
+		}
+		else
+		{
+			++Position;
+			Token.Text = FString::Chr(Char);
+			Fail(FString::Printf(TEXT("Unexpected '%s'"), *Token.Text));
+		}
+	}
+
+	bool IsKeyword(const TCHAR* Keyword) const
+	{
+		return Token.Type == ETokenType::Identifier && Token.Text.Equals(Keyword, ESearchCase::IgnoreCase);
+	}
+
+	bool Fail(const FString& Message)
+	{
+		// Keep the first error - later ones are usually fallout from it
+		if (Error.IsEmpty())
+		{
+			Error = FString::Printf(TEXT("%s (column %d)"), *Message, Token.Start + 1);
+		}
+		return false;
+	}
+
+	void Emit(FInstruction&& Instruction)
+	{
+		switch (Instruction.Op)
+		{
+			case EOpCode::And:
+			case EOpCode::Or:
+				--StackDepth;
+				break;
+			case EOpCode::Not:
+				break;
+			default:
+				++StackDepth;
+				break;
+		}
+		Program.MaxStackDepth = FMath::Max(Program.MaxStackDepth, StackDepth);
+		Program.Instructions.Add(MoveTemp(Instruction));
+	}
+
+	void EmitOp(EOpCode Op)
+	{
+		FInstruction Instruction;
+		Instruction.Op = Op;
+		Emit(MoveTemp(Instruction));
+	}
+
+	// Grammar
+
+	bool ParseOr()
+	{
+		if (!ParseAnd())
+		{
+			return false;
+		}
+		while (IsKeyword(TEXT("OR")))
+		{
+			Advance();
+			if (!ParseAnd())
+			{
+				return false;
+			}
+			EmitOp(EOpCode::Or);
+		}
+		return true;
+	}
+
+	bool ParseAnd()
+	{
+		if (!ParseNot())
+		{
+			return false;
+		}
+		while (IsKeyword(TEXT("AND")))
+		{
+			Advance();
+			if (!ParseNot())
+			{
+				return false;
+			}
+			EmitOp(EOpCode::And);
+		}
+		return true;
+	}
+
+	bool ParseNot()
+	{
+		if (IsKeyword(TEXT("NOT")))
+		{
+			Advance();
+			if (!ParseNot())
+			{
+				return false;
+			}
+			EmitOp(EOpCode::Not);
+			return true;
+		}
+		return ParsePrimary();
+	}
+
+	bool ParsePrimary()
+	{
+		if (!Error.IsEmpty())
+		{
+			return false;
+		}
+
+		if (Token.Type == ETokenType::LeftParen)
+		{
+			Advance();
+			if (!ParseOr())
+			{
+				return false;
+			}
+			if (Token.Type != ETokenType::RightParen)
+			{
+				return Fail(TEXT("Expected ')'"));
+			}
+			Advance();
+			return true;
+		}
+
+		if (Token.Type != ETokenType::Identifier)
+		{
+			return Fail(Token.Type == ETokenType::End ? FString(TEXT("Unexpected end of expression")) :
+				FString::Printf(TEXT("Expected a condition, found '%s'"), *Token.Text));
+		}
+
+		const FToken Field = Token;
+		Advance();
+
+		if (Token.Type == ETokenType::Compare || IsKeyword(TEXT("CONTAINS")))
+		{
+			return ParseComparison(Field);
+		}
+
+		// A bare category or rarity name
+		int64 Value = 0;
+		FInstruction Instruction;
+		if (FindEnumValue(StaticEnum<EItemCategory>(), Field.Text, Value))
+		{
+			Instruction.Op = EOpCode::CategoryMask;
+			Instruction.Mask = 1u << Value;
+		}
+		else if (FindEnumValue(StaticEnum<EItemRarity>(), Field.Text, Value))
+		{
+			Instruction.Op = EOpCode::RarityMask;
+			Instruction.Mask = 1u << Value;
+		}
+		else
+		{
+			Token.Start = Field.Start;
+			return Fail(FString::Printf(TEXT("'%s' is not a category, rarity or comparison"), *Field.Text));
+		}
+		Emit(MoveTemp(Instruction));
+		return true;
+	}
+
+	bool ParseComparison(const FToken& Field)
+	{
+		const bool bContains = IsKeyword(TEXT("CONTAINS"));
+		const ECompare Compare = Token.Compare;
+		Advance();
+
+		FInstruction Instruction;
+		int64 StatValue = 0;
+
+		if (Field.Text.Equals(TEXT("Name"), ESearchCase::IgnoreCase))
+		{
+			if (!bContains && Compare != ECompare::Equal && Compare != ECompare::NotEqual)
+			{
+				return Fail(TEXT("Name supports CONTAINS, = and !="));
+			}
+			if (Token.Type != ETokenType::String)
+			{
+				return Fail(TEXT("Expected a quoted name"));
+			}
+			Instruction.Op = bContains ? EOpCode::NameContains : EOpCode::NameEquals;
+			Instruction.Text = Token.Text.ToLower();
+			Advance();
+			Emit(MoveTemp(Instruction));
+			if (!bContains && Compare == ECompare::NotEqual)
+			{
+				EmitOp(EOpCode::Not);
+			}
+			return true;
+		}
+
+		if (bContains)
+		{
+			return Fail(FString::Printf(TEXT("CONTAINS only applies to Name, not '%s'"), *Field.Text));
+		}
+
+		if (Field.Text.Equals(TEXT("Category"), ESearchCase::IgnoreCase) || Field.Text.Equals(TEXT("Rarity"), ESearchCase::IgnoreCase))
+		{
+			const bool bCategory = Field.Text.Equals(TEXT("Category"), ESearchCase::IgnoreCase);
+			const UEnum* Enum = bCategory ? StaticEnum<EItemCategory>() : StaticEnum<EItemRarity>();
+			if (bCategory && Compare != ECompare::Equal && Compare != ECompare::NotEqual)
+			{
+				return Fail(TEXT("Category supports = and !="));
+			}
+
+			int64 Target = 0;
+			if ((Token.Type != ETokenType::Identifier && Token.Type != ETokenType::String) || !FindEnumValue(Enum, Token.Text, Target))
+			{
+				return Fail(FString::Printf(TEXT("'%s' is not a %s"), *Token.Text, bCategory ? TEXT("category") : TEXT("rarity")));
+			}
+			Advance();
+
+			// Fold the comparison into the set of values it accepts
+			Instruction.Op = bCategory ? EOpCode::CategoryMask : EOpCode::RarityMask;
+			for (int32 Index = 0; Index < Enum->NumEnums() - 1; ++Index)
+			{
+				const int64 Candidate = Enum->GetValueByIndex(Index);
+				if (CompareValues(static_cast<double>(Candidate), Compare, static_cast<double>(Target)))
+				{
+					Instruction.Mask |= 1u << Candidate;
+				}
+			}
+			Emit(MoveTemp(Instruction));
+			return true;
+		}
+
+		if (FindEnumValue(StaticEnum<EInventoryItemStat>(), Field.Text, StatValue))
+		{
+			if (Token.Type != ETokenType::Number)
+			{
+				return Fail(FString::Printf(TEXT("Expected a number to compare %s with"), *Field.Text));
+			}
+			Instruction.Op = EOpCode::CompareStat;
+			Instruction.Stat = static_cast<EInventoryItemStat>(StatValue);
+			Instruction.Compare = Compare;
+			Instruction.Value = static_cast<float>(Token.Number);
+			Advance();
+			Emit(MoveTemp(Instruction));
+			return true;
+		}
+
+		Token.Start = Field.Start;
+		return Fail(FString::Printf(TEXT("Unknown field '%s'"), *Field.Text));
+	}
+
+	/** Look up an enum entry by name, ignoring case (the generated _MAX entry is skipped) */
+	static bool FindEnumValue(const UEnum* Enum, const FString& Name, int64& OutValue)
+	{
+		for (int32 Index = 0; Index < Enum->NumEnums() - 1; ++Index)
+		{
+			if (Enum->GetNameStringByIndex(Index).Equals(Name, ESearchCase::IgnoreCase))
+			{
+				OutValue = Enum->GetValueByIndex(Index);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool CompareValues(double A, ECompare Compare, double B)
+	{
+		switch (Compare)
+		{
+			case ECompare::Equal:
+				return A == B;
+			case ECompare::NotEqual:
+				return A != B;
+			case ECompare::Less:
+				return A < B;
+			case ECompare::LessEqual:
+				return A <= B;
+			case ECompare::Greater:
+				return A > B;
+			case ECompare::GreaterEqual:
+				return A >= B;
+			default:
+				return false;
+		}
+	}
+};
+
+// ----------------------------------------
+// Program
+// ----------------------------------------
+
+TSharedPtr<const FInventoryFilterProgram> FInventoryFilterProgram::Compile(const FString& Expression, FString& OutError)
+{
+	TSharedRef<FInventoryFilterProgram> Program = MakeShared<FInventoryFilterProgram>();
+
+	FInventoryFilterParser Parser(Expression, *Program);
+	if (!Parser.Parse(OutError))
+	{
+		return nullptr;
+	}
+	return Program;
+}
+
+namespace
+{
+	/** Set bit Row of Words for every row passing Test, 64 rows per word */
+	template<typename TestType>
+	void FillBits(int32 NumRows, TArray<uint64>& Words, TestType&& Test)
+	{
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			const int32 FirstRow = WordIndex * 64;
+			const int32 NumWordRows = FMath::Min(64, NumRows - FirstRow);
+
+			uint64 Word = 0;
+			for (int32 Bit = 0; Bit < NumWordRows; ++Bit)
+			{
+				Word |= static_cast<uint64>(Test(FirstRow + Bit)) << Bit;
+			}
+			Words[WordIndex] = Word;
+		}
+	}
+
+	template<typename CompareType>
+	void FillStatBits(int32 NumRows, TArray<uint64>& Words, TConstArrayView<float> Column, float Value, CompareType Compare)
+	{
+		FillBits(NumRows, Words, [Column, Value, Compare](int32 Row) { return Compare(Column[Row], Value); });
+	}
+}
+
+void FInventoryFilterProgram::Evaluate(const FInventoryColumnarView& View, TArray<UInventoryItemData*>& OutItems) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryFilterProgram::Evaluate);
+
+	OutItems.Reset();
+
+	const int32 NumRows = View.Num();
+	if (NumRows == 0 || Instructions.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 NumWords = FMath::DivideAndRoundUp(NumRows, 64);
+	const uint64 LastWordMask = (NumRows % 64) == 0 ? ~0ull : ((1ull << (NumRows % 64)) - 1);
+
+	TArray<TArray<uint64>> Stack;
+	Stack.SetNum(MaxStackDepth);
+	for (TArray<uint64>& Words : Stack)
+	{
+		Words.SetNumUninitialized(NumWords);
+	}
+
+	// Per distinct name, reused by every name instruction
+	TArray<bool> NameMatches;
+
+	int32 Depth = 0;
+	for (const FInstruction& Instruction : Instructions)
+	{
+		switch (Instruction.Op)
+		{
+			case EOpCode::MatchAll:
+			{
+				TArray<uint64>& Words = Stack[Depth++];
+				FMemory::Memset(Words.GetData(), 0xFF, NumWords * sizeof(uint64));
+				Words.Last() &= LastWordMask;
+				break;
+			}
+
+			case EOpCode::CategoryMask:
+			case EOpCode::RarityMask:
+			{
+				const TConstArrayView<uint8> Column = Instruction.Op == EOpCode::CategoryMask ? View.GetCategories() : View.GetRarities();
+				const uint32 Mask = Instruction.Mask;
+				FillBits(NumRows, Stack[Depth++], [Column, Mask](int32 Row) { return (Mask >> Column[Row]) & 1u; });
+				break;
+			}
+
+			case EOpCode::CompareStat:
+			{
+				TArray<uint64>& Words = Stack[Depth++];
+				const TConstArrayView<float> Column = View.GetStats(Instruction.Stat);
+				switch (Instruction.Compare)
+				{
+					case ECompare::Equal:
+						FillStatBits(NumRows, Words, Column, Instruction.Value, [](float A, float B) { return A == B; });
+						break;
+					case ECompare::NotEqual:
+						FillStatBits(NumRows, Words, Column, Instruction.Value, [](float A, float B) { return A != B; });
+						break;
+					case ECompare::Less:
+						FillStatBits(NumRows, Words, Column, Instruction.Value, [](float A, float B) { return A < B; });
+						break;
+					case ECompare::LessEqual:
+						FillStatBits(NumRows, Words, Column, Instruction.Value, [](float A, float B) { return A <= B; });
+						break;
+					case ECompare::Greater:
+						FillStatBits(NumRows, Words, Column, Instruction.Value, [](float A, float B) { return A > B; });
+						break;
+					case ECompare::GreaterEqual:
+						FillStatBits(NumRows, Words, Column, Instruction.Value, [](float A, float B) { return A >= B; });
+						break;
+				}
+				break;
+			}
+
+			case EOpCode::NameContains:
+			case EOpCode::NameEquals:
+			{
+				// Test each distinct name once, then look the rows up
+				const TConstArrayView<FString> Names = View.GetNames();
+				NameMatches.SetNumUninitialized(Names.Num());
+				for (int32 NameIndex = 0; NameIndex < Names.Num(); ++NameIndex)
+				{
+					NameMatches[NameIndex] = Instruction.Op == EOpCode::NameContains ?
+						Names[NameIndex].Contains(Instruction.Text, ESearchCase::CaseSensitive) :
+						Names[NameIndex].Equals(Instruction.Text, ESearchCase::CaseSensitive);
+				}
+
+				const TConstArrayView<int32> NameIds = View.GetNameIds();
+				FillBits(NumRows, Stack[Depth++], [&NameMatches, NameIds](int32 Row) { return NameMatches[NameIds[Row]]; });
+				break;
+			}
+
+			case EOpCode::And:
+			case EOpCode::Or:
+			{
+				--Depth;
+				uint64* Target = Stack[Depth - 1].GetData();
+				const uint64* Source = Stack[Depth].GetData();
+				if (Instruction.Op == EOpCode::And)
+				{
+					for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+					{
+						Target[WordIndex] &= Source[WordIndex];
+					}
+				}
+				else
+				{
+					for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+					{
+						Target[WordIndex] |= Source[WordIndex];
+					}
+				}
+				break;
+			}
+
+			case EOpCode::Not:
+			{
+				TArray<uint64>& Words = Stack[Depth - 1];
+				for (uint64& Word : Words)
+				{
+					Word = ~Word;
+				}
+				// Rows past the end must stay clear
+				Words.Last() &= LastWordMask;
+				break;
+			}
+		}
+	}
+
+	check(Depth == 1);
+
+	const TArray<uint64>& Result = Stack[0];
+	for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+	{
+		uint64 Word = Result[WordIndex];
+		while (Word)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+			OutItems.Add(View.GetItem(WordIndex * 64 + Bit));
+			Word &= Word - 1;
+		}
+	}
+}
@@ -0,0 +1,115 @@
+// InventoryIconCache.cpp
+
+#include "Core/InventoryIconCache.h"
+#include "Engine/Texture2D.h"
+
+FInventoryIconCache::FInventoryIconCache(int32 InMaxResidentIcons)
+	: MaxResidentIcons(FMath::Max(0, InMaxResidentIcons))
+{
+}
+
+FInventoryIconCache::~FInventoryIconCache()
+{
+	Reset();
+}
+
+UTexture2D* FInventoryIconCache::Acquire(const TSoftObjectPtr<UTexture2D>& Icon)
+{
+	const FSoftObjectPath& IconPath = Icon.ToSoftObjectPath();
+	if (IconPath.IsNull())
+	{
+		return nullptr;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(IconPath);
+	if (Entry.LRUNode)
+	{
+		UnpinnedIcons.RemoveNode(Entry.LRUNode);
+		Entry.LRUNode = nullptr;
+	}
+	Entry.PinCount++;
+
+	if (!Entry.Handle)
+	{
+		// Also taken for icons something else already loaded, so eviction is what lets them go
+		Entry.Handle = Streamable.RequestAsyncLoad(IconPath,
+			FStreamableDelegate::CreateRaw(this, &FInventoryIconCache::HandleIconLoaded, IconPath),
+			FStreamableManager::AsyncLoadHighPriority);
+
+		// A new entry can push the unpinned icons over budget
+		TrimToBudget();
+	}
+
+	return Icon.Get();
+}
+
+void FInventoryIconCache::Release(const TSoftObjectPtr<UTexture2D>& Icon)
+{
+	const FSoftObjectPath& IconPath = Icon.ToSoftObjectPath();
+	FEntry* Entry = Entries.Find(IconPath);
+	if (!Entry || Entry->PinCount == 0)
+	{
+		return;
+	}
+
+	if (--Entry->PinCount == 0)
+	{
+		UnpinnedIcons.AddTail(IconPath);
+		Entry->LRUNode = UnpinnedIcons.GetTail();
+		TrimToBudget();
+	}
+}
+
+void FInventoryIconCache::SetMaxResidentIcons(int32 NewMax)
+{
+	MaxResidentIcons = FMath::Max(0, NewMax);
+	TrimToBudget();
+}
+
+void FInventoryIconCache::Reset()
+{
+	for (TPair<FSoftObjectPath, FEntry>& Pair : Entries)
+	{
+		ReleaseHandle(Pair.Value.Handle);
+	}
+	Entries.Empty();
+	UnpinnedIcons.Empty();
+}
+
+void FInventoryIconCache::HandleIconLoaded(FSoftObjectPath IconPath)
+{
+	OnIconLoaded.Broadcast(IconPath);
+}
+
+void FInventoryIconCache::TrimToBudget()
+{
+	while (Entries.Num() > MaxResidentIcons && UnpinnedIcons.GetHead())
+	{
+		const FSoftObjectPath IconPath = UnpinnedIcons.GetHead()->GetValue();
+		UnpinnedIcons.RemoveNode(UnpinnedIcons.GetHead());
+
+		FEntry Entry;
+		if (Entries.RemoveAndCopyValue(IconPath, Entry))
+		{
+			ReleaseHandle(Entry.Handle);
+		}
+	}
+}
+
+void FInventoryIconCache::ReleaseHandle(const TSharedPtr<FStreamableHandle>& Handle)
+{
+	if (!Handle)
+	{
+		return;
+	}
+
+	// An icon still streaming in isn't wanted any more - don't finish the load
+	if (Handle->IsLoadingInProgress())
+	{
+		Handle->CancelHandle();
+	}
+	else
+	{
+		Handle->ReleaseHandle();
+	}
+}
@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
+#include "Engine/Texture2D.h"
 
 UInventoryItemData::UInventoryItemData()
 {
@@ -34,6 +36,102 @@ void UInventoryItemData::PostInitProperties()
     }
 }
 
+FText UInventoryItemData::GetItemName() const
+{
+    return Definition ? Definition->DisplayName : ItemName;
+}
+
+FText UInventoryItemData::GetItemDescription() const
+{
+    // Instances may override the shared description (e.g. rolled weapon stats)
+    if (Definition && ItemDescription.IsEmpty())
+    {
+        return Definition->Description;
+    }
+    return ItemDescription;
+}
+
+UTexture2D* UInventoryItemData::GetItemIcon() const
+{
+    return GetItemIconAsset().Get();
+}
+
+TSoftObjectPtr<UTexture2D> UInventoryItemData::GetItemIconAsset() const
+{
+    return Definition ? Definition->Icon : ItemIcon;
+}
+
+FIntPoint UInventoryItemData::GetGridSize() const
+{
+    if (Definition)
+    {
+        return FIntPoint(FMath::Max(1, Definition->GridWidth), FMath::Max(1, Definition->GridHeight));
+    }
+    return FIntPoint(1, 1);
+}
+
+const FString& UInventoryItemData::GetNormalizedName() const
+{
+    if (Definition)
+    {
+        return Definition->GetNormalizedName();
+    }
+
+    if (NormalizedNameCache.IsEmpty())
+    {
+        NormalizedNameCache = ItemName.ToString().ToLower();
+    }
+    return NormalizedNameCache;
+}
+
+void UInventoryItemData::InitializeFromDefinition(UInventoryItemDefinition* InDefinition, int32 StackSize)
+{
+    if (!InDefinition)
+    {
+        return;
+    }
+
+    Definition = InDefinition;
+
+    // Shared text lives on the definition - don't keep per-instance copies
+    ItemName = FText::GetEmpty();
+    ItemDescription = FText::GetEmpty();
+    ItemIcon = nullptr;
+
+    ItemRarity = InDefinition->Rarity;
+    ItemCategory = InDefinition->Category;
+    bIsStackable = InDefinition->bIsStackable;
+    MaxStackSize = InDefinition->bIsStackable ? FMath::Max(1, InDefinition->MaxStackSize) : 1;
+    CurrentStackSize = FMath::Clamp(StackSize, 1, MaxStackSize);
+
+    MinDamage = InDefinition->MinDamage;
+    MaxDamage = InDefinition->MaxDamage;
+    AttackSpeed = InDefinition->AttackSpeed;
+    MaxDurability = InDefinition->MaxDurability;
+    CurrentDurability = InDefinition->MaxDurability;
+    Weight = InDefinition->Weight;
+}
+
+FInventoryItemInstance UInventoryItemData::ToInstance() const
+{
+    FInventoryItemInstance Instance;
+    Instance.Definition = Definition;
+    Instance.ItemGUID = ItemGUID;
+    Instance.StackCount = CurrentStackSize;
+    Instance.Durability = CurrentDurability;
+    return Instance;
+}
+
+void UInventoryItemData::ApplyInstance(const FInventoryItemInstance& Instance)
+{
+    if (Instance.ItemGUID.IsValid())
+    {
+        ItemGUID = Instance.ItemGUID;
+    }
+    SetStackSize(Instance.StackCount);
+    CurrentDurability = FMath::Clamp(Instance.Durability, 0.0f, MaxDurability);
+}
+
 bool UInventoryItemData::AddToStack(int32 Amount)
 {
     if (!bIsStackable || Amount <= 0)
@@ -41,14 +139,20 @@ bool UInventoryItemData::AddToStack(int32 Amount)
         return false;
     }
 
+    const int32 OldStackSize = CurrentStackSize;
     int32 NewStackSize = CurrentStackSize + Amount;
     if (NewStackSize > MaxStackSize)
     {
         CurrentStackSize = MaxStackSize;
+        if (CurrentStackSize != OldStackSize)
+        {
+            OnStackSizeChanged.Broadcast(this, OldStackSize, CurrentStackSize);
+        }
         return false; // Stack is full, only added partial amount
     }
 
     CurrentStackSize = NewStackSize;
+    OnStackSizeChanged.Broadcast(this, OldStackSize, CurrentStackSize);
     return true;
 }
 
@@ -59,7 +163,9 @@ bool UInventoryItemData::RemoveFromStack(int32 Amount)
         return false; // Invalid amount or not enough in stack
     }
 
+    const int32 OldStackSize = CurrentStackSize;
     CurrentStackSize -= Amount;
+    OnStackSizeChanged.Broadcast(this, OldStackSize, CurrentStackSize);
     return true;
 }
 
@@ -71,5 +177,10 @@ bool UInventoryItemData::IsStackFull() const
 void UInventoryItemData::SetStackSize(int32 NewSize)
 {
     // Clamp to valid range: at least 1, at most MaxStackSize
+    const int32 OldStackSize = CurrentStackSize;
     CurrentStackSize = FMath::Clamp(NewSize, 1, MaxStackSize);
+    if (CurrentStackSize != OldStackSize)
+    {
+        OnStackSizeChanged.Broadcast(this, OldStackSize, CurrentStackSize);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+// InventoryItemDefinition.cpp
+
+#include "Core/InventoryItemDefinition.h"
+
+const FPrimaryAssetType UInventoryItemDefinition::PrimaryAssetType = TEXT("InventoryItem");
+
+FPrimaryAssetId UInventoryItemDefinition::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetDefinitionId());
+}
+
+const FString& UInventoryItemDefinition::GetNormalizedName() const
+{
+	if (NormalizedNameCache.IsEmpty())
+	{
+		NormalizedNameCache = DisplayName.ToString().ToLower();
+	}
+	return NormalizedNameCache;
+}
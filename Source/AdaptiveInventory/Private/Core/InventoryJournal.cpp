@@ -0,0 +1,352 @@
+// InventoryJournal.cpp
+
+#include "Core/InventoryJournal.h"
+#include "Core/InventoryItemDefinition.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace InventoryJournal
+{
+	/** 'AINJ' */
+	static constexpr uint32 Magic = 0x4A4E4941;
+	static constexpr uint16 Version = 1;
+
+	struct FFileHeader
+	{
+		uint32 Magic = 0;
+		uint16 Version = 0;
+		uint16 HeaderSize = 0;
+		uint32 SnapshotCrc = 0;
+		uint32 Reserved = 0;
+	};
+	static_assert(sizeof(FFileHeader) == 16, "Journal header layout is part of the file format");
+
+	/** Precedes every record's payload */
+	struct FRecordHeader
+	{
+		/** CRC32 of the op byte and payload */
+		uint32 Crc = 0;
+		uint16 PayloadSize = 0;
+		uint8 Op = 0;
+		uint8 Reserved = 0;
+	};
+	static_assert(sizeof(FRecordHeader) == 8, "Journal record layout is part of the file format");
+
+	static uint32 RecordCrc(uint8 Op, const uint8* Payload, int32 PayloadSize)
+	{
+		return FCrc::MemCrc32(Payload, PayloadSize, FCrc::MemCrc32(&Op, sizeof(Op)));
+	}
+}
+
+FInventoryJournal::~FInventoryJournal()
+{
+	Close();
+}
+
+bool FInventoryJournal::Open(const FString& FilePath, uint32 SnapshotCrc)
+{
+	Close();
+
+	FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath));
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	InventoryJournal::FFileHeader Header;
+	Header.Magic = InventoryJournal::Magic;
+	Header.Version = InventoryJournal::Version;
+	Header.HeaderSize = sizeof(Header);
+	Header.SnapshotCrc = SnapshotCrc;
+
+	PendingBytes.Reset();
+	PendingBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	NumRecords = 0;
+	DefinedIds.Reset();
+
+	// The header must be durable before any record can rely on it
+	return Flush(true);
+}
+
+void FInventoryJournal::Close()
+{
+	if (FileHandle)
+	{
+		Flush(true);
+		FileHandle.Reset();
+	}
+	PendingBytes.Reset();
+	NumRecords = 0;
+	DefinedIds.Reset();
+}
+
+void FInventoryJournal::AppendAdd(const FGuid& ItemGUID, const UInventoryItemDefinition& Definition, int32 StackCount, float Durability)
+{
+	const FName DefinitionId = Definition.GetDefinitionId();
+	FString DefinitionString = DefinitionId.ToString();
+
+	// Replay may run in a process that never created this definition
+	if (FileHandle && !DefinedIds.Contains(DefinitionId))
+	{
+		DefinedIds.Add(DefinitionId);
+
+		TArray<uint8> DefinePayload;
+		FMemoryWriter DefineWriter(DefinePayload);
+		FInventorySavedDefinition Saved = FInventorySavedDefinition::Capture(Definition);
+		DefineWriter << DefinitionString << Saved;
+		AppendRecord(EOp::Define, DefinePayload);
+	}
+
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid GUID = ItemGUID;
+	Writer << GUID << StackCount << Durability << DefinitionString;
+	AppendRecord(EOp::Add, Payload);
+}
+
+void FInventoryJournal::AppendRemove(const FGuid& ItemGUID)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid GUID = ItemGUID;
+	Writer << GUID;
+	AppendRecord(EOp::Remove, Payload);
+}
+
+void FInventoryJournal::AppendSetStack(const FGuid& ItemGUID, int32 StackCount)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid GUID = ItemGUID;
+	Writer << GUID << StackCount;
+	AppendRecord(EOp::SetStack, Payload);
+}
+
+void FInventoryJournal::AppendSetDurability(const FGuid& ItemGUID, float Durability)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid GUID = ItemGUID;
+	Writer << GUID << Durability;
+	AppendRecord(EOp::SetDurability, Payload);
+}
+
+void FInventoryJournal::AppendMove(const FGuid& ItemGUID, int32 NewIndex)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid GUID = ItemGUID;
+	Writer << GUID << NewIndex;
+	AppendRecord(EOp::Move, Payload);
+}
+
+void FInventoryJournal::AppendSwap(const FGuid& FirstGUID, const FGuid& SecondGUID)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid First = FirstGUID;
+	FGuid Second = SecondGUID;
+	Writer << First << Second;
+	AppendRecord(EOp::Swap, Payload);
+}
+
+void FInventoryJournal::AppendSort(TConstArrayView<FInventorySortCriterion> Criteria)
+{
+	TArray<uint8> Payload;
+	Payload.Reserve(1 + Criteria.Num() * 2);
+	Payload.Add(static_cast<uint8>(Criteria.Num()));
+	for (const FInventorySortCriterion& Criterion : Criteria)
+	{
+		Payload.Add(static_cast<uint8>(Criterion.Key));
+		Payload.Add(Criterion.bDescending ? 1 : 0);
+	}
+	AppendRecord(EOp::Sort, Payload);
+}
+
+void FInventoryJournal::AppendMoveToContainer(const FGuid& ItemGUID, FName ContainerName, int32 SlotIndex, bool bRotated)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FGuid GUID = ItemGUID;
+	FString ContainerString = ContainerName.IsNone() ? FString() : ContainerName.ToString();
+	uint8 bRotatedByte = bRotated ? 1 : 0;
+	Writer << GUID << ContainerString << SlotIndex << bRotatedByte;
+	AppendRecord(EOp::MoveToContainer, Payload);
+}
+
+void FInventoryJournal::AppendCompactContainer(FName ContainerName)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FString ContainerString = ContainerName.ToString();
+	Writer << ContainerString;
+	AppendRecord(EOp::CompactContainer, Payload);
+}
+
+void FInventoryJournal::AppendClear()
+{
+	AppendRecord(EOp::Clear, TArray<uint8>());
+}
+
+void FInventoryJournal::AppendRecord(EOp Op, const TArray<uint8>& Payload)
+{
+	if (!FileHandle)
+	{
+		return;
+	}
+
+	check(Payload.Num() <= MAX_uint16);
+
+	InventoryJournal::FRecordHeader Header;
+	Header.Op = static_cast<uint8>(Op);
+	Header.PayloadSize = static_cast<uint16>(Payload.Num());
+	Header.Crc = InventoryJournal::RecordCrc(Header.Op, Payload.GetData(), Payload.Num());
+
+	PendingBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	PendingBytes.Append(Payload);
+	NumRecords++;
+}
+
+bool FInventoryJournal::Flush(bool bSync)
+{
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	if (PendingBytes.Num() > 0)
+	{
+		if (!FileHandle->Write(PendingBytes.GetData(), PendingBytes.Num()))
+		{
+			return false;
+		}
+		PendingBytes.Reset();
+	}
+
+	return FileHandle->Flush(bSync);
+}
+
+bool FInventoryJournal::Read(const FString& FilePath, uint32& OutSnapshotCrc, TArray<FEntry>& OutEntries)
+{
+	OutEntries.Reset();
+	OutSnapshotCrc = 0;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	InventoryJournal::FFileHeader Header;
+	if (Bytes.Num() < static_cast<int32>(sizeof(Header)))
+	{
+		return false;
+	}
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+	if (Header.Magic != InventoryJournal::Magic || Header.Version != InventoryJournal::Version ||
+		Header.HeaderSize < sizeof(Header) || Header.HeaderSize > Bytes.Num())
+	{
+		return false;
+	}
+	OutSnapshotCrc = Header.SnapshotCrc;
+
+	int32 Offset = Header.HeaderSize;
+	while (Offset + static_cast<int32>(sizeof(InventoryJournal::FRecordHeader)) <= Bytes.Num())
+	{
+		InventoryJournal::FRecordHeader RecordHeader;
+		FMemory::Memcpy(&RecordHeader, Bytes.GetData() + Offset, sizeof(RecordHeader));
+		const int32 PayloadOffset = Offset + sizeof(RecordHeader);
+
+		// Torn or corrupt tail - everything before it is intact
+		if (PayloadOffset + RecordHeader.PayloadSize > Bytes.Num() ||
+			InventoryJournal::RecordCrc(RecordHeader.Op, Bytes.GetData() + PayloadOffset, RecordHeader.PayloadSize) != RecordHeader.Crc)
+		{
+			break;
+		}
+
+		TArray<uint8> Payload(Bytes.GetData() + PayloadOffset, RecordHeader.PayloadSize);
+		FMemoryReader Reader(Payload);
+
+		FEntry Entry;
+		Entry.Op = static_cast<EOp>(RecordHeader.Op);
+		switch (Entry.Op)
+		{
+		case EOp::Add:
+			{
+				FString DefinitionString;
+				Reader << Entry.ItemGUID << Entry.Value << Entry.Durability << DefinitionString;
+				Entry.DefinitionId = FName(*DefinitionString);
+				break;
+			}
+		case EOp::Remove:
+			Reader << Entry.ItemGUID;
+			break;
+		case EOp::SetStack:
+		case EOp::Move:
+			Reader << Entry.ItemGUID << Entry.Value;
+			break;
+		case EOp::Swap:
+			Reader << Entry.ItemGUID << Entry.OtherGUID;
+			break;
+		case EOp::Clear:
+			break;
+		case EOp::SetDurability:
+			Reader << Entry.ItemGUID << Entry.Durability;
+			break;
+		case EOp::Define:
+			{
+				FString DefinitionString;
+				Reader << DefinitionString << Entry.SavedDefinition;
+				Entry.DefinitionId = FName(*DefinitionString);
+				break;
+			}
+		case EOp::Sort:
+			{
+				uint8 NumCriteria = 0;
+				Reader << NumCriteria;
+				for (uint8 Index = 0; Index < NumCriteria && !Reader.IsError(); Index++)
+				{
+					uint8 Key = 0;
+					uint8 bDescending = 0;
+					Reader << Key << bDescending;
+
+					FInventorySortCriterion& Criterion = Entry.SortCriteria.AddDefaulted_GetRef();
+					Criterion.Key = static_cast<EInventorySortKey>(Key);
+					Criterion.bDescending = bDescending != 0;
+				}
+				break;
+			}
+		case EOp::MoveToContainer:
+			{
+				FString ContainerString;
+				uint8 bRotated = 0;
+				Reader << Entry.ItemGUID << ContainerString << Entry.Value << bRotated;
+				Entry.ContainerName = ContainerString.IsEmpty() ? NAME_None : FName(*ContainerString);
+				Entry.bRotated = bRotated != 0;
+				break;
+			}
+		case EOp::CompactContainer:
+			{
+				FString ContainerString;
+				Reader << ContainerString;
+				Entry.ContainerName = FName(*ContainerString);
+				break;
+			}
+		default:
+			// Unknown op from a newer build - can't safely skip past state we don't understand
+			return true;
+		}
+
+		if (Reader.IsError())
+		{
+			break;
+		}
+
+		OutEntries.Add(MoveTemp(Entry));
+		Offset = PayloadOffset + RecordHeader.PayloadSize;
+	}
+
+	return true;
+}
@@ -2,6 +2,35 @@
 
 #include "Core/InventoryManagerSubsystem.h"
 #include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
+#include "Core/InventorySaveFormat.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "Algo/StableSort.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/ScopeRWLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Build the merge key for an item
+FInventoryStackKey FInventoryStackKey::ForItem(const UInventoryItemData* Item)
+{
+	FInventoryStackKey Key;
+	Key.Category = Item->GetItemCategory();
+	
+	if (const UInventoryItemDefinition* Definition = Item->GetItemDefinition())
+	{
+		Key.DefinitionId = Definition->GetDefinitionId();
+	}
+	else
+	{
+		Key.Name = Item->GetItemName().ToString();
+	}
+	return Key;
+}
 
 // Initialize the subsystem
 void UInventoryManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -10,8 +39,20 @@ void UInventoryManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection
     
 	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Initialized"));
     
-	// Initialize the inventory array
+	// Initialize the inventory array and its GUID index
 	Items.Empty();
+	ItemIndexByGUID.Empty();
+	OpenStacksByKey.Empty();
+	SearchIndex.Reset();
+	ItemsByCategory.Empty();
+	ItemsByRarity.Empty();
+	
+	IconCache = MakeShared<FInventoryIconCache>(MaxResidentIcons);
+	
+	if (bPublishReadSnapshots)
+	{
+		PublishSnapshot(nullptr);
+	}
 }
 
 // Clean up on shutdown
@@ -19,8 +60,28 @@ void UInventoryManagerSubsystem::Deinitialize()
 {
 	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Shutting Down"));
 	
+	// Flush the journal before clearing, or the clear would be journaled too
+	CloseJournal();
+	
+	// Let in-flight saves finish writing (their completion events are dropped)
+	if (LastSaveTask.IsValid())
+	{
+		LastSaveTask.Wait();
+	}
+	
 	// Clean up inventory data
 	ClearInventory();
+	Containers.Empty();
+	ItemLocations.Empty();
+	
+	// Widgets may still hold the cache - drop its icons now rather than when the last one lets go
+	if (IconCache)
+	{
+		IconCache->Reset();
+		IconCache.Reset();
+	}
+	
+	SetReadSnapshotsEnabled(false);
 	
 	Super::Deinitialize();
 }
@@ -35,6 +96,9 @@ bool UInventoryManagerSubsystem::AddItem(UInventoryItemData* Item)
 		return false;
 	}
 	
+	// Coalesce every event this add produces into one change notification
+	FInventoryBatchScope BatchScope(this);
+	
 	// Check if inventory is full
 	if (!HasRoomForItem() && !Item->CanStack())
 	{
@@ -47,12 +111,9 @@ bool UInventoryManagerSubsystem::AddItem(UInventoryItemData* Item)
 	{
 		if (TryStackItem(Item))
 		{
+			// Stack changed events were raised per existing stack in TryStackItem
 			UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Stacked item %s"), *Item->GetItemName().ToString());
 			
-			// Broadcast stack changed events
-			OnItemStackChanged.Broadcast(Item->GetItemGUID(), Item->GetCurrentStackSize());
-			OnInventoryChanged.Broadcast();
-			
 			return true;
 		}
 	}
@@ -65,14 +126,13 @@ bool UInventoryManagerSubsystem::AddItem(UInventoryItemData* Item)
 	}
 	
 	// Add new item to inventory
-	Items.Add(Item);
+	AddItemToStore(Item);
 	
 	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Added new item %s (Total items: %d)"), 
 		*Item->GetItemName().ToString(), Items.Num());
 	
 	// Broadcast item added events
-	OnItemAdded.Broadcast(Item);
-	OnInventoryChanged.Broadcast();
+	NotifyItemAdded(Item);
 	
 	return true;
 }
@@ -81,23 +141,25 @@ bool UInventoryManagerSubsystem::AddItem(UInventoryItemData* Item)
 bool UInventoryManagerSubsystem::RemoveItem(FGuid ItemGUID)
 {
 	// Find the item
-	UInventoryItemData* FoundItem = FindItemByGUID(ItemGUID);
+	const int32 FoundIndex = FindItemIndexByGUID(ItemGUID);
 	
-	if (!FoundItem)
+	if (FoundIndex == INDEX_NONE)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item not found for removal"));
 		return false;
 	}
 	
+	FInventoryBatchScope BatchScope(this);
+	
 	// Remove from the array
-	Items.Remove(FoundItem);
+	UInventoryItemData* FoundItem = Items[FoundIndex];
+	RemoveItemFromStoreAt(FoundIndex);
 	
 	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Removed item %s (Remaining: %d)"),
 		*FoundItem->GetItemName().ToString(), Items.Num());
 	
 	// Broadcast item removed events
-	OnItemRemoved.Broadcast(ItemGUID);
-	OnInventoryChanged.Broadcast();
+	NotifyItemRemoved(ItemGUID);
 	
 	return true;
 }
@@ -124,14 +186,14 @@ bool UInventoryManagerSubsystem::RemoveItemQuantity(FGuid ItemGUID, int32 Quanti
 	}
 	
 	// Remove from stack
+	FInventoryBatchScope BatchScope(this);
 	if (FoundItem->RemoveFromStack(Quantity))
 	{
 		UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Removed %d from stack of %s"),
 			Quantity, *FoundItem->GetItemName().ToString());
 		
 		// Broadcast stack changed events
-		OnItemStackChanged.Broadcast(ItemGUID, FoundItem->GetCurrentStackSize());
-		OnInventoryChanged.Broadcast();
+		NotifyItemStackChanged(FoundItem);
 		
 		return true;
 	}
@@ -139,62 +201,262 @@ bool UInventoryManagerSubsystem::RemoveItemQuantity(FGuid ItemGUID, int32 Quanti
 	return false;
 }
 
+// Set an item's durability
+bool UInventoryManagerSubsystem::SetItemDurability(FGuid ItemGUID, float NewDurability)
+{
+	UInventoryItemData* FoundItem = FindItemByGUID(ItemGUID);
+	if (!FoundItem)
+	{
+		return false;
+	}
+	
+	const float ClampedDurability = FMath::Clamp(NewDurability, 0.0f, FoundItem->MaxDurability);
+	if (ClampedDurability != FoundItem->CurrentDurability)
+	{
+		FInventoryBatchScope BatchScope(this);
+		FoundItem->CurrentDurability = ClampedDurability;
+		RecordDurabilityChanged(ItemGUID);
+		
+		if (ShouldJournal())
+		{
+			Journal.AppendSetDurability(ItemGUID, ClampedDurability);
+			OnJournalRecordAppended();
+		}
+	}
+	
+	return true;
+}
+
 // Find an item by its GUID
 UInventoryItemData* UInventoryManagerSubsystem::FindItemByGUID(FGuid ItemGUID)
 {
-	for (UInventoryItemData* Item : Items)
+	const int32 Index = FindItemIndexByGUID(ItemGUID);
+	return Index != INDEX_NONE ? Items[Index] : nullptr;
+}
+
+// Find the array position of an item by its GUID
+int32 UInventoryManagerSubsystem::FindItemIndexByGUID(FGuid ItemGUID) const
+{
+	const int32* FoundIndex = ItemIndexByGUID.Find(ItemGUID);
+	return FoundIndex ? *FoundIndex : INDEX_NONE;
+}
+
+// Move an item to a new position, shifting the items in between
+bool UInventoryManagerSubsystem::MoveItem(FGuid ItemGUID, int32 NewIndex)
+{
+	const int32 OldIndex = FindItemIndexByGUID(ItemGUID);
+	if (OldIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item not found for move"));
+		return false;
+	}
+	
+	NewIndex = FMath::Clamp(NewIndex, 0, Items.Num() - 1);
+	if (NewIndex == OldIndex)
+	{
+		return true;
+	}
+	
+	UInventoryItemData* Item = Items[OldIndex];
+	
+	// Buckets are placed against the indices from before the move
+	MoveBucketEntry(ItemsByCategory.FindChecked(Item->GetItemCategory()), OldIndex, NewIndex, true);
+	MoveBucketEntry(ItemsByRarity.FindChecked(Item->GetItemRarity()), OldIndex, NewIndex, true);
+	
+	Items.RemoveAt(OldIndex, 1, EAllowShrinking::No);
+	Items.Insert(Item, NewIndex);
+	
+	// Only the items between the two positions shifted
+	ReindexItems(FMath::Min(OldIndex, NewIndex), FMath::Max(OldIndex, NewIndex));
+	
+	if (ShouldJournal())
 	{
-		if (Item && Item->GetItemGUID() == ItemGUID)
+		Journal.AppendMove(ItemGUID, NewIndex);
+		OnJournalRecordAppended();
+	}
+	
+	NotifyOrderChanged();
+	
+	return true;
+}
+
+// Swap two items in place
+bool UInventoryManagerSubsystem::SwapItems(FGuid FirstGUID, FGuid SecondGUID)
+{
+	const int32 FirstIndex = FindItemIndexByGUID(FirstGUID);
+	const int32 SecondIndex = FindItemIndexByGUID(SecondGUID);
+	if (FirstIndex == INDEX_NONE || SecondIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item not found for swap"));
+		return false;
+	}
+	
+	if (FirstIndex != SecondIndex)
+	{
+		const UInventoryItemData* First = Items[FirstIndex];
+		const UInventoryItemData* Second = Items[SecondIndex];
+		SwapBucketEntries(ItemsByCategory.FindChecked(First->GetItemCategory()), ItemsByCategory.FindChecked(Second->GetItemCategory()),
+			FirstIndex, SecondIndex);
+		SwapBucketEntries(ItemsByRarity.FindChecked(First->GetItemRarity()), ItemsByRarity.FindChecked(Second->GetItemRarity()),
+			FirstIndex, SecondIndex);
+		
+		Items.Swap(FirstIndex, SecondIndex);
+		ItemIndexByGUID.Add(FirstGUID, SecondIndex);
+		ItemIndexByGUID.Add(SecondGUID, FirstIndex);
+		
+		if (ShouldJournal())
 		{
-			return Item;
+			Journal.AppendSwap(FirstGUID, SecondGUID);
+			OnJournalRecordAppended();
 		}
+		
+		NotifyOrderChanged();
+	}
+	
+	return true;
+}
+
+// Reorder the whole inventory by packed sort keys
+void UInventoryManagerSubsystem::SortInventory(const TArray<FInventorySortCriterion>& Criteria)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryManagerSubsystem::SortInventory);
+	
+	Sorter.SetCriteria(Criteria);
+	if (!Sorter.HasCriteria())
+	{
+		return;
+	}
+	
+	TArray<int32> Order;
+	Sorter.Sort(Items, Order);
+	
+	bool bChanged = false;
+	for (int32 Index = 0; Index < Order.Num() && !bChanged; Index++)
+	{
+		bChanged = Order[Index] != Index;
+	}
+	if (!bChanged)
+	{
+		return;
+	}
+	
+	TArray<UInventoryItemData*> SortedItems;
+	SortedItems.Reserve(Items.Num());
+	for (const int32 Index : Order)
+	{
+		SortedItems.Add(Items[Index]);
+	}
+	Items = MoveTemp(SortedItems);
+	ReindexItems(0, Items.Num() - 1);
+	RebuildBuckets();
+	
+	// A sort moves everything, but replaying the same stable sort on the same items gives the same
+	// order - so the criteria are the whole record
+	if (ShouldJournal())
+	{
+		Journal.AppendSort(Sorter.GetCriteria());
+		OnJournalRecordAppended();
 	}
 	
-	return nullptr;
+	NotifyOrderChanged();
+}
+
+// Turn insertion-sorted adds on or off
+void UInventoryManagerSubsystem::SetAutoSort(bool bEnabled, const TArray<FInventorySortCriterion>& Criteria)
+{
+	if (bEnabled)
+	{
+		SortInventory(Criteria);
+	}
+	bKeepSorted = bEnabled && Sorter.HasCriteria();
 }
 
 // Clear all items from inventory
 void UInventoryManagerSubsystem::ClearInventory()
 {
+	FInventoryBatchScope BatchScope(this);
+	
 	int32 PreviousCount = Items.Num();
+	for (UInventoryItemData* Item : Items)
+	{
+		Item->OnStackSizeChanged.RemoveAll(this);
+		RecordRemoved(Item->GetItemGUID());
+	}
 	Items.Empty();
+	ItemIndexByGUID.Empty();
+	OpenStacksByKey.Empty();
+	SearchIndex.Reset();
+	ItemsByCategory.Empty();
+	ItemsByRarity.Empty();
+	TotalQuantity = 0;
+	TotalWeight = 0.0;
+	QuantityByCategory.Empty();
+	
+	if (ShouldJournal())
+	{
+		Journal.AppendClear();
+		OnJournalRecordAppended();
+	}
 	
 	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Cleared %d items from inventory"), PreviousCount);
 	
-	// Broadcast inventory cleared event
-	OnInventoryChanged.Broadcast();
+	// Inventory cleared event is broadcast when the batch scope closes
+	bPendingInventoryChange = true;
 }
 
-// Get items filtered by category
-TArray<UInventoryItemData*> UInventoryManagerSubsystem::GetItemsByCategory(EItemCategory Category) const
+// Visit every item without copying the array
+void UInventoryManagerSubsystem::ForEachItem(const FInventoryItemVisitor& Visitor) const
 {
-	TArray<UInventoryItemData*> FilteredItems;
-	
-	for (UInventoryItemData* Item : Items)
+	if (!Visitor.IsBound())
 	{
-		if (Item && Item->GetItemCategory() == Category)
-		{
-			FilteredItems.Add(Item);
-		}
+		return;
 	}
 	
-	return FilteredItems;
+	// Index loop with a live bounds check - the visitor is allowed to remove items
+	for (int32 Index = 0; Index < Items.Num(); Index++)
+	{
+		Visitor.Execute(Items[Index]);
+	}
+}
+
+// Get items filtered by category
+TArray<UInventoryItemData*> UInventoryManagerSubsystem::GetItemsByCategory(EItemCategory Category) const
+{
+	return TArray<UInventoryItemData*>(GetItemsByCategoryView(Category));
 }
 
 // Get items filtered by rarity
 TArray<UInventoryItemData*> UInventoryManagerSubsystem::GetItemsByRarity(EItemRarity Rarity) const
 {
-	TArray<UInventoryItemData*> FilteredItems;
+	return TArray<UInventoryItemData*>(GetItemsByRarityView(Rarity));
+}
 
-	for (UInventoryItemData* Item : Items)
-	{
-		if (Item && Item->GetItemRarity() == Rarity)
-		{
-			FilteredItems.Add(Item);
-		}
-	}
+// Fill a caller array with a category's items
+void UInventoryManagerSubsystem::GetItemsByCategoryInto(EItemCategory Category, TArray<UInventoryItemData*>& OutItems) const
+{
+	OutItems.Reset();
+	OutItems.Append(GetItemsByCategoryView(Category));
+}
+
+// Fill a caller array with a rarity's items
+void UInventoryManagerSubsystem::GetItemsByRarityInto(EItemRarity Rarity, TArray<UInventoryItemData*>& OutItems) const
+{
+	OutItems.Reset();
+	OutItems.Append(GetItemsByRarityView(Rarity));
+}
+
+// Bucket view for a category
+TConstArrayView<UInventoryItemData*> UInventoryManagerSubsystem::GetItemsByCategoryView(EItemCategory Category) const
+{
+	const TArray<UInventoryItemData*>* Bucket = ItemsByCategory.Find(Category);
+	return Bucket ? TConstArrayView<UInventoryItemData*>(*Bucket) : TConstArrayView<UInventoryItemData*>();
+}
 
-	return FilteredItems;
+// Bucket view for a rarity
+TConstArrayView<UInventoryItemData*> UInventoryManagerSubsystem::GetItemsByRarityView(EItemRarity Rarity) const
+{
+	const TArray<UInventoryItemData*>* Bucket = ItemsByRarity.Find(Rarity);
+	return Bucket ? TConstArrayView<UInventoryItemData*>(*Bucket) : TConstArrayView<UInventoryItemData*>();
 }
 
 // Search items by name (partial match, case insensitive)
@@ -207,39 +469,95 @@ TArray<UInventoryItemData*> UInventoryManagerSubsystem::SearchItemsByName(const
 		return Items; // Return all if search is empty
 	}
 	
-	FString LowerSearchText = SearchText.ToLower();
+	SearchIndex.Search(SearchText.ToLower(), MatchingItems);
 	
-	for (UInventoryItemData* Item : Items)
+	// The index is unordered - return matches in inventory order like a scan would
+	MatchingItems.Sort([this](const UInventoryItemData& A, const UInventoryItemData& B)
 	{
-		if (Item)
-		{
-			FString ItemName = Item->GetItemName().ToString().ToLower();
-			
-			// Partial match search
-			if (ItemName.Contains(LowerSearchText))
-			{
-				MatchingItems.Add(Item);
-			}
-		}
+		return FindItemIndexByGUID(A.GetItemGUID()) < FindItemIndexByGUID(B.GetItemGUID());
+	});
+	
+	return MatchingItems;
+}
+
+// Items matching a predicate, scanned in parallel when the inventory is large
+TArray<UInventoryItemData*> UInventoryManagerSubsystem::QueryItems(const FInventoryItemPredicate& Predicate) const
+{
+	// Stored items are in the search index, which has already normalized their names
+	FInventoryQueryOptions Options;
+	Options.bWarmNameCaches = false;
+	
+	TArray<UInventoryItemData*> MatchingItems;
+	FInventoryQuery::FindItems(Items, Predicate, MatchingItems, Options);
+	return MatchingItems;
+}
+
+// Total quantity of the items matching a predicate
+int64 UInventoryManagerSubsystem::GetMatchingItemQuantity(const FInventoryItemPredicate& Predicate) const
+{
+	FInventoryQueryOptions Options;
+	Options.bWarmNameCaches = false;
+	
+	return FInventoryQuery::SumQuantity(Items, Predicate, Options);
+}
+
+// Items matching a filter expression
+TArray<UInventoryItemData*> UInventoryManagerSubsystem::FilterItems(const FString& Expression) const
+{
+	TArray<UInventoryItemData*> MatchingItems;
+	
+	FString Error;
+	const TSharedPtr<const FInventoryFilterProgram> Program = GetCompiledFilter(Expression, Error);
+	if (!Program)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Invalid filter \"%s\": %s"), *Expression, *Error);
+		return MatchingItems;
+	}
+	
+	// Changes still inside an open batch haven't marked the view yet
+	if (bFilterViewDirty || bPendingInventoryChange)
+	{
+		FilterView.Build(Items);
+		bFilterViewDirty = false;
 	}
 	
+	Program->Evaluate(FilterView, MatchingItems);
 	return MatchingItems;
 }
 
-// Calculate total quantity of all items in inventory (including stack sizes)
-int32 UInventoryManagerSubsystem::GetTotalItemQuantity() const
+// Check that a filter expression compiles
+bool UInventoryManagerSubsystem::ValidateFilterExpression(const FString& Expression, FString& OutError) const
 {
-	int32 TotalQuantity = 0;
+	OutError.Reset();
+	return GetCompiledFilter(Expression, OutError).IsValid();
+}
 
-	for (UInventoryItemData* Item : Items)
+// Compiled program for an expression, compiling it on first use
+TSharedPtr<const FInventoryFilterProgram> UInventoryManagerSubsystem::GetCompiledFilter(const FString& Expression, FString& OutError) const
+{
+	if (const TSharedPtr<const FInventoryFilterProgram>* Cached = CompiledFilters.Find(Expression))
+	{
+		return *Cached;
+	}
+	
+	TSharedPtr<const FInventoryFilterProgram> Program = FInventoryFilterProgram::Compile(Expression, OutError);
+	if (Program)
 	{
-		if (Item)
+		// Expressions built on the fly (e.g. from a search box) shouldn't grow the cache forever
+		if (CompiledFilters.Num() >= 256)
 		{
-			TotalQuantity += Item->GetCurrentStackSize();
+			CompiledFilters.Reset();
 		}
+		CompiledFilters.Add(Expression, Program);
 	}
+	return Program;
+}
 
-	return TotalQuantity;
+// Running quantity of one category
+int32 UInventoryManagerSubsystem::GetCategoryQuantity(EItemCategory Category) const
+{
+	const int32* Quantity = QuantityByCategory.Find(Category);
+	return Quantity ? *Quantity : 0;
 }
 
 // Calculate how full the inventory is as a percentage
@@ -253,87 +571,1809 @@ float UInventoryManagerSubsystem::GetInventoryFillPercentage() const
 	return static_cast<float>(Items.Num()) / static_cast<float>(MaxInventorySlots);
 }
 
-// Set the maximum number of inventory slots (Never less than 1)
-void UInventoryManagerSubsystem::SetMaxInventorySlots(int32 NewMax)
+// First empty slot in a container
+int32 FInventoryContainer::FindFreeSlot() const
 {
-	MaxInventorySlots = FMath::Max(1, NewMax); // Ensure at least 1 slot
-    
-	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Max inventory slots set to %d"), MaxInventorySlots);
+	if (NumItems >= Slots.Num())
+	{
+		return INDEX_NONE;
+	}
+	
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); SlotIndex++)
+	{
+		if (!Slots[SlotIndex])
+		{
+			return SlotIndex;
+		}
+	}
+	return INDEX_NONE;
 }
 
-// TODO: Consider additional properties for stacking (e.g., durability, unique IDs, modifications, etc.)
-// Attempt to stack a new item with existing items in inventory
-bool UInventoryManagerSubsystem::TryStackItem(UInventoryItemData* NewItem)
+// Create a named container with a fixed number of slots
+bool UInventoryManagerSubsystem::CreateContainer(FName ContainerName, int32 Capacity)
 {
-	// Ensure Item is valid and stackable
-	if (!NewItem || !NewItem->CanStack())
+	if (ContainerName.IsNone() || Capacity <= 0 || Capacity > FInventorySaveRecord::MaxContainerSlots || Containers.Contains(ContainerName))
 	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Cannot create container %s"), *ContainerName.ToString());
 		return false;
 	}
 	
-	int32 RemainingToStack = NewItem->GetCurrentStackSize();
+	// All slots exist up front - items moving in and out never grow the array
+	FInventoryContainer& Container = Containers.Add(ContainerName);
+	Container.Slots.SetNumZeroed(Capacity);
 	
-	// Look for matching items to stack with
-	for (UInventoryItemData* ExistingItem : Items)
+	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Created container %s (%d slots)"), *ContainerName.ToString(), Capacity);
+	return true;
+}
+
+// Remove an empty named container
+bool UInventoryManagerSubsystem::RemoveContainer(FName ContainerName)
+{
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	if (!Container || Container->NumItems > 0)
 	{
-		if (!ExistingItem || RemainingToStack <= 0)
-		{
-			continue;
-		}
-		
-		// Check if items match (same name and category for simple matching)
-		bool bItemsMatch = ExistingItem->GetItemName().EqualTo(NewItem->GetItemName()) &&
-						  ExistingItem->GetItemCategory() == NewItem->GetItemCategory() &&
-						  ExistingItem->CanStack() &&
-						  !ExistingItem->IsStackFull();
-		
-		if (bItemsMatch)
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Cannot remove container %s"), *ContainerName.ToString());
+		return false;
+	}
+	
+	Containers.Remove(ContainerName);
+	return true;
+}
+
+// Slots in a container
+int32 UInventoryManagerSubsystem::GetContainerCapacity(FName ContainerName) const
+{
+	if (ContainerName.IsNone())
+	{
+		return MaxInventorySlots;
+	}
+	
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	return Container ? Container->Slots.Num() : 0;
+}
+
+// Items in a container
+int32 UInventoryManagerSubsystem::GetContainerItemCount(FName ContainerName) const
+{
+	if (ContainerName.IsNone())
+	{
+		return Items.Num();
+	}
+	
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	return Container ? Container->NumItems : 0;
+}
+
+// Items in a container, in slot order
+TArray<UInventoryItemData*> UInventoryManagerSubsystem::GetContainerItems(FName ContainerName) const
+{
+	if (ContainerName.IsNone())
+	{
+		return Items;
+	}
+	
+	TArray<UInventoryItemData*> ContainerItems;
+	if (const FInventoryContainer* Container = Containers.Find(ContainerName))
+	{
+		ContainerItems.Reserve(Container->NumItems);
+		for (UInventoryItemData* Item : Container->Slots)
 		{
-			// Calculate how much space is available in this stack
-			int32 SpaceAvailable = ExistingItem->GetMaxStackSize() - ExistingItem->GetCurrentStackSize();
-			int32 AmountToAdd = FMath::Min(SpaceAvailable, RemainingToStack);
-			
-			if (AmountToAdd > 0 && ExistingItem->AddToStack(AmountToAdd))
+			if (Item)
 			{
-				RemainingToStack -= AmountToAdd;
-				
-				UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Stacked %d items, %d remaining"), 
-					AmountToAdd, RemainingToStack);
+				ContainerItems.Add(Item);
 			}
 		}
 	}
-	
-	// Update NewItem's stack size to whatever couldn't be stacked
-	if (RemainingToStack < NewItem->GetCurrentStackSize())
+	return ContainerItems;
+}
+
+// Item in a container slot
+UInventoryItemData* UInventoryManagerSubsystem::GetItemInSlot(FName ContainerName, int32 SlotIndex) const
+{
+	if (ContainerName.IsNone())
 	{
-		if (RemainingToStack > 0)
-		{
-			// Some items remain - update the new item's stack size
-			NewItem->SetStackSize(RemainingToStack);
-			return false; // Still need to add as new slot
-		}
-		else
-		{
-			// Everything was stacked
-			return true;
-		}
+		return GetItemAt(SlotIndex);
 	}
 	
-	return false; // Couldn't stack anything
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	return Container && Container->Slots.IsValidIndex(SlotIndex) ? Container->Slots[SlotIndex].Get() : nullptr;
 }
 
-// Validate that an item is acceptable to add to inventory
-bool UInventoryManagerSubsystem::IsItemValid(UInventoryItemData* Item) const
+// Which container holds an item
+bool UInventoryManagerSubsystem::FindItemLocation(FGuid ItemGUID, FName& OutContainerName, int32& OutSlotIndex) const
 {
-	if (!Item)
+	if (const FInventoryItemLocation* Location = ItemLocations.Find(ItemGUID))
 	{
-		return false;
+		OutContainerName = Location->ContainerName;
+		OutSlotIndex = Location->SlotIndex;
+		return true;
 	}
 	
-	// Check if GUID is valid
-	if (!Item->GetItemGUID().IsValid())
+	OutContainerName = NAME_None;
+	OutSlotIndex = FindItemIndexByGUID(ItemGUID);
+	return OutSlotIndex != INDEX_NONE;
+}
+
+// Put a new item straight into a container
+bool UInventoryManagerSubsystem::AddItemToContainer(FName ContainerName, UInventoryItemData* Item, int32 SlotIndex)
+{
+	if (ContainerName.IsNone())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item has invalid GUID"));
+		return AddItem(Item);
+	}
+	
+	if (!IsItemValid(Item))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Attempted to add invalid item"));
+		return false;
+	}
+	
+	if (!PlaceInContainer(ContainerName, SlotIndex, Item))
+	{
+		return false;
+	}
+	
+	JournalContainerAdd(Item);
+	return true;
+}
+
+// Remove an item from wherever it is
+bool UInventoryManagerSubsystem::RemoveItemFromContainer(FGuid ItemGUID)
+{
+	if (!ItemLocations.Contains(ItemGUID))
+	{
+		return RemoveItem(ItemGUID);
+	}
+	
+	if (!TakeFromContainer(ItemGUID))
+	{
+		return false;
+	}
+	
+	if (ShouldJournal())
+	{
+		Journal.AppendRemove(ItemGUID);
+		OnJournalRecordAppended();
+	}
+	return true;
+}
+
+// Hand an item to another container without copying it
+bool UInventoryManagerSubsystem::MoveItemToContainer(FGuid ItemGUID, FName TargetContainer, int32 TargetSlot)
+{
+	return MoveItemToContainerSlot(ItemGUID, TargetContainer, TargetSlot, false);
+}
+
+// Move an item to a container slot with a given rotation
+bool UInventoryManagerSubsystem::MoveItemToContainerSlot(const FGuid& ItemGUID, FName TargetContainer, int32 TargetSlot, bool bRotated)
+{
+	const FInventoryItemLocation* Location = ItemLocations.Find(ItemGUID);
+	const int32 DefaultIndex = Location ? INDEX_NONE : FindItemIndexByGUID(ItemGUID);
+	if (!Location && DefaultIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item not found for container move"));
+		return false;
+	}
+	
+	// Check the destination before touching the source so a failed move changes nothing
+	if (TargetContainer.IsNone())
+	{
+		if (!Location)
+		{
+			return true; // Already there
+		}
+		if (!HasRoomForItem())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: No room to move item into the inventory"));
+			return false;
+		}
+	}
+	else
+	{
+		FInventoryContainer* Target = Containers.Find(TargetContainer);
+		if (!Target)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Container %s does not exist"), *TargetContainer.ToString());
+			return false;
+		}
+		
+		const UInventoryItemData* Item = Location
+			? Containers.FindChecked(Location->ContainerName).Slots[Location->SlotIndex].Get()
+			: Items[DefaultIndex];
+		
+		// Moving within one grid container - the item's current cells don't block its new ones
+		const bool bLiftFootprint = Location && Location->ContainerName == TargetContainer && Target->IsSpatial();
+		const FIntPoint CurrentCell = bLiftFootprint ? SlotToCell(*Target, Location->SlotIndex) : FIntPoint::ZeroValue;
+		const FIntPoint CurrentSize = bLiftFootprint ? GetPlacedSize(Item, Location->bRotated) : FIntPoint::ZeroValue;
+		if (bLiftFootprint)
+		{
+			Target->Grid.Clear(CurrentCell, CurrentSize);
+		}
+		
+		const bool bFits = FindContainerPlacement(*Target, Item, TargetSlot, bRotated);
+		
+		if (bLiftFootprint)
+		{
+			Target->Grid.Fill(CurrentCell, CurrentSize);
+		}
+		
+		if (!bFits)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: No free slot in container %s"), *TargetContainer.ToString());
+			return false;
+		}
+	}
+	
+	FInventoryBatchScope BatchScope(this);
+	
+	{
+		// The removal and add below are journaled as the one move
+		TGuardValue<bool> MoveGuard(bMovingToContainer, true);
+		
+		// Detach from the source
+		UInventoryItemData* Item = nullptr;
+		if (Location)
+		{
+			Item = TakeFromContainer(ItemGUID);
+		}
+		else
+		{
+			Item = Items[DefaultIndex];
+			RemoveItemFromStoreAt(DefaultIndex);
+			NotifyItemRemoved(ItemGUID);
+		}
+		
+		// Attach to the target
+		if (TargetContainer.IsNone())
+		{
+			AddItemToStore(Item);
+			NotifyItemAdded(Item);
+		}
+		else
+		{
+			PlaceInContainer(TargetContainer, TargetSlot, Item, bRotated);
+		}
+	}
+	
+	// Record the slot that was actually used, so replay doesn't have to pick the same free one
+	if (ShouldJournal())
+	{
+		Journal.AppendMoveToContainer(ItemGUID, TargetContainer, TargetContainer.IsNone() ? INDEX_NONE : TargetSlot, bRotated);
+		
+		// Auto-sort may have inserted it mid-list - same as NotifyItemAdded, record where it went
+		const int32 Index = TargetContainer.IsNone() ? FindItemIndexByGUID(ItemGUID) : INDEX_NONE;
+		if (Index != INDEX_NONE && Index != Items.Num() - 1)
+		{
+			Journal.AppendMove(ItemGUID, Index);
+		}
+		OnJournalRecordAppended();
+	}
+	
+	return true;
+}
+
+// Create a container whose items take up a footprint of cells
+bool UInventoryManagerSubsystem::CreateGridContainer(FName ContainerName, int32 Width, int32 Height, EInventoryPlacementMode PlacementMode)
+{
+	if (Width <= 0 || Width > FInventorySpatialGrid::MaxWidth || Height <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Invalid grid size %dx%d for container %s"), Width, Height, *ContainerName.ToString());
+		return false;
+	}
+	
+	if (!CreateContainer(ContainerName, Width * Height))
+	{
+		return false;
+	}
+	
+	FInventoryContainer& Container = Containers.FindChecked(ContainerName);
+	Container.Grid.Init(Width, Height);
+	Container.PlacementMode = PlacementMode;
+	return true;
+}
+
+// Columns and rows of a grid container
+FIntPoint UInventoryManagerSubsystem::GetGridContainerSize(FName ContainerName) const
+{
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	return Container && Container->IsSpatial()
+		? FIntPoint(Container->Grid.GetWidth(), Container->Grid.GetHeight())
+		: FIntPoint::ZeroValue;
+}
+
+// Where an item of a given size would go
+bool UInventoryManagerSubsystem::FindGridPlacement(FName ContainerName, FIntPoint ItemSize, bool bAllowRotation, FIntPoint& OutPosition, bool& bOutRotated) const
+{
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	if (!Container || !Container->IsSpatial())
+	{
+		bOutRotated = false;
+		return false;
+	}
+	
+	return Container->Grid.FindPlacement(ItemSize, bAllowRotation, Container->PlacementMode, OutPosition, bOutRotated);
+}
+
+// Put an item at a cell of a grid container
+bool UInventoryManagerSubsystem::MoveItemInGrid(FGuid ItemGUID, FName ContainerName, FIntPoint Position, bool bRotated)
+{
+	const FInventoryContainer* Container = Containers.Find(ContainerName);
+	if (!Container || !Container->IsSpatial() ||
+		Position.X < 0 || Position.Y < 0 || Position.X >= Container->Grid.GetWidth() || Position.Y >= Container->Grid.GetHeight())
+	{
+		return false;
+	}
+	
+	return MoveItemToContainerSlot(ItemGUID, ContainerName, Position.Y * Container->Grid.GetWidth() + Position.X, bRotated);
+}
+
+// An item's cells in its grid container
+bool UInventoryManagerSubsystem::GetItemGridPlacement(FGuid ItemGUID, FIntPoint& OutPosition, FIntPoint& OutSize) const
+{
+	const FInventoryItemLocation* Location = ItemLocations.Find(ItemGUID);
+	const FInventoryContainer* Container = Location ? Containers.Find(Location->ContainerName) : nullptr;
+	if (!Container || !Container->IsSpatial())
+	{
+		return false;
+	}
+	
+	OutPosition = SlotToCell(*Container, Location->SlotIndex);
+	OutSize = GetPlacedSize(Container->Slots[Location->SlotIndex], Location->bRotated);
+	return true;
+}
+
+// Repack a grid container, largest items first
+bool UInventoryManagerSubsystem::CompactGridContainer(FName ContainerName)
+{
+	FInventoryContainer* Container = Containers.Find(ContainerName);
+	if (!Container || !Container->IsSpatial())
+	{
+		return false;
+	}
+	
+	// Current placements, in slot order
+	struct FPlacement
+	{
+		UInventoryItemData* Item;
+		int32 OldSlot;
+		bool bOldRotated;
+		int32 NewSlot;
+		bool bNewRotated;
+	};
+	TArray<FPlacement> Placements;
+	Placements.Reserve(Container->NumItems);
+	for (int32 SlotIndex = 0; SlotIndex < Container->Slots.Num(); SlotIndex++)
+	{
+		if (UInventoryItemData* Item = Container->Slots[SlotIndex])
+		{
+			Placements.Add({ Item, SlotIndex, ItemLocations.FindChecked(Item->GetItemGUID()).bRotated, INDEX_NONE, false });
+		}
+	}
+	
+	// Largest footprint first, taller first on a tie; stable so equal items keep their order
+	Algo::StableSort(Placements, [](const FPlacement& A, const FPlacement& B)
+	{
+		const FIntPoint SizeA = A.Item->GetGridSize();
+		const FIntPoint SizeB = B.Item->GetGridSize();
+		const int32 AreaA = SizeA.X * SizeA.Y;
+		const int32 AreaB = SizeB.X * SizeB.Y;
+		return AreaA != AreaB ? AreaA > AreaB : FMath::Max(SizeA.X, SizeA.Y) > FMath::Max(SizeB.X, SizeB.Y);
+	});
+	
+	// Lay everything out on a scratch grid first - the real one is only touched if it all fits
+	FInventorySpatialGrid Packed;
+	Packed.Init(Container->Grid.GetWidth(), Container->Grid.GetHeight());
+	for (FPlacement& Placement : Placements)
+	{
+		FIntPoint Position;
+		if (!Packed.FindPlacement(Placement.Item->GetGridSize(), true, EInventoryPlacementMode::FirstFit, Position, Placement.bNewRotated))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Container %s could not be repacked"), *ContainerName.ToString());
+			return false;
+		}
+		Packed.Fill(Position, GetPlacedSize(Placement.Item, Placement.bNewRotated));
+		Placement.NewSlot = Position.Y * Packed.GetWidth() + Position.X;
+	}
+	
+	// Apply: clear the old slots, then write the new ones
+	for (const FPlacement& Placement : Placements)
+	{
+		Container->Slots[Placement.OldSlot] = nullptr;
+	}
+	for (const FPlacement& Placement : Placements)
+	{
+		Container->Slots[Placement.NewSlot] = Placement.Item;
+		ItemLocations.Add(Placement.Item->GetItemGUID(), FInventoryItemLocation{ ContainerName, Placement.NewSlot, Placement.bNewRotated });
+	}
+	Container->Grid = MoveTemp(Packed);
+	
+	// Announce only the items that actually moved
+	for (const FPlacement& Placement : Placements)
+	{
+		if (Placement.OldSlot != Placement.NewSlot || Placement.bOldRotated != Placement.bNewRotated)
+		{
+			OnContainerItemRemoved.Broadcast(ContainerName, Placement.Item->GetItemGUID(), Placement.OldSlot);
+		}
+	}
+	for (const FPlacement& Placement : Placements)
+	{
+		if (Placement.OldSlot != Placement.NewSlot || Placement.bOldRotated != Placement.bNewRotated)
+		{
+			OnContainerItemAdded.Broadcast(ContainerName, Placement.Item, Placement.NewSlot);
+		}
+	}
+	
+	// Replay repacks the same items the same way
+	if (ShouldJournal())
+	{
+		Journal.AppendCompactContainer(ContainerName);
+		OnJournalRecordAppended();
+	}
+	
+	return true;
+}
+
+// Register a shared definition under its ID
+bool UInventoryManagerSubsystem::RegisterItemDefinition(UInventoryItemDefinition* Definition)
+{
+	if (!Definition)
+	{
+		return false;
+	}
+	
+	const FName DefinitionId = Definition->GetDefinitionId();
+	UInventoryItemDefinition* Existing = FindItemDefinition(DefinitionId);
+	if (Existing && Existing != Definition)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Definition ID %s is already registered"), *DefinitionId.ToString());
+		return false;
+	}
+	
+	ItemDefinitions.Add(DefinitionId, Definition);
+	return true;
+}
+
+// Look up a registered definition
+UInventoryItemDefinition* UInventoryManagerSubsystem::FindItemDefinition(FName DefinitionId) const
+{
+	const TObjectPtr<UInventoryItemDefinition>* Found = ItemDefinitions.Find(DefinitionId);
+	return Found ? Found->Get() : nullptr;
+}
+
+// Mirror a server item into this inventory
+UInventoryItemData* UInventoryManagerSubsystem::ApplyReplicatedAdd(const FInventoryItemInstance& Instance)
+{
+	UInventoryItemDefinition* Definition = Instance.Definition;
+	if (!Definition || !Instance.ItemGUID.IsValid() || ItemIndexByGUID.Contains(Instance.ItemGUID) || ItemLocations.Contains(Instance.ItemGUID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Skipping replicated add of %s"), *Instance.ItemGUID.ToString());
+		return nullptr;
+	}
+	
+	// Lets a client save what it was sent
+	if (!FindItemDefinition(Definition->GetDefinitionId()))
+	{
+		RegisterItemDefinition(Definition);
+	}
+	
+	FInventoryBatchScope BatchScope(this);
+	return RestoreItem(Definition, Instance.ItemGUID, Instance.StackCount, Instance.Durability);
+}
+
+// Remove a mirrored item
+bool UInventoryManagerSubsystem::ApplyReplicatedRemove(const FGuid& ItemGUID)
+{
+	const int32 Index = FindItemIndexByGUID(ItemGUID);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+	
+	FInventoryBatchScope BatchScope(this);
+	RemoveItemFromStoreAt(Index);
+	NotifyItemRemoved(ItemGUID);
+	return true;
+}
+
+// Update a mirrored item's stack and durability
+bool UInventoryManagerSubsystem::ApplyReplicatedState(const FInventoryItemInstance& Instance)
+{
+	UInventoryItemData* Item = FindItemByGUID(Instance.ItemGUID);
+	if (!Item)
+	{
+		return false;
+	}
+	
+	FInventoryBatchScope BatchScope(this);
+	if (Item->GetCurrentStackSize() != Instance.StackCount)
+	{
+		Item->SetStackSize(Instance.StackCount);
+		NotifyItemStackChanged(Item);
+	}
+	SetItemDurability(Instance.ItemGUID, Instance.Durability);
+	return true;
+}
+
+// Write the inventory to a binary save file
+bool UInventoryManagerSubsystem::SaveInventory(const FString& FilePath) const
+{
+	const FString SavePath = FilePath.IsEmpty() ? GetDefaultSaveFilePath() : FilePath;
+	
+	TArray<FInventorySaveContainerItem> ContainerItems;
+	CaptureContainerItems(ContainerItems);
+	
+	FInventorySaveData SaveData;
+	FInventorySaveFormat::BuildSaveData(Items, SaveData, ContainerItems);
+	
+	if (!FInventorySaveFormat::WriteToFile(SaveData, SavePath, false))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Failed to write save file %s"), *SavePath);
+		return false;
+	}
+	
+	if (SaveData.NumSkippedItems > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: %d items without a definition were not saved"), SaveData.NumSkippedItems);
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Saved %d items to %s"), SaveData.Records.Num(), *SavePath);
+	return true;
+}
+
+// Snapshot the inventory now, write it on a background task
+void UInventoryManagerSubsystem::SaveInventoryAsync(const FString& FilePath, bool bCompress)
+{
+	const FString SavePath = FilePath.IsEmpty() ? GetDefaultSaveFilePath() : FilePath;
+	
+	// The snapshot is a flat copy of the per-item records - the only work done on the game thread.
+	// The task owns it, so the live inventory is free to change while the save runs.
+	TArray<FInventorySaveContainerItem> ContainerItems;
+	CaptureContainerItems(ContainerItems);
+	
+	TSharedRef<FInventorySaveData> SaveData = MakeShared<FInventorySaveData>();
+	FInventorySaveFormat::BuildSaveData(Items, *SaveData, ContainerItems);
+	
+	if (SaveData->NumSkippedItems > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: %d items without a definition will not be saved"), SaveData->NumSkippedItems);
+	}
+	
+	NumSavesInFlight++;
+	TWeakObjectPtr<UInventoryManagerSubsystem> WeakThis(this);
+	
+	LastSaveTask = SavePipe.Launch(TEXT("InventorySave"), [WeakThis, SaveData, SavePath, bCompress]()
+	{
+		const bool bSuccess = FInventorySaveFormat::WriteToFile(*SaveData, SavePath, bCompress);
+		
+		// Report back on the game thread, where listeners expect inventory events
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SavePath, bSuccess, NumRecords = SaveData->Records.Num()]()
+		{
+			UInventoryManagerSubsystem* InventoryManager = WeakThis.Get();
+			if (!InventoryManager)
+			{
+				return;
+			}
+			
+			InventoryManager->NumSavesInFlight--;
+			if (bSuccess)
+			{
+				UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Saved %d items to %s"), NumRecords, *SavePath);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Failed to write save file %s"), *SavePath);
+			}
+			InventoryManager->OnInventorySaveCompleted.Broadcast(SavePath, bSuccess);
+		});
+	});
+}
+
+// Replace the inventory with the contents of a save file
+bool UInventoryManagerSubsystem::LoadInventory(const FString& FilePath)
+{
+	return LoadSaveFile(FilePath.IsEmpty() ? GetDefaultSaveFilePath() : FilePath);
+}
+
+// Read a save file and rebuild the store from it
+bool UInventoryManagerSubsystem::LoadSaveFile(const FString& SavePath, uint32* OutPayloadCrc, bool bRequireAll)
+{
+	// Map the file so records are read in place; fall back to a plain read where mapping isn't supported.
+	// The region is declared after the handle so it is released first.
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*SavePath));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+	TArray<uint8> FileBytes;
+	
+	TConstArrayView<uint8> Bytes;
+	if (MappedRegion)
+	{
+		Bytes = MakeArrayView(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	}
+	else if (FFileHelper::LoadFileToArray(FileBytes, *SavePath, FILEREAD_Silent))
+	{
+		Bytes = FileBytes;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Could not open save file %s"), *SavePath);
+		return false;
+	}
+	
+	// Compressed saves (from SaveInventoryAsync) are expanded into memory first
+	TArray<uint8> DecompressedBytes;
+	if (FInventorySaveFormat::IsCompressed(Bytes))
+	{
+		if (!FInventorySaveFormat::Decompress(Bytes, DecompressedBytes))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Could not decompress save file %s"), *SavePath);
+			return false;
+		}
+		Bytes = DecompressedBytes;
+	}
+	
+	FInventorySaveView SaveView;
+	if (!FInventorySaveFormat::Parse(Bytes, SaveView))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: %s is not a valid inventory save"), *SavePath);
+		return false;
+	}
+	
+	const int32 NumRestored = RestoreFromSave(SaveView, bRequireAll);
+	if (NumRestored == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: %s has items that can't be restored"), *SavePath);
+		return false;
+	}
+	
+	if (OutPayloadCrc)
+	{
+		*OutPayloadCrc = SaveView.PayloadCrc;
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Loaded %d of %d items from %s"),
+		NumRestored, SaveView.Records.Num(), *SavePath);
+	return true;
+}
+
+// Restore save + journal, then journal every change from here on
+bool UInventoryManagerSubsystem::OpenJournal(const FString& FilePath)
+{
+	CloseJournal();
+	
+	const FString SavePath = FilePath.IsEmpty() ? GetDefaultSaveFilePath() : FilePath;
+	const FString JournalPath = SavePath + TEXT(".journal");
+	
+	// Last full save, if there is one
+	uint32 SaveCrc = 0;
+	if (IFileManager::Get().FileExists(*SavePath))
+	{
+		// Nothing may be dropped on the way in - the compaction below would make the loss permanent
+		if (!LoadSaveFile(SavePath, &SaveCrc, true))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Could not open journal, %s failed to load"), *SavePath);
+			return false;
+		}
+		
+		// Changes made since that save
+		uint32 JournalSaveCrc = 0;
+		TArray<FInventoryJournal::FEntry> Entries;
+		if (FInventoryJournal::Read(JournalPath, JournalSaveCrc, Entries))
+		{
+			if (JournalSaveCrc == SaveCrc)
+			{
+				if (!ReplayJournal(Entries))
+				{
+					UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Could not open journal, %s has changes that can't be replayed"), *JournalPath);
+					return false;
+				}
+				UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Replayed %d journal records"), Entries.Num());
+			}
+			else
+			{
+				// Compaction finished writing the save but not the new journal - the save already has everything
+				UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Ignoring journal written for an older save"));
+			}
+		}
+	}
+	
+	// Fold it all into a fresh save with an empty journal on top
+	JournalSavePath = SavePath;
+	if (!WriteJournalBase())
+	{
+		return false;
+	}
+	
+	JournalTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UInventoryManagerSubsystem::TickJournal), JournalSyncInterval);
+	
+	return true;
+}
+
+// Flush and stop journaling
+void UInventoryManagerSubsystem::CloseJournal()
+{
+	if (JournalTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(JournalTickerHandle);
+		JournalTickerHandle.Reset();
+	}
+	
+	Journal.Close();
+}
+
+// Fold the journal into a full save
+bool UInventoryManagerSubsystem::CompactJournal()
+{
+	if (!Journal.IsOpen())
+	{
+		return false;
+	}
+	
+	return WriteJournalBase();
+}
+
+// Default save location
+FString UInventoryManagerSubsystem::GetDefaultSaveFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Inventory") / TEXT("Inventory.inv");
+}
+
+// Set the maximum number of inventory slots (Never less than 1)
+void UInventoryManagerSubsystem::SetMaxInventorySlots(int32 NewMax)
+{
+	MaxInventorySlots = FMath::Max(1, NewMax); // Ensure at least 1 slot
+    
+	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Max inventory slots set to %d"), MaxInventorySlots);
+}
+
+// Set the over-encumbrance limit (0 = no limit)
+void UInventoryManagerSubsystem::SetMaxCarryWeight(float NewMax)
+{
+	MaxCarryWeight = FMath::Max(0.0f, NewMax);
+	UpdateEncumbrance();
+}
+
+// Set the resident icon budget
+void UInventoryManagerSubsystem::SetMaxResidentIcons(int32 NewMax)
+{
+	MaxResidentIcons = FMath::Max(0, NewMax);
+	if (IconCache)
+	{
+		IconCache->SetMaxResidentIcons(MaxResidentIcons);
+	}
+}
+
+// Start or stop publishing read snapshots
+void UInventoryManagerSubsystem::SetReadSnapshotsEnabled(bool bEnabled)
+{
+	bPublishReadSnapshots = bEnabled;
+	
+	if (bEnabled)
+	{
+		PublishSnapshot(nullptr);
+		return;
+	}
+	
+	SnapshotItems.Reset();
+	
+	// Readers may still hold it - just stop handing it out
+	FInventorySnapshotPtr OldSnapshot;
+	{
+		FWriteScopeLock WriteLock(SnapshotLock);
+		Swap(PublishedSnapshot, OldSnapshot);
+	}
+}
+
+// Latest published snapshot (any thread)
+FInventorySnapshotPtr UInventoryManagerSubsystem::AcquireSnapshot() const
+{
+	FReadScopeLock ReadLock(SnapshotLock);
+	return PublishedSnapshot;
+}
+
+// Capture the items into a new snapshot and swap it in
+void UInventoryManagerSubsystem::PublishSnapshot(const FInventoryChangeDelta* Delta)
+{
+	check(IsInGameThread());
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryManagerSubsystem::PublishSnapshot);
+	
+	if (!Delta)
+	{
+		SnapshotItems.Reset();
+	}
+	else
+	{
+		// Changed items are recaptured below, everything else is shared with the last snapshot
+		for (const FGuid& ItemGUID : Delta->RemovedItems)
+		{
+			SnapshotItems.Remove(ItemGUID);
+		}
+		for (const FGuid& ItemGUID : Delta->AddedItems)
+		{
+			SnapshotItems.Remove(ItemGUID);
+		}
+		for (const FGuid& ItemGUID : Delta->RestackedItems)
+		{
+			SnapshotItems.Remove(ItemGUID);
+		}
+		for (const FGuid& ItemGUID : Delta->DurabilityChangedItems)
+		{
+			SnapshotItems.Remove(ItemGUID);
+		}
+	}
+	
+	TArray<FInventorySnapshotItemRef> SnapshotRows;
+	SnapshotRows.Reserve(Items.Num());
+	for (const UInventoryItemData* Item : Items)
+	{
+		if (const FInventorySnapshotItemRef* Captured = SnapshotItems.Find(Item->GetItemGUID()))
+		{
+			SnapshotRows.Add(*Captured);
+		}
+		else
+		{
+			FInventorySnapshotItemRef Row = MakeShared<FInventorySnapshotItem, ESPMode::ThreadSafe>(FInventorySnapshotItem::Capture(*Item));
+			SnapshotItems.Add(Item->GetItemGUID(), Row);
+			SnapshotRows.Add(MoveTemp(Row));
+		}
+	}
+	
+	// Items that left without a removal record (e.g. moved into a container)
+	if (SnapshotItems.Num() != SnapshotRows.Num())
+	{
+		SnapshotItems.Reset();
+		for (const FInventorySnapshotItemRef& Row : SnapshotRows)
+		{
+			SnapshotItems.Add(Row->ItemGUID, Row);
+		}
+	}
+	
+	FInventorySnapshotPtr NewSnapshot = MakeShared<FInventorySnapshot, ESPMode::ThreadSafe>(++SnapshotVersion, MoveTemp(SnapshotRows));
+	{
+		FWriteScopeLock WriteLock(SnapshotLock);
+		Swap(PublishedSnapshot, NewSnapshot);
+	}
+	// The previous snapshot is released here, outside the lock, or later by whoever still holds it
+}
+
+// TODO: Consider additional properties for stacking (e.g., durability, unique IDs, modifications, etc.)
+// Attempt to stack a new item with existing items in inventory
+bool UInventoryManagerSubsystem::TryStackItem(UInventoryItemData* NewItem)
+{
+	// Ensure Item is valid and stackable
+	if (!NewItem || !NewItem->CanStack())
+	{
+		return false;
+	}
+	
+	const FInventoryStackKey Key = FInventoryStackKey::ForItem(NewItem);
+	int32 RemainingToStack = NewItem->GetCurrentStackSize();
+	
+	// Only stacks with the same merge key and room left are candidates.
+	// Filling a stack removes it from the list (via HandleItemStackSizeChanged), so always take the front.
+	while (RemainingToStack > 0)
+	{
+		TArray<UInventoryItemData*>* OpenStacks = OpenStacksByKey.Find(Key);
+		if (!OpenStacks || OpenStacks->Num() == 0)
+		{
+			break;
+		}
+		
+		UInventoryItemData* ExistingItem = (*OpenStacks)[0];
+		
+		// Calculate how much space is available in this stack
+		int32 SpaceAvailable = ExistingItem->GetMaxStackSize() - ExistingItem->GetCurrentStackSize();
+		int32 AmountToAdd = FMath::Min(SpaceAvailable, RemainingToStack);
+		
+		if (AmountToAdd <= 0 || !ExistingItem->AddToStack(AmountToAdd))
+		{
+			// Index disagrees with the item - drop it rather than spin
+			OpenStacks->RemoveAt(0);
+			continue;
+		}
+		
+		RemainingToStack -= AmountToAdd;
+		NotifyItemStackChanged(ExistingItem);
+		
+		UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Stacked %d items, %d remaining"), 
+			AmountToAdd, RemainingToStack);
+	}
+	
+	// Update NewItem's stack size to whatever couldn't be stacked
+	if (RemainingToStack < NewItem->GetCurrentStackSize())
+	{
+		if (RemainingToStack > 0)
+		{
+			// Some items remain - update the new item's stack size
+			NewItem->SetStackSize(RemainingToStack);
+			return false; // Still need to add as new slot
+		}
+		else
+		{
+			// Everything was stacked
+			return true;
+		}
+	}
+	
+	return false; // Couldn't stack anything
+}
+
+// Open a batch - nested batches are folded into the outermost one
+void UInventoryManagerSubsystem::BeginBatch()
+{
+	BatchDepth++;
+}
+
+// Close a batch and flush the consolidated change events when the outermost one ends
+void UInventoryManagerSubsystem::EndBatch()
+{
+	if (BatchDepth <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: EndBatch called without a matching BeginBatch"));
+		return;
+	}
+	
+	if (--BatchDepth == 0)
+	{
+		if (JournalSyncInterval <= 0.0f && Journal.HasPendingRecords())
+		{
+			Journal.Flush(true);
+		}
+		UpdateEncumbrance();
+		FlushPendingChanges();
+	}
+}
+
+// Broadcast the accumulated delta and the general change event
+void UInventoryManagerSubsystem::FlushPendingChanges()
+{
+	if (!bPendingInventoryChange)
+	{
+		return;
+	}
+	
+	CompactPendingDelta();
+	
+	// Listeners may mutate the inventory again, so hand them a detached copy
+	const FInventoryChangeDelta Delta = MoveTemp(PendingDelta);
+	PendingDelta = FInventoryChangeDelta();
+	bPendingInventoryChange = false;
+	
+	FilterView.Reset();
+	bFilterViewDirty = true;
+	
+	// Published before the events so listeners that hand work to other threads see this batch
+	if (bPublishReadSnapshots)
+	{
+		PublishSnapshot(&Delta);
+	}
+	
+	OnInventoryBatchChanged.Broadcast(Delta);
+	OnInventoryChanged.Broadcast();
+}
+
+// Item added - per-item event now, general change at end of batch
+void UInventoryManagerSubsystem::NotifyItemAdded(UInventoryItemData* Item)
+{
+	bool bAlreadyAdded = false;
+	PendingAddedSet.Add(Item->GetItemGUID(), &bAlreadyAdded);
+	if (!bAlreadyAdded)
+	{
+		PendingDelta.AddedItems.Add(Item->GetItemGUID());
+	}
+	bPendingInventoryChange = true;
+	
+	// Auto-sort inserted it mid-list - listeners can't just append it
+	const int32 Index = FindItemIndexByGUID(Item->GetItemGUID());
+	const bool bInserted = Index != Items.Num() - 1;
+	if (bInserted)
+	{
+		PendingDelta.bOrderChanged = true;
+	}
+	
+	// Journal the item as it was finally stored (after any partial stacking)
+	if (ShouldJournal())
+	{
+		if (const UInventoryItemDefinition* Definition = Item->GetItemDefinition())
+		{
+			Journal.AppendAdd(Item->GetItemGUID(), *Definition, Item->GetCurrentStackSize(), Item->CurrentDurability);
+			if (bInserted)
+			{
+				// Replay appends, so record where the item really went
+				Journal.AppendMove(Item->GetItemGUID(), Index);
+			}
+			OnJournalRecordAppended();
+		}
+	}
+	
+	OnItemAdded.Broadcast(Item);
+}
+
+// Item removed - per-item event now, general change at end of batch
+void UInventoryManagerSubsystem::NotifyItemRemoved(const FGuid& ItemGUID)
+{
+	RecordRemoved(ItemGUID);
+	
+	if (ShouldJournal())
+	{
+		Journal.AppendRemove(ItemGUID);
+		OnJournalRecordAppended();
+	}
+	
+	OnItemRemoved.Broadcast(ItemGUID);
+}
+
+// Stack size changed - per-item event now, general change at end of batch
+void UInventoryManagerSubsystem::NotifyItemStackChanged(UInventoryItemData* Item)
+{
+	const FGuid& ItemGUID = Item->GetItemGUID();
+	RecordRestacked(ItemGUID);
+	
+	OnItemStackChanged.Broadcast(ItemGUID, Item->GetCurrentStackSize());
+}
+
+// Items were reordered without being added or removed
+void UInventoryManagerSubsystem::NotifyOrderChanged()
+{
+	PendingDelta.bOrderChanged = true;
+	bPendingInventoryChange = true;
+	
+	if (BatchDepth == 0)
+	{
+		FlushPendingChanges();
+	}
+}
+
+// Fold a removal into the pending delta
+void UInventoryManagerSubsystem::RecordRemoved(const FGuid& ItemGUID)
+{
+	// Added and removed inside the same batch - nothing for listeners to see
+	if (PendingAddedSet.Remove(ItemGUID) == 0)
+	{
+		bool bAlreadyRemoved = false;
+		PendingRemovedSet.Add(ItemGUID, &bAlreadyRemoved);
+		if (!bAlreadyRemoved)
+		{
+			PendingDelta.RemovedItems.Add(ItemGUID);
+		}
+	}
+	PendingRestackedSet.Remove(ItemGUID);
+	PendingDurabilitySet.Remove(ItemGUID);
+	bPendingInventoryChange = true;
+}
+
+// Fold a stack size change into the pending delta
+void UInventoryManagerSubsystem::RecordRestacked(const FGuid& ItemGUID)
+{
+	if (!PendingAddedSet.Contains(ItemGUID))
+	{
+		bool bAlreadyRestacked = false;
+		PendingRestackedSet.Add(ItemGUID, &bAlreadyRestacked);
+		if (!bAlreadyRestacked)
+		{
+			PendingDelta.RestackedItems.Add(ItemGUID);
+		}
+	}
+	bPendingInventoryChange = true;
+}
+
+// Fold a durability change into the pending delta
+void UInventoryManagerSubsystem::RecordDurabilityChanged(const FGuid& ItemGUID)
+{
+	if (!PendingAddedSet.Contains(ItemGUID))
+	{
+		bool bAlreadyChanged = false;
+		PendingDurabilitySet.Add(ItemGUID, &bAlreadyChanged);
+		if (!bAlreadyChanged)
+		{
+			PendingDelta.DurabilityChangedItems.Add(ItemGUID);
+		}
+	}
+	bPendingInventoryChange = true;
+}
+
+// One pass per list at flush time instead of a list search per change
+void UInventoryManagerSubsystem::CompactPendingDelta()
+{
+	// Keeps the first occurrence of each GUID still in its set (an item removed and re-added
+	// inside the batch can be listed twice) and empties the sets for the next batch
+	auto Compact = [](TArray<FGuid>& List, TSet<FGuid>& Members)
+	{
+		if (List.Num() != Members.Num())
+		{
+			List.RemoveAll([&Members](const FGuid& ItemGUID) { return Members.Remove(ItemGUID) == 0; });
+		}
+		Members.Reset();
+	};
+	
+	Compact(PendingDelta.AddedItems, PendingAddedSet);
+	Compact(PendingDelta.RemovedItems, PendingRemovedSet);
+	Compact(PendingDelta.RestackedItems, PendingRestackedSet);
+	Compact(PendingDelta.DurabilityChangedItems, PendingDurabilitySet);
+}
+
+// Append an item (or insert it in sorted order) and record its index
+void UInventoryManagerSubsystem::AddItemToStore(UInventoryItemData* Item)
+{
+	const int32 NewIndex = InsertInOrder(Items, Item);
+	ReindexItems(NewIndex, Items.Num() - 1);
+	
+	Item->OnStackSizeChanged.AddUObject(this, &UInventoryManagerSubsystem::HandleItemStackSizeChanged);
+	UpdateOpenStackEntry(Item);
+	SearchIndex.AddItem(Item);
+	InsertInOrder(ItemsByCategory.FindOrAdd(Item->GetItemCategory()), Item);
+	InsertInOrder(ItemsByRarity.FindOrAdd(Item->GetItemRarity()), Item);
+	AdjustAggregates(Item, Item->GetCurrentStackSize());
+}
+
+// Remove the item at an index, keeping the GUID index in sync
+void UInventoryManagerSubsystem::RemoveItemFromStoreAt(int32 Index)
+{
+	check(Items.IsValidIndex(Index));
+	
+	UInventoryItemData* Item = Items[Index];
+	Item->OnStackSizeChanged.RemoveAll(this);
+	RemoveOpenStackEntry(Item);
+	SearchIndex.RemoveItem(Item);
+	
+	// Bucket positions are binary-searched through the GUID index, so this goes before the item leaves it
+	TArray<UInventoryItemData*>& CategoryBucket = ItemsByCategory.FindChecked(Item->GetItemCategory());
+	TArray<UInventoryItemData*>& RarityBucket = ItemsByRarity.FindChecked(Item->GetItemRarity());
+	CategoryBucket.RemoveAt(FindBucketPosition(CategoryBucket, Index), 1, EAllowShrinking::No);
+	RarityBucket.RemoveAt(FindBucketPosition(RarityBucket, Index), 1, EAllowShrinking::No);
+	ItemIndexByGUID.Remove(Item->GetItemGUID());
+	AdjustAggregates(Item, -Item->GetCurrentStackSize());
+	
+	if (bPreserveOrderOnRemove)
+	{
+		// Stable removal - everything after Index shifts down by one
+		Items.RemoveAt(Index, 1, EAllowShrinking::No);
+		ReindexItems(Index, Items.Num() - 1);
+	}
+	else
+	{
+		// O(1) removal - last item moves into the hole
+		const int32 LastIndex = Items.Num() - 1;
+		Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (Items.IsValidIndex(Index))
+		{
+			// Its bucket entries leave the end of their buckets for the position Index falls at
+			UInventoryItemData* MovedItem = Items[Index];
+			MoveBucketEntry(ItemsByCategory.FindChecked(MovedItem->GetItemCategory()), LastIndex, Index, false);
+			MoveBucketEntry(ItemsByRarity.FindChecked(MovedItem->GetItemRarity()), LastIndex, Index, false);
+			ItemIndexByGUID.Add(MovedItem->GetItemGUID(), Index);
+			
+			// The last item jumped forward - listeners patching ordered views can't just drop the removed one
+			PendingDelta.bOrderChanged = true;
+		}
+	}
+}
+
+// Re-write index entries for items that shifted position
+void UInventoryManagerSubsystem::ReindexItems(int32 FirstIndex, int32 LastIndex)
+{
+	for (int32 Index = FirstIndex; Index <= LastIndex; Index++)
+	{
+		ItemIndexByGUID.Add(Items[Index]->GetItemGUID(), Index);
+	}
+}
+
+// Append, or insert at the sorted position
+int32 UInventoryManagerSubsystem::InsertInOrder(TArray<UInventoryItemData*>& List, UInventoryItemData* Item)
+{
+	if (!bKeepSorted)
+	{
+		return List.Add(Item);
+	}
+	
+	// Buckets are Items filtered, so they are sorted by the same keys as Items
+	return List.Insert(Item, Sorter.FindInsertIndex(List, Item));
+}
+
+// Rebuild the store from saved records
+int32 UInventoryManagerSubsystem::RestoreFromSave(const FInventorySaveView& SaveView, bool bRequireAll)
+{
+	// Resolve each definition ID once rather than per record
+	TArray<UInventoryItemDefinition*> Definitions;
+	Definitions.Reserve(SaveView.DefinitionIds.Num());
+	for (int32 Index = 0; Index < SaveView.DefinitionIds.Num(); Index++)
+	{
+		const FName DefinitionId = SaveView.DefinitionIds[Index];
+		UInventoryItemDefinition* Definition = ResolveSavedDefinition(DefinitionId,
+			SaveView.Definitions.IsValidIndex(Index) ? &SaveView.Definitions[Index] : nullptr);
+		if (!Definition)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Saved definition %s is not registered"), *DefinitionId.ToString());
+		}
+		Definitions.Add(Definition);
+	}
+	
+	// Check every record before anything is cleared
+	if (bRequireAll)
+	{
+		TSet<FGuid> SavedGUIDs;
+		SavedGUIDs.Reserve(SaveView.Records.Num());
+		int32 NumUnrestorable = 0;
+		int32 NumInInventory = 0;
+		for (const FInventorySaveRecord& Record : SaveView.Records)
+		{
+			const FGuid ItemGUID = FInventorySaveFormat::UnpackGuid(Record.Guid);
+			bool bDuplicate = false;
+			SavedGUIDs.Add(ItemGUID, &bDuplicate);
+			
+			// Falling back to the default inventory would lose the item's place
+			const FName ContainerName = SaveView.GetContainerName(Record);
+			const bool bHasContainer = ContainerName.IsNone() || Containers.Contains(ContainerName);
+			NumInInventory += ContainerName.IsNone();
+			
+			const bool bHasDefinition = Definitions.IsValidIndex(static_cast<int32>(Record.DefinitionIndex)) && Definitions[Record.DefinitionIndex];
+			NumUnrestorable += !bHasDefinition || !ItemGUID.IsValid() || bDuplicate || !bHasContainer;
+		}
+		
+		if (NumUnrestorable > 0 || NumInInventory > MaxInventorySlots)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: %d of %d saved items can't be restored (%d slots)"),
+				NumUnrestorable, SaveView.Records.Num(), MaxInventorySlots);
+			return INDEX_NONE;
+		}
+	}
+	
+	FInventoryBatchScope BatchScope(this);
+	ClearInventory();
+	
+	// The save holds the named containers' items too - they come back in the slots it recorded
+	for (TPair<FName, FInventoryContainer>& Pair : Containers)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < Pair.Value.Slots.Num() && Pair.Value.NumItems > 0; SlotIndex++)
+		{
+			if (const UInventoryItemData* Item = Pair.Value.Slots[SlotIndex])
+			{
+				RemoveItemFromContainer(Item->GetItemGUID());
+			}
+		}
+	}
+	
+	const int32 NumToRestore = FMath::Min(SaveView.Records.Num(), MaxInventorySlots);
+	Items.Reserve(NumToRestore);
+	ItemIndexByGUID.Reserve(NumToRestore);
+	
+	int32 NumRestored = 0;
+	int32 NumDropped = 0;
+	for (const FInventorySaveRecord& Record : SaveView.Records)
+	{
+		UInventoryItemDefinition* Definition = Definitions.IsValidIndex(static_cast<int32>(Record.DefinitionIndex)) ? Definitions[Record.DefinitionIndex] : nullptr;
+		const FGuid ItemGUID = FInventorySaveFormat::UnpackGuid(Record.Guid);
+		if (!Definition || !ItemGUID.IsValid() || ItemIndexByGUID.Contains(ItemGUID) || ItemLocations.Contains(ItemGUID))
+		{
+			continue;
+		}
+		
+		// Items bound for the default inventory need one of its slots
+		const FName ContainerName = SaveView.GetContainerName(Record);
+		if ((ContainerName.IsNone() || !Containers.Contains(ContainerName)) && !HasRoomForItem())
+		{
+			NumDropped++;
+			continue;
+		}
+		
+		RestoreItem(Definition, ItemGUID, Record.StackCount, Record.Durability, ContainerName, Record.GetSlotIndex(), Record.IsRotated());
+		NumRestored++;
+	}
+	
+	if (NumDropped > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Save has more items than slots, %d were dropped"), NumDropped);
+	}
+	
+	return NumRestored;
+}
+
+// Registered definition, or one rebuilt from save data
+UInventoryItemDefinition* UInventoryManagerSubsystem::ResolveSavedDefinition(FName DefinitionId, const FInventorySavedDefinition* Saved)
+{
+	if (UInventoryItemDefinition* Definition = FindItemDefinition(DefinitionId))
+	{
+		return Definition;
+	}
+	
+	UInventoryItemDefinition* Definition = Saved ? Saved->Rebuild(DefinitionId, GetGameInstance()) : nullptr;
+	if (!Definition || Definition->GetDefinitionId() != DefinitionId || !RegisterItemDefinition(Definition))
+	{
+		return nullptr;
+	}
+	return Definition;
+}
+
+// Recreate a saved item exactly as it was
+UInventoryItemData* UInventoryManagerSubsystem::RestoreItem(UInventoryItemDefinition* Definition, const FGuid& ItemGUID, int32 StackCount, float Durability,
+	FName ContainerName, int32 SlotIndex, bool bRotated)
+{
+	// Saved items are restored exactly as they were - no re-stacking
+	UInventoryItemData* Item = NewObject<UInventoryItemData>(GetGameInstance());
+	Item->InitializeFromDefinition(Definition, StackCount);
+	
+	FInventoryItemInstance Instance;
+	Instance.Definition = Definition;
+	Instance.ItemGUID = ItemGUID;
+	Instance.StackCount = StackCount;
+	Instance.Durability = Durability;
+	Item->ApplyInstance(Instance);
+	
+	if (!ContainerName.IsNone())
+	{
+		// Its saved slot, or any free one if the container has changed since the save
+		FInventoryContainer* Container = Containers.Find(ContainerName);
+		if (Container && !FindContainerPlacement(*Container, Item, SlotIndex, bRotated))
+		{
+			SlotIndex = INDEX_NONE;
+		}
+		
+		if (PlaceInContainer(ContainerName, SlotIndex, Item, bRotated))
+		{
+			JournalContainerAdd(Item);
+			return Item;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Restored %s into the inventory instead of container %s"),
+			*Item->GetItemName().ToString(), *ContainerName.ToString());
+	}
+	
+	AddItemToStore(Item);
+	NotifyItemAdded(Item);
+	
+	return Item;
+}
+
+// Write a full save and start an empty journal on top of it
+bool UInventoryManagerSubsystem::WriteJournalBase()
+{
+	TArray<FInventorySaveContainerItem> ContainerItems;
+	CaptureContainerItems(ContainerItems);
+	
+	FInventorySaveData SaveData;
+	FInventorySaveFormat::BuildSaveData(Items, SaveData, ContainerItems);
+	
+	uint32 SaveCrc = 0;
+	if (!FInventorySaveFormat::WriteToFile(SaveData, JournalSavePath, false, &SaveCrc))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Failed to write journal base save %s"), *JournalSavePath);
+		return false;
+	}
+	
+	// The old journal stays valid until this one replaces it; after that its save CRC no longer matches
+	if (!Journal.Open(JournalSavePath + TEXT(".journal"), SaveCrc))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Failed to create journal for %s"), *JournalSavePath);
+		return false;
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("InventoryManagerSubsystem: Journal compacted into %s (%d items)"), *JournalSavePath, SaveData.Records.Num());
+	return true;
+}
+
+// Apply journal records in order
+bool UInventoryManagerSubsystem::ReplayJournal(TConstArrayView<FInventoryJournal::FEntry> Entries)
+{
+	// Bring back the definitions first, so a missing one stops the replay before it changes anything.
+	// Containers aren't journaled, only their items - each one the journal uses must already exist.
+	for (const FInventoryJournal::FEntry& Entry : Entries)
+	{
+		if (Entry.Op == FInventoryJournal::EOp::Define)
+		{
+			ResolveSavedDefinition(Entry.DefinitionId, &Entry.SavedDefinition);
+		}
+		else if (Entry.Op == FInventoryJournal::EOp::Add && !FindItemDefinition(Entry.DefinitionId))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Journaled definition %s is not registered"), *Entry.DefinitionId.ToString());
+			return false;
+		}
+		else if ((Entry.Op == FInventoryJournal::EOp::MoveToContainer || Entry.Op == FInventoryJournal::EOp::CompactContainer) &&
+			!HasContainer(Entry.ContainerName))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Journaled container %s does not exist"), *Entry.ContainerName.ToString());
+			return false;
+		}
+	}
+	
+	TGuardValue<bool> ReplayGuard(bReplayingJournal, true);
+	FInventoryBatchScope BatchScope(this);
+	
+	for (const FInventoryJournal::FEntry& Entry : Entries)
+	{
+		switch (Entry.Op)
+		{
+		case FInventoryJournal::EOp::Add:
+			{
+				UInventoryItemDefinition* Definition = FindItemDefinition(Entry.DefinitionId);
+				if (!Definition || ItemIndexByGUID.Contains(Entry.ItemGUID) || ItemLocations.Contains(Entry.ItemGUID))
+				{
+					UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Skipping journaled add of %s"), *Entry.DefinitionId.ToString());
+					break;
+				}
+				RestoreItem(Definition, Entry.ItemGUID, Entry.Value, Entry.Durability);
+				break;
+			}
+		case FInventoryJournal::EOp::Remove:
+			{
+				const int32 Index = FindItemIndexByGUID(Entry.ItemGUID);
+				if (Index != INDEX_NONE)
+				{
+					RemoveItemFromStoreAt(Index);
+					NotifyItemRemoved(Entry.ItemGUID);
+				}
+				else
+				{
+					TakeFromContainer(Entry.ItemGUID);
+				}
+				break;
+			}
+		case FInventoryJournal::EOp::SetStack:
+			if (UInventoryItemData* Item = FindItemByGUID(Entry.ItemGUID))
+			{
+				Item->SetStackSize(Entry.Value);
+				NotifyItemStackChanged(Item);
+			}
+			break;
+		case FInventoryJournal::EOp::Move:
+			MoveItem(Entry.ItemGUID, Entry.Value);
+			break;
+		case FInventoryJournal::EOp::Swap:
+			SwapItems(Entry.ItemGUID, Entry.OtherGUID);
+			break;
+		case FInventoryJournal::EOp::Clear:
+			ClearInventory();
+			break;
+		case FInventoryJournal::EOp::SetDurability:
+			SetItemDurability(Entry.ItemGUID, Entry.Durability);
+			break;
+		case FInventoryJournal::EOp::Define:
+			break;
+		case FInventoryJournal::EOp::Sort:
+			SortInventory(Entry.SortCriteria);
+			break;
+		case FInventoryJournal::EOp::MoveToContainer:
+			MoveItemToContainerSlot(Entry.ItemGUID, Entry.ContainerName, Entry.Value, Entry.bRotated);
+			break;
+		case FInventoryJournal::EOp::CompactContainer:
+			CompactGridContainer(Entry.ContainerName);
+			break;
+		}
+	}
+	
+	return true;
+}
+
+// Journal an item placed straight into a named container
+void UInventoryManagerSubsystem::JournalContainerAdd(const UInventoryItemData* Item)
+{
+	const UInventoryItemDefinition* Definition = Item->GetItemDefinition();
+	const FInventoryItemLocation* Location = ItemLocations.Find(Item->GetItemGUID());
+	if (!ShouldJournal() || !Definition || !Location)
+	{
+		return;
+	}
+	
+	// Replay adds to the default inventory, then moves it to the slot it really went to
+	Journal.AppendAdd(Item->GetItemGUID(), *Definition, Item->GetCurrentStackSize(), Item->CurrentDurability);
+	Journal.AppendMoveToContainer(Item->GetItemGUID(), Location->ContainerName, Location->SlotIndex, Location->bRotated);
+	OnJournalRecordAppended();
+}
+
+// Every item in a named container, with its slot
+void UInventoryManagerSubsystem::CaptureContainerItems(TArray<FInventorySaveContainerItem>& OutItems) const
+{
+	OutItems.Reset(ItemLocations.Num());
+	for (const TPair<FName, FInventoryContainer>& Pair : Containers)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < Pair.Value.Slots.Num(); SlotIndex++)
+		{
+			if (const UInventoryItemData* Item = Pair.Value.Slots[SlotIndex])
+			{
+				OutItems.Add({ Item, Pair.Key, SlotIndex, ItemLocations.FindChecked(Item->GetItemGUID()).bRotated });
+			}
+		}
+	}
+}
+
+// Write-through mode flushes as soon as the change is complete
+void UInventoryManagerSubsystem::OnJournalRecordAppended()
+{
+	if (JournalSyncInterval <= 0.0f && BatchDepth == 0)
+	{
+		Journal.Flush(true);
+	}
+}
+
+// Batched fsync + automatic compaction
+bool UInventoryManagerSubsystem::TickJournal(float DeltaTime)
+{
+	if (Journal.HasPendingRecords())
+	{
+		Journal.Flush(true);
+	}
+	
+	if (Journal.GetNumRecords() >= JournalCompactionThreshold)
+	{
+		CompactJournal();
+	}
+	
+	return true;
+}
+
+// Store an item in a named container slot
+bool UInventoryManagerSubsystem::PlaceInContainer(FName ContainerName, int32 SlotIndex, UInventoryItemData* Item, bool bRotated)
+{
+	FInventoryContainer* Container = Containers.Find(ContainerName);
+	if (!Container)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Container %s does not exist"), *ContainerName.ToString());
+		return false;
+	}
+	
+	if (!FindContainerPlacement(*Container, Item, SlotIndex, bRotated))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: No free slot in container %s"), *ContainerName.ToString());
+		return false;
+	}
+	
+	Container->Slots[SlotIndex] = Item;
+	Container->NumItems++;
+	if (Container->IsSpatial())
+	{
+		Container->Grid.Fill(SlotToCell(*Container, SlotIndex), GetPlacedSize(Item, bRotated));
+	}
+	ItemLocations.Add(Item->GetItemGUID(), FInventoryItemLocation{ ContainerName, SlotIndex, bRotated });
+	
+	OnContainerItemAdded.Broadcast(ContainerName, Item, SlotIndex);
+	return true;
+}
+
+// Where an item can go in a container
+bool UInventoryManagerSubsystem::FindContainerPlacement(const FInventoryContainer& Container, const UInventoryItemData* Item, int32& InOutSlotIndex, bool& InOutRotated) const
+{
+	if (!Container.IsSpatial())
+	{
+		InOutRotated = false;
+		if (InOutSlotIndex == INDEX_NONE)
+		{
+			InOutSlotIndex = Container.FindFreeSlot();
+		}
+		return Container.Slots.IsValidIndex(InOutSlotIndex) && !Container.Slots[InOutSlotIndex];
+	}
+	
+	// Grid container - no position given, let the placement engine choose (rotating if that helps)
+	if (InOutSlotIndex == INDEX_NONE)
+	{
+		FIntPoint Position;
+		if (!Container.Grid.FindPlacement(Item->GetGridSize(), true, Container.PlacementMode, Position, InOutRotated))
+		{
+			return false;
+		}
+		InOutSlotIndex = Position.Y * Container.Grid.GetWidth() + Position.X;
+		return true;
+	}
+	
+	return Container.Slots.IsValidIndex(InOutSlotIndex) &&
+		Container.Grid.IsAreaFree(SlotToCell(Container, InOutSlotIndex), GetPlacedSize(Item, InOutRotated));
+}
+
+// Top-left cell of a grid slot
+FIntPoint UInventoryManagerSubsystem::SlotToCell(const FInventoryContainer& Container, int32 SlotIndex)
+{
+	const int32 Width = FMath::Max(1, Container.Grid.GetWidth());
+	return FIntPoint(SlotIndex % Width, SlotIndex / Width);
+}
+
+// Footprint with rotation applied
+FIntPoint UInventoryManagerSubsystem::GetPlacedSize(const UInventoryItemData* Item, bool bRotated)
+{
+	const FIntPoint Size = Item->GetGridSize();
+	return bRotated ? FIntPoint(Size.Y, Size.X) : Size;
+}
+
+// Clear an item's named container slot
+UInventoryItemData* UInventoryManagerSubsystem::TakeFromContainer(const FGuid& ItemGUID)
+{
+	FInventoryItemLocation Location;
+	if (!ItemLocations.RemoveAndCopyValue(ItemGUID, Location))
+	{
+		return nullptr;
+	}
+	
+	FInventoryContainer& Container = Containers.FindChecked(Location.ContainerName);
+	UInventoryItemData* Item = Container.Slots[Location.SlotIndex];
+	Container.Slots[Location.SlotIndex] = nullptr;
+	Container.NumItems--;
+	if (Container.IsSpatial())
+	{
+		Container.Grid.Clear(SlotToCell(Container, Location.SlotIndex), GetPlacedSize(Item, Location.bRotated));
+	}
+	
+	OnContainerItemRemoved.Broadcast(Location.ContainerName, ItemGUID, Location.SlotIndex);
+	return Item;
+}
+
+// Rebuild the category/rarity buckets so they follow the new item order
+void UInventoryManagerSubsystem::RebuildBuckets()
+{
+	for (TPair<EItemCategory, TArray<UInventoryItemData*>>& Bucket : ItemsByCategory)
+	{
+		Bucket.Value.Reset();
+	}
+	for (TPair<EItemRarity, TArray<UInventoryItemData*>>& Bucket : ItemsByRarity)
+	{
+		Bucket.Value.Reset();
+	}
+	
+	for (UInventoryItemData* Item : Items)
+	{
+		ItemsByCategory.FindOrAdd(Item->GetItemCategory()).Add(Item);
+		ItemsByRarity.FindOrAdd(Item->GetItemRarity()).Add(Item);
+	}
+}
+
+// Position of the item at an inventory index within a bucket, by binary search on the GUID index
+int32 UInventoryManagerSubsystem::FindBucketPosition(const TArray<UInventoryItemData*>& Bucket, int32 ItemIndex) const
+{
+	return Algo::LowerBoundBy(Bucket, ItemIndex, [this](const UInventoryItemData* Item)
+	{
+		return ItemIndexByGUID.FindChecked(Item->GetItemGUID());
+	});
+}
+
+// Move one bucket entry so the bucket still follows Items once the item has moved
+void UInventoryManagerSubsystem::MoveBucketEntry(TArray<UInventoryItemData*>& Bucket, int32 OldIndex, int32 NewIndex, bool bShiftsBetween)
+{
+	const int32 OldPosition = FindBucketPosition(Bucket, OldIndex);
+	
+	// Positions are found on the old indices, so moving later leaves out the item itself - and a shifted
+	// item at NewIndex lands before it, where a swap partner would not
+	int32 NewPosition = FindBucketPosition(Bucket, NewIndex);
+	if (NewIndex > OldIndex)
+	{
+		const bool bItemAtNewIndexInBucket = bShiftsBetween && Bucket.IsValidIndex(NewPosition) &&
+			ItemIndexByGUID.FindChecked(Bucket[NewPosition]->GetItemGUID()) == NewIndex;
+		NewPosition += bItemAtNewIndexInBucket ? 0 : -1;
+	}
+	
+	if (NewPosition != OldPosition)
+	{
+		UInventoryItemData* Item = Bucket[OldPosition];
+		Bucket.RemoveAt(OldPosition, 1, EAllowShrinking::No);
+		Bucket.Insert(Item, NewPosition);
+	}
+}
+
+// Keep two buckets in inventory order across a swap of the items at the two indices
+void UInventoryManagerSubsystem::SwapBucketEntries(TArray<UInventoryItemData*>& FirstBucket, TArray<UInventoryItemData*>& SecondBucket,
+	int32 FirstIndex, int32 SecondIndex)
+{
+	if (&FirstBucket == &SecondBucket)
+	{
+		// Nothing else in the bucket moves, so the two just trade places
+		FirstBucket.Swap(FindBucketPosition(FirstBucket, FirstIndex), FindBucketPosition(FirstBucket, SecondIndex));
+		return;
+	}
+	
+	MoveBucketEntry(FirstBucket, FirstIndex, SecondIndex, false);
+	MoveBucketEntry(SecondBucket, SecondIndex, FirstIndex, false);
+}
+
+// Keep an item's open-stack entry in line with its fullness
+void UInventoryManagerSubsystem::UpdateOpenStackEntry(UInventoryItemData* Item)
+{
+	if (!Item->CanStack())
+	{
+		return;
+	}
+	
+	TArray<UInventoryItemData*>& OpenStacks = OpenStacksByKey.FindOrAdd(FInventoryStackKey::ForItem(Item));
+	if (Item->IsStackFull())
+	{
+		OpenStacks.RemoveSingle(Item);
+	}
+	else
+	{
+		OpenStacks.AddUnique(Item);
+	}
+}
+
+// Remove an item from the open-stack index
+void UInventoryManagerSubsystem::RemoveOpenStackEntry(UInventoryItemData* Item)
+{
+	if (!Item->CanStack())
+	{
+		return;
+	}
+	
+	if (TArray<UInventoryItemData*>* OpenStacks = OpenStacksByKey.Find(FInventoryStackKey::ForItem(Item)))
+	{
+		OpenStacks->RemoveSingle(Item);
+	}
+}
+
+// A stored item's stack size changed
+void UInventoryManagerSubsystem::HandleItemStackSizeChanged(UInventoryItemData* Item, int32 OldSize, int32 NewSize)
+{
+	UpdateOpenStackEntry(Item);
+	AdjustAggregates(Item, NewSize - OldSize);
+	
+	// The filter columns hold stack sizes
+	bFilterViewDirty = true;
+	
+	// Catches auto-stacking, partial removals and direct AddToStack calls alike
+	if (ShouldJournal())
+	{
+		Journal.AppendSetStack(Item->GetItemGUID(), NewSize);
+		OnJournalRecordAppended();
+	}
+	
+	if (BatchDepth == 0)
+	{
+		// A direct AddToStack/RemoveFromStack from outside - nothing else will announce it
+		FInventoryBatchScope BatchScope(this);
+		NotifyItemStackChanged(Item);
+	}
+	else
+	{
+		// The subsystem's own paths broadcast once they're done; the delta must carry it either way
+		RecordRestacked(Item->GetItemGUID());
+	}
+}
+
+// Apply a quantity change to the running totals
+void UInventoryManagerSubsystem::AdjustAggregates(const UInventoryItemData* Item, int32 QuantityDelta)
+{
+	if (QuantityDelta == 0)
+	{
+		return;
+	}
+	
+	TotalQuantity += QuantityDelta;
+	TotalWeight += static_cast<double>(Item->Weight) * QuantityDelta;
+	QuantityByCategory.FindOrAdd(Item->GetItemCategory()) += QuantityDelta;
+	
+	// Inside a batch the check waits for EndBatch, so a move or restack doesn't flicker the state
+	if (BatchDepth == 0)
+	{
+		UpdateEncumbrance();
+	}
+}
+
+// Fire the encumbrance event when the limit is crossed
+void UInventoryManagerSubsystem::UpdateEncumbrance()
+{
+	// Float weights can leave a tiny residue once everything is removed
+	if (TotalQuantity == 0)
+	{
+		TotalWeight = 0.0;
+	}
+	
+	const bool bNowOverEncumbered = MaxCarryWeight > 0.0f && TotalWeight > MaxCarryWeight;
+	if (bNowOverEncumbered != bOverEncumbered)
+	{
+		bOverEncumbered = bNowOverEncumbered;
+		OnEncumbranceChanged.Broadcast(bOverEncumbered, GetTotalWeight());
+	}
+}
+
+// Validate that an item is acceptable to add to inventory
+bool UInventoryManagerSubsystem::IsItemValid(UInventoryItemData* Item) const
+{
+	if (!Item)
+	{
+		return false;
+	}
+	
+	// Check if GUID is valid
+	if (!Item->GetItemGUID().IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item has invalid GUID"));
+		return false;
+	}
+	
+	// Check the item isn't already in the store (would corrupt the GUID indices)
+	if (ItemIndexByGUID.Contains(Item->GetItemGUID()) || ItemLocations.Contains(Item->GetItemGUID()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryManagerSubsystem: Item is already in the inventory"));
 		return false;
 	}
 	
@@ -0,0 +1,258 @@
+// InventoryQuery.cpp
+
+#include "Core/InventoryQuery.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+// ----------------------------------------
+// Predicate
+// ----------------------------------------
+
+FInventoryItemPredicate::FInventoryItemPredicate()
+	: Test([](const UInventoryItemData&) { return true; })
+{
+}
+
+FInventoryItemPredicate::FInventoryItemPredicate(TFunction<bool(const UInventoryItemData&)>&& InTest, bool bInUsesName)
+	: Test(MoveTemp(InTest))
+	, bUsesName(bInUsesName)
+{
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::Category(EItemCategory InCategory)
+{
+	return FInventoryItemPredicate([InCategory](const UInventoryItemData& Item)
+	{
+		return Item.GetItemCategory() == InCategory;
+	}, false);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::RarityBetween(EItemRarity Min, EItemRarity Max)
+{
+	return FInventoryItemPredicate([Min, Max](const UInventoryItemData& Item)
+	{
+		return Item.GetItemRarity() >= Min && Item.GetItemRarity() <= Max;
+	}, false);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::StatAtLeast(EInventoryItemStat Stat, float Value)
+{
+	return FInventoryItemPredicate([Stat, Value](const UInventoryItemData& Item)
+	{
+		return GetStat(Item, Stat) >= Value;
+	}, false);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::StatAtMost(EInventoryItemStat Stat, float Value)
+{
+	return FInventoryItemPredicate([Stat, Value](const UInventoryItemData& Item)
+	{
+		return GetStat(Item, Stat) <= Value;
+	}, false);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::NameContains(const FString& SearchText)
+{
+	return FInventoryItemPredicate([NormalizedSearch = SearchText.ToLower()](const UInventoryItemData& Item)
+	{
+		return Item.GetNormalizedName().Contains(NormalizedSearch, ESearchCase::CaseSensitive);
+	}, true);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::Custom(TFunction<bool(const UInventoryItemData&)> InTest)
+{
+	// Unknown - assume it might read names
+	return FInventoryItemPredicate(MoveTemp(InTest), true);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::operator&&(const FInventoryItemPredicate& Other) const
+{
+	return FInventoryItemPredicate([A = Test, B = Other.Test](const UInventoryItemData& Item)
+	{
+		return A(Item) && B(Item);
+	}, bUsesName || Other.bUsesName);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::operator||(const FInventoryItemPredicate& Other) const
+{
+	return FInventoryItemPredicate([A = Test, B = Other.Test](const UInventoryItemData& Item)
+	{
+		return A(Item) || B(Item);
+	}, bUsesName || Other.bUsesName);
+}
+
+FInventoryItemPredicate FInventoryItemPredicate::operator!() const
+{
+	return FInventoryItemPredicate([A = Test](const UInventoryItemData& Item)
+	{
+		return !A(Item);
+	}, bUsesName);
+}
+
+float FInventoryItemPredicate::GetStat(const UInventoryItemData& Item, EInventoryItemStat Stat)
+{
+	switch (Stat)
+	{
+		case EInventoryItemStat::StackSize:
+			return static_cast<float>(Item.GetCurrentStackSize());
+		case EInventoryItemStat::MinDamage:
+			return Item.MinDamage;
+		case EInventoryItemStat::MaxDamage:
+			return Item.MaxDamage;
+		case EInventoryItemStat::AttackSpeed:
+			return Item.AttackSpeed;
+		case EInventoryItemStat::Durability:
+			return Item.CurrentDurability;
+		case EInventoryItemStat::Weight:
+			return Item.Weight;
+		default:
+			return 0.0f;
+	}
+}
+
+// ----------------------------------------
+// Parallel scan
+// ----------------------------------------
+
+namespace
+{
+	/** Prepare the items for a scan and run Body(ChunkIndex, Begin, End) over each chunk */
+	template<typename BodyType>
+	void ForEachChunk(TConstArrayView<UInventoryItemData*> Items, const FInventoryItemPredicate& Predicate,
+		const FInventoryQueryOptions& Options, int32 NumChunks, BodyType&& Body)
+	{
+		// Names are normalized on first use - do that here rather than racing on the workers
+		if (Predicate.UsesName() && Options.bWarmNameCaches)
+		{
+			for (const UInventoryItemData* Item : Items)
+			{
+				if (Item)
+				{
+					Item->GetNormalizedName();
+				}
+			}
+		}
+
+		const int32 ChunkSize = FMath::DivideAndRoundUp(Items.Num(), NumChunks);
+		auto RunChunk = [&Body, ChunkSize, NumItems = Items.Num()](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * ChunkSize;
+			Body(ChunkIndex, Begin, FMath::Min(Begin + ChunkSize, NumItems));
+		};
+
+		if (Options.bSingleThreaded || Options.MaxThreads <= 0 || Options.MaxThreads >= NumChunks)
+		{
+			ParallelFor(NumChunks, RunChunk, Options.bSingleThreaded ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+			return;
+		}
+
+		// Capped: one task per allowed thread, each pulling the next chunk until none are left
+		std::atomic<int32> NextChunk{ 0 };
+		ParallelFor(Options.MaxThreads, [&RunChunk, &NextChunk, NumChunks](int32)
+		{
+			for (int32 ChunkIndex = NextChunk++; ChunkIndex < NumChunks; ChunkIndex = NextChunk++)
+			{
+				RunChunk(ChunkIndex);
+			}
+		});
+	}
+}
+
+int32 FInventoryQuery::GetNumChunks(int32 NumItems, const FInventoryQueryOptions& Options)
+{
+	if (NumItems <= 0)
+	{
+		return 0;
+	}
+
+	const int32 MinItemsPerChunk = FMath::Max(1, Options.MinItemsPerChunk);
+	if (NumItems <= MinItemsPerChunk)
+	{
+		return 1;
+	}
+
+	// A few chunks per thread so one slow chunk doesn't hold up the rest
+	const int32 MaxChunks = (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) * 4;
+	return FMath::Clamp(FMath::DivideAndRoundUp(NumItems, MinItemsPerChunk), 1, MaxChunks);
+}
+
+void FInventoryQuery::FindItems(TConstArrayView<UInventoryItemData*> Items, const FInventoryItemPredicate& Predicate,
+	TArray<UInventoryItemData*>& OutMatches, const FInventoryQueryOptions& Options)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryQuery::FindItems);
+
+	OutMatches.Reset();
+
+	const int32 NumChunks = GetNumChunks(Items.Num(), Options);
+	if (NumChunks == 0)
+	{
+		return;
+	}
+
+	TArray<TArray<UInventoryItemData*>> ChunkMatches;
+	ChunkMatches.SetNum(NumChunks);
+
+	ForEachChunk(Items, Predicate, Options, NumChunks, [&Items, &Predicate, &ChunkMatches](int32 ChunkIndex, int32 Begin, int32 End)
+	{
+		TArray<UInventoryItemData*>& Matches = ChunkMatches[ChunkIndex];
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			UInventoryItemData* Item = Items[Index];
+			if (Item && Predicate.Matches(*Item))
+			{
+				Matches.Add(Item);
+			}
+		}
+	});
+
+	// Chunks are contiguous ranges, so joining them in order keeps the input order
+	int32 NumMatches = 0;
+	for (const TArray<UInventoryItemData*>& Matches : ChunkMatches)
+	{
+		NumMatches += Matches.Num();
+	}
+
+	OutMatches.Reserve(NumMatches);
+	for (const TArray<UInventoryItemData*>& Matches : ChunkMatches)
+	{
+		OutMatches.Append(Matches);
+	}
+}
+
+int64 FInventoryQuery::SumQuantity(TConstArrayView<UInventoryItemData*> Items, const FInventoryItemPredicate& Predicate,
+	const FInventoryQueryOptions& Options)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FInventoryQuery::SumQuantity);
+
+	const int32 NumChunks = GetNumChunks(Items.Num(), Options);
+	if (NumChunks == 0)
+	{
+		return 0;
+	}
+
+	TArray<int64> ChunkTotals;
+	ChunkTotals.SetNumZeroed(NumChunks);
+
+	ForEachChunk(Items, Predicate, Options, NumChunks, [&Items, &Predicate, &ChunkTotals](int32 ChunkIndex, int32 Begin, int32 End)
+	{
+		int64 Total = 0;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const UInventoryItemData* Item = Items[Index];
+			if (Item && Predicate.Matches(*Item))
+			{
+				Total += Item->GetCurrentStackSize();
+			}
+		}
+		ChunkTotals[ChunkIndex] = Total;
+	});
+
+	int64 Total = 0;
+	for (const int64 ChunkTotal : ChunkTotals)
+	{
+		Total += ChunkTotal;
+	}
+	return Total;
+}
@@ -0,0 +1,558 @@
+// InventoryReplicationComponent.cpp
+
+#include "Core/InventoryReplicationComponent.h"
+#include "Core/InventoryManagerSubsystem.h"
+#include "Core/InventoryItemData.h"
+#include "Engine/GameInstance.h"
+#include "Net/UnrealNetwork.h"
+
+namespace
+{
+	/** GUID -> (stack, durability) for every item, to tell whether a reconcile changed anything */
+	TMap<FGuid, TTuple<int32, float>> CaptureItemState(const UInventoryManagerSubsystem& Manager)
+	{
+		TMap<FGuid, TTuple<int32, float>> State;
+		State.Reserve(Manager.GetItemCount());
+		for (const UInventoryItemData* Item : Manager.GetItems())
+		{
+			if (Item)
+			{
+				State.Add(Item->GetItemGUID(), MakeTuple(Item->GetCurrentStackSize(), Item->CurrentDurability));
+			}
+		}
+		return State;
+	}
+}
+
+// ----------------------------------------
+// Fast array callbacks (client)
+// ----------------------------------------
+
+void FInventoryReplicatedEntry::PreReplicatedRemove(const FInventoryReplicatedList& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->HandleEntryRemoved(*this);
+	}
+}
+
+void FInventoryReplicatedEntry::PostReplicatedAdd(const FInventoryReplicatedList& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->HandleEntryAdded(*this);
+	}
+}
+
+void FInventoryReplicatedEntry::PostReplicatedChange(const FInventoryReplicatedList& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->HandleEntryChanged(*this);
+	}
+}
+
+void FInventoryReplicatedList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (Owner)
+	{
+		Owner->HandleReceiveFinished();
+	}
+}
+
+// ----------------------------------------
+// Component
+// ----------------------------------------
+
+UInventoryReplicationComponent::UInventoryReplicationComponent()
+{
+	// Ticks only to flush queued commands, after gameplay has queued this frame's
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+	SetIsReplicatedByDefault(true);
+
+	ReplicatedItems.Owner = this;
+}
+
+void UInventoryReplicationComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(UInventoryReplicationComponent, ReplicatedItems, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UInventoryReplicationComponent, LastAppliedCommand, COND_OwnerOnly);
+}
+
+void UInventoryReplicationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!Manager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryReplicationComponent: No InventoryManagerSubsystem to replicate"));
+		return;
+	}
+
+	Manager->OnInventoryBatchChanged.AddDynamic(this, &UInventoryReplicationComponent::HandleInventoryBatchChanged);
+	BoundManager = Manager;
+	ResyncFromInventory();
+}
+
+void UInventoryReplicationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UInventoryManagerSubsystem* Manager = BoundManager.Get())
+	{
+		Manager->OnInventoryBatchChanged.RemoveDynamic(this, &UInventoryReplicationComponent::HandleInventoryBatchChanged);
+	}
+	BoundManager.Reset();
+
+	// An update cut short still needs its batch closed
+	HandleReceiveFinished();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInventoryReplicationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Everything queued since the last tick goes out together
+	while (NumUnsentCommands > 0)
+	{
+		const int32 NumToSend = FMath::Min(NumUnsentCommands, MaxCommandsPerBatch);
+		const int32 FirstToSend = PendingCommands.Num() - NumUnsentCommands;
+
+		ServerApplyCommands(TArray<FInventoryCommand>(PendingCommands.GetData() + FirstToSend, NumToSend));
+		NumUnsentCommands -= NumToSend;
+		++CommandStats.RPCsSent;
+	}
+
+	SetComponentTickEnabled(false);
+}
+
+UInventoryManagerSubsystem* UInventoryReplicationComponent::GetInventoryManager() const
+{
+	const UWorld* World = GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UInventoryManagerSubsystem>() : nullptr;
+}
+
+// ----------------------------------------
+// Commands
+// ----------------------------------------
+
+FGuid UInventoryReplicationComponent::QueueAddItem(UInventoryItemDefinition* Definition, int32 Quantity)
+{
+	const FInventoryCommand Command = FInventoryCommand::MakeAdd(Definition, Quantity);
+	return QueueCommand(Command) ? Command.ItemGUID : FGuid();
+}
+
+bool UInventoryReplicationComponent::QueueRemoveItem(FGuid ItemGUID)
+{
+	return QueueCommand(FInventoryCommand::MakeRemove(ItemGUID));
+}
+
+bool UInventoryReplicationComponent::QueueRemoveItemQuantity(FGuid ItemGUID, int32 Quantity)
+{
+	return QueueCommand(FInventoryCommand::MakeRemoveQuantity(ItemGUID, Quantity));
+}
+
+bool UInventoryReplicationComponent::QueueCommand(FInventoryCommand Command)
+{
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!Manager || !GetOwner())
+	{
+		return false;
+	}
+
+	// The server's own changes replicate through the batch event - no round trip
+	if (GetOwner()->HasAuthority())
+	{
+		return Command.Apply(*Manager);
+	}
+
+	// Predict - a command that fails here would only be rejected by the server
+	if (!Command.Apply(*Manager))
+	{
+		return false;
+	}
+
+	Command.Sequence = ++LastQueuedCommand;
+	PendingCommands.Add(MoveTemp(Command));
+	++NumUnsentCommands;
+	++CommandStats.CommandsQueued;
+
+	SetComponentTickEnabled(true);
+	return true;
+}
+
+// ----------------------------------------
+// Server
+// ----------------------------------------
+
+void UInventoryReplicationComponent::ResyncFromInventory()
+{
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!Manager || !GetOwner() || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	ReplicatedItems.Entries.Reset();
+	EntryIndexByGUID.Reset();
+	ReplicatedItems.MarkArrayDirty();
+
+	for (const UInventoryItemData* Item : Manager->GetItems())
+	{
+		AddEntry(Item);
+	}
+}
+
+void UInventoryReplicationComponent::HandleInventoryBatchChanged(const FInventoryChangeDelta& Delta)
+{
+	UInventoryManagerSubsystem* Manager = BoundManager.Get();
+	if (!Manager)
+	{
+		return;
+	}
+
+	for (const FGuid& ItemGUID : Delta.RemovedItems)
+	{
+		RemoveEntry(ItemGUID);
+	}
+
+	for (const FGuid& ItemGUID : Delta.AddedItems)
+	{
+		if (const UInventoryItemData* Item = Manager->FindItemByGUID(ItemGUID))
+		{
+			AddEntry(Item);
+		}
+	}
+
+	for (const FGuid& ItemGUID : Delta.RestackedItems)
+	{
+		UpdateEntry(Manager->FindItemByGUID(ItemGUID));
+	}
+
+	for (const FGuid& ItemGUID : Delta.DurabilityChangedItems)
+	{
+		UpdateEntry(Manager->FindItemByGUID(ItemGUID));
+	}
+}
+
+void UInventoryReplicationComponent::AddEntry(const UInventoryItemData* Item)
+{
+	if (!Item)
+	{
+		return;
+	}
+
+	if (!Item->GetItemDefinition())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryReplicationComponent: %s has no definition and won't replicate"), *Item->GetItemName().ToString());
+		return;
+	}
+
+	if (EntryIndexByGUID.Contains(Item->GetItemGUID()))
+	{
+		UpdateEntry(Item);
+		return;
+	}
+
+	FInventoryReplicatedEntry& Entry = ReplicatedItems.Entries.AddDefaulted_GetRef();
+	Entry.Instance = Item->ToInstance();
+	EntryIndexByGUID.Add(Item->GetItemGUID(), ReplicatedItems.Entries.Num() - 1);
+	ReplicatedItems.MarkItemDirty(Entry);
+}
+
+void UInventoryReplicationComponent::RemoveEntry(const FGuid& ItemGUID)
+{
+	int32 Index = INDEX_NONE;
+	if (!EntryIndexByGUID.RemoveAndCopyValue(ItemGUID, Index))
+	{
+		return;
+	}
+
+	// Entries are matched by replication ID, not position, so a swap-remove is safe
+	ReplicatedItems.Entries.RemoveAtSwap(Index);
+	if (ReplicatedItems.Entries.IsValidIndex(Index))
+	{
+		EntryIndexByGUID.Add(ReplicatedItems.Entries[Index].Instance.ItemGUID, Index);
+	}
+	ReplicatedItems.MarkArrayDirty();
+}
+
+void UInventoryReplicationComponent::ServerApplyCommands_Implementation(const TArray<FInventoryCommand>& Commands)
+{
+	if (Commands.Num() == 0)
+	{
+		return;
+	}
+
+	// Acked even when rejected - the client then drops its prediction
+	LastAppliedCommand = FMath::Max(LastAppliedCommand, Commands.Last().Sequence);
+
+	UInventoryManagerSubsystem* Manager = BoundManager.Get();
+	if (!Manager)
+	{
+		return;
+	}
+
+	if (Commands.Num() > MaxCommandsPerBatch || !ValidateCommands(*Manager, Commands))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("InventoryReplicationComponent: Rejected a batch of %d commands from %s"),
+			Commands.Num(), *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	// One transaction: a single delta, so a single replication update
+	FInventoryBatchScope BatchScope(Manager);
+	for (const FInventoryCommand& Command : Commands)
+	{
+		if (!Command.Apply(*Manager))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InventoryReplicationComponent: Command %u failed after validation"), Command.Sequence);
+		}
+	}
+}
+
+bool UInventoryReplicationComponent::ValidateCommand(const FInventoryCommand& Command) const
+{
+	// Nothing here knows an added item's source or whose an item is - every player's component
+	// shares one inventory, so a client could otherwise add anything and remove anyone's items
+	return false;
+}
+
+bool UInventoryReplicationComponent::ValidateCommands(UInventoryManagerSubsystem& Manager, const TArray<FInventoryCommand>& Commands) const
+{
+	// Stack sizes as the batch leaves them (0 = not in the inventory), read from the inventory on first use.
+	// Auto-stacking isn't modelled, so a batch relying on an add merging into another stack is rejected.
+	TMap<FGuid, int32> StackSizes;
+
+	for (const FInventoryCommand& Command : Commands)
+	{
+		if (!Command.ItemGUID.IsValid() || !ValidateCommand(Command))
+		{
+			return false;
+		}
+
+		int32* StackSize = StackSizes.Find(Command.ItemGUID);
+		if (!StackSize)
+		{
+			const UInventoryItemData* Item = Manager.FindItemByGUID(Command.ItemGUID);
+			StackSize = &StackSizes.Add(Command.ItemGUID, Item ? Item->GetCurrentStackSize() : 0);
+		}
+
+		switch (Command.Op)
+		{
+			case EInventoryCommandOp::Add:
+				if (!Command.Definition || Command.Quantity < 1 || *StackSize > 0)
+				{
+					return false;
+				}
+				*StackSize = Command.Definition->bIsStackable ? FMath::Min(Command.Quantity, FMath::Max(1, Command.Definition->MaxStackSize)) : 1;
+				break;
+
+			case EInventoryCommandOp::Remove:
+				if (*StackSize <= 0)
+				{
+					return false;
+				}
+				*StackSize = 0;
+				break;
+
+			case EInventoryCommandOp::RemoveQuantity:
+				if (Command.Quantity < 1 || Command.Quantity > *StackSize)
+				{
+					return false;
+				}
+				*StackSize -= Command.Quantity;
+				break;
+
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
+
+void UInventoryReplicationComponent::UpdateEntry(const UInventoryItemData* Item)
+{
+	const int32* Index = Item ? EntryIndexByGUID.Find(Item->GetItemGUID()) : nullptr;
+	if (!Index)
+	{
+		return;
+	}
+
+	FInventoryReplicatedEntry& Entry = ReplicatedItems.Entries[*Index];
+	if (Entry.Instance.StackCount != Item->GetCurrentStackSize() || Entry.Instance.Durability != Item->CurrentDurability)
+	{
+		Entry.Instance.StackCount = Item->GetCurrentStackSize();
+		Entry.Instance.Durability = Item->CurrentDurability;
+		ReplicatedItems.MarkItemDirty(Entry);
+	}
+}
+
+// ----------------------------------------
+// Client
+// ----------------------------------------
+
+UInventoryManagerSubsystem* UInventoryReplicationComponent::BeginReceive()
+{
+	if (UInventoryManagerSubsystem* Manager = ReceivingManager.Get())
+	{
+		return Manager;
+	}
+
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!Manager)
+	{
+		return nullptr;
+	}
+
+	// One OnInventoryChanged for the whole update
+	Manager->BeginBatch();
+	ReceivingManager = Manager;
+
+	// The server's inventory replaces whatever this client had
+	if (!bReceivedInitialState)
+	{
+		bReceivedInitialState = true;
+		Manager->ClearInventory();
+	}
+
+	return Manager;
+}
+
+void UInventoryReplicationComponent::HandleEntryAdded(const FInventoryReplicatedEntry& Entry)
+{
+	if (UInventoryManagerSubsystem* Manager = BeginReceive())
+	{
+		// Already here if this client predicted the add
+		if (Manager->FindItemByGUID(Entry.Instance.ItemGUID))
+		{
+			Manager->ApplyReplicatedState(Entry.Instance);
+		}
+		else
+		{
+			Manager->ApplyReplicatedAdd(Entry.Instance);
+		}
+	}
+}
+
+void UInventoryReplicationComponent::HandleEntryChanged(const FInventoryReplicatedEntry& Entry)
+{
+	if (UInventoryManagerSubsystem* Manager = BeginReceive())
+	{
+		Manager->ApplyReplicatedState(Entry.Instance);
+	}
+}
+
+void UInventoryReplicationComponent::HandleEntryRemoved(const FInventoryReplicatedEntry& Entry)
+{
+	if (UInventoryManagerSubsystem* Manager = BeginReceive())
+	{
+		Manager->ApplyReplicatedRemove(Entry.Instance.ItemGUID);
+	}
+}
+
+void UInventoryReplicationComponent::HandleReceiveFinished()
+{
+	if (UInventoryManagerSubsystem* Manager = ReceivingManager.Get())
+	{
+		// The update overwrote predicted values - put them back before anything redraws
+		if (PendingCommands.Num() > 0 || LastAppliedCommand != ReconciledCommand)
+		{
+			Reconcile(*Manager);
+		}
+
+		ReceivingManager.Reset();
+		Manager->EndBatch();
+	}
+}
+
+void UInventoryReplicationComponent::OnRep_LastAppliedCommand()
+{
+	// Usually already handled with the list update it arrived with
+	if (LastAppliedCommand == ReconciledCommand)
+	{
+		return;
+	}
+
+	if (UInventoryManagerSubsystem* Manager = GetInventoryManager())
+	{
+		FInventoryBatchScope BatchScope(Manager);
+		Reconcile(*Manager);
+	}
+}
+
+void UInventoryReplicationComponent::Reconcile(UInventoryManagerSubsystem& Manager)
+{
+	// Unsent commands are always newer than the ack, so this only drops sent ones
+	int32 NumAcked = PendingCommands.IndexByPredicate([this](const FInventoryCommand& Command)
+	{
+		return Command.Sequence > LastAppliedCommand;
+	});
+	if (NumAcked == INDEX_NONE)
+	{
+		NumAcked = PendingCommands.Num();
+	}
+	PendingCommands.RemoveAt(0, NumAcked, EAllowShrinking::No);
+	CommandStats.CommandsAcknowledged += NumAcked;
+	ReconciledCommand = LastAppliedCommand;
+
+	// What the player is currently looking at
+	const TMap<FGuid, TTuple<int32, float>> PredictedState = CaptureItemState(Manager);
+
+	// Roll back to the server's state...
+	TMap<FGuid, const FInventoryItemInstance*> AuthoritativeItems;
+	AuthoritativeItems.Reserve(ReplicatedItems.Entries.Num());
+	for (const FInventoryReplicatedEntry& Entry : ReplicatedItems.Entries)
+	{
+		AuthoritativeItems.Add(Entry.Instance.ItemGUID, &Entry.Instance);
+	}
+
+	TArray<FGuid> StaleItems;
+	for (const UInventoryItemData* Item : Manager.GetItems())
+	{
+		if (Item && !AuthoritativeItems.Contains(Item->GetItemGUID()))
+		{
+			StaleItems.Add(Item->GetItemGUID());
+		}
+	}
+	for (const FGuid& ItemGUID : StaleItems)
+	{
+		Manager.ApplyReplicatedRemove(ItemGUID);
+	}
+
+	for (const TPair<FGuid, const FInventoryItemInstance*>& Pair : AuthoritativeItems)
+	{
+		if (Manager.FindItemByGUID(Pair.Key))
+		{
+			Manager.ApplyReplicatedState(*Pair.Value);
+		}
+		else
+		{
+			Manager.ApplyReplicatedAdd(*Pair.Value);
+		}
+	}
+
+	// ...then replay what the server hasn't seen yet. One that no longer applies stays
+	// queued - the server rejects it and the next reconcile settles it.
+	for (const FInventoryCommand& Command : PendingCommands)
+	{
+		Command.Apply(Manager);
+	}
+
+	if (NumAcked > 0 && !CaptureItemState(Manager).OrderIndependentCompareEqual(PredictedState))
+	{
+		++CommandStats.Corrections;
+	}
+}
@@ -0,0 +1,432 @@
+// InventorySaveFormat.cpp
+
+#include "Core/InventorySaveFormat.h"
+#include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/SoftObjectPath.h"
+
+// Records are copied to and from disk as raw memory
+static_assert(PLATFORM_LITTLE_ENDIAN, "Inventory save format assumes a little-endian platform");
+
+void FInventorySaveFormat::PackGuid(const FGuid& Guid, uint32 OutGuid[4])
+{
+	OutGuid[0] = Guid.A;
+	OutGuid[1] = Guid.B;
+	OutGuid[2] = Guid.C;
+	OutGuid[3] = Guid.D;
+}
+
+FGuid FInventorySaveFormat::UnpackGuid(const uint32 Guid[4])
+{
+	return FGuid(Guid[0], Guid[1], Guid[2], Guid[3]);
+}
+
+FInventorySavedDefinition FInventorySavedDefinition::Capture(const UInventoryItemDefinition& Definition)
+{
+	FInventorySavedDefinition Saved;
+	if (Definition.IsAsset())
+	{
+		Saved.AssetPath = FSoftObjectPath(&Definition).ToString();
+		return Saved;
+	}
+
+	Saved.DisplayName = Definition.DisplayName.ToString();
+	Saved.Description = Definition.Description.ToString();
+	Saved.IconPath = Definition.Icon.ToSoftObjectPath().ToString();
+	Saved.Category = static_cast<uint8>(Definition.Category);
+	Saved.Rarity = static_cast<uint8>(Definition.Rarity);
+	Saved.bIsStackable = Definition.bIsStackable;
+	Saved.MaxStackSize = Definition.MaxStackSize;
+	Saved.GridWidth = Definition.GridWidth;
+	Saved.GridHeight = Definition.GridHeight;
+	Saved.MinDamage = Definition.MinDamage;
+	Saved.MaxDamage = Definition.MaxDamage;
+	Saved.AttackSpeed = Definition.AttackSpeed;
+	Saved.MaxDurability = Definition.MaxDurability;
+	Saved.Weight = Definition.Weight;
+	return Saved;
+}
+
+UInventoryItemDefinition* FInventorySavedDefinition::Rebuild(FName DefinitionId, UObject* Outer) const
+{
+	if (!AssetPath.IsEmpty())
+	{
+		return Cast<UInventoryItemDefinition>(FSoftObjectPath(AssetPath).TryLoad());
+	}
+
+	UInventoryItemDefinition* Definition = NewObject<UInventoryItemDefinition>(Outer);
+	Definition->DefinitionId = DefinitionId;
+	Definition->DisplayName = FText::FromString(DisplayName);
+	Definition->Description = FText::FromString(Description);
+	Definition->Icon = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(IconPath));
+	Definition->Category = static_cast<EItemCategory>(Category);
+	Definition->Rarity = static_cast<EItemRarity>(Rarity);
+	Definition->bIsStackable = bIsStackable;
+	Definition->MaxStackSize = MaxStackSize;
+	Definition->GridWidth = GridWidth;
+	Definition->GridHeight = GridHeight;
+	Definition->MinDamage = MinDamage;
+	Definition->MaxDamage = MaxDamage;
+	Definition->AttackSpeed = AttackSpeed;
+	Definition->MaxDurability = MaxDurability;
+	Definition->Weight = Weight;
+	return Definition;
+}
+
+FArchive& operator<<(FArchive& Ar, FInventorySavedDefinition& Saved)
+{
+	Ar << Saved.AssetPath << Saved.DisplayName << Saved.Description << Saved.IconPath;
+	Ar << Saved.Category << Saved.Rarity << Saved.bIsStackable;
+	Ar << Saved.MaxStackSize << Saved.GridWidth << Saved.GridHeight;
+	Ar << Saved.MinDamage << Saved.MaxDamage << Saved.AttackSpeed << Saved.MaxDurability << Saved.Weight;
+	return Ar;
+}
+
+void FInventorySaveFormat::BuildSaveData(TConstArrayView<UInventoryItemData*> Items, FInventorySaveData& OutData,
+	TConstArrayView<FInventorySaveContainerItem> ContainerItems)
+{
+	OutData.DefinitionIds.Reset();
+	OutData.Definitions.Reset();
+	OutData.ContainerNames.Reset();
+	OutData.Records.Reset(Items.Num() + ContainerItems.Num());
+	OutData.NumSkippedItems = 0;
+
+	// Definition -> table index, so each ID is written once
+	TMap<const UInventoryItemDefinition*, uint32> DefinitionIndices;
+
+	auto AddRecord = [&OutData, &DefinitionIndices](const UInventoryItemData* Item) -> FInventorySaveRecord*
+	{
+		const UInventoryItemDefinition* Definition = Item ? Item->GetItemDefinition() : nullptr;
+		if (!Definition)
+		{
+			// Standalone items have nothing stable to be recreated from
+			OutData.NumSkippedItems++;
+			return nullptr;
+		}
+
+		uint32* DefinitionIndex = DefinitionIndices.Find(Definition);
+		if (!DefinitionIndex)
+		{
+			DefinitionIndex = &DefinitionIndices.Add(Definition, OutData.DefinitionIds.Add(Definition->GetDefinitionId()));
+			OutData.Definitions.Add(FInventorySavedDefinition::Capture(*Definition));
+		}
+
+		FInventorySaveRecord& Record = OutData.Records.AddDefaulted_GetRef();
+		PackGuid(Item->GetItemGUID(), Record.Guid);
+		Record.DefinitionIndex = *DefinitionIndex;
+		Record.StackCount = Item->GetCurrentStackSize();
+		Record.Durability = Item->CurrentDurability;
+		return &Record;
+	};
+
+	for (const UInventoryItemData* Item : Items)
+	{
+		AddRecord(Item);
+	}
+
+	// Container name -> table index + 1, so each name is written once
+	TMap<FName, uint16> ContainerIndices;
+
+	for (const FInventorySaveContainerItem& ContainerItem : ContainerItems)
+	{
+		check(ContainerItem.SlotIndex >= 0 && ContainerItem.SlotIndex < FInventorySaveRecord::MaxContainerSlots);
+
+		FInventorySaveRecord* Record = AddRecord(ContainerItem.Item);
+		if (!Record)
+		{
+			continue;
+		}
+
+		uint16* ContainerIndex = ContainerIndices.Find(ContainerItem.ContainerName);
+		if (!ContainerIndex)
+		{
+			check(OutData.ContainerNames.Num() < MAX_uint16);
+			ContainerIndex = &ContainerIndices.Add(ContainerItem.ContainerName, static_cast<uint16>(OutData.ContainerNames.Add(ContainerItem.ContainerName) + 1));
+		}
+
+		Record->ContainerIndex = *ContainerIndex;
+		Record->ContainerSlot = static_cast<uint16>(ContainerItem.SlotIndex | (ContainerItem.bRotated ? FInventorySaveRecord::RotatedSlotBit : 0));
+	}
+}
+
+void FInventorySaveFormat::Serialize(const FInventorySaveData& Data, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	OutBytes.AddZeroed(sizeof(FInventorySaveHeader));
+
+	FInventorySaveHeader Header;
+	Header.Magic = Magic;
+	Header.Version = CurrentVersion;
+	Header.HeaderSize = sizeof(FInventorySaveHeader);
+	Header.NumDefinitions = Data.DefinitionIds.Num();
+	Header.NumRecords = Data.Records.Num();
+
+	// Length-prefixed UTF-8, shared by the definition and container tables
+	auto AppendName = [&OutBytes](FName Name)
+	{
+		const FTCHARToUTF8 Utf8(*Name.ToString());
+		const uint16 Length = static_cast<uint16>(FMath::Min(Utf8.Length(), static_cast<int32>(MAX_uint16)));
+		OutBytes.Append(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+		OutBytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+	};
+
+	// Definition table
+	Header.DefinitionTableOffset = OutBytes.Num();
+	TArray<uint8> DefinitionBytes;
+	for (int32 Index = 0; Index < Data.DefinitionIds.Num(); Index++)
+	{
+		AppendName(Data.DefinitionIds[Index]);
+
+		DefinitionBytes.Reset();
+		if (Data.Definitions.IsValidIndex(Index))
+		{
+			FMemoryWriter Writer(DefinitionBytes);
+			FInventorySavedDefinition Saved = Data.Definitions[Index];
+			Writer << Saved;
+		}
+		const uint32 DataSize = DefinitionBytes.Num();
+		OutBytes.Append(reinterpret_cast<const uint8*>(&DataSize), sizeof(DataSize));
+		OutBytes.Append(DefinitionBytes);
+	}
+	OutBytes.AddZeroed(Align(OutBytes.Num(), 4) - OutBytes.Num());
+
+	// Container table
+	const uint32 NumContainers = Data.ContainerNames.Num();
+	OutBytes.Append(reinterpret_cast<const uint8*>(&NumContainers), sizeof(NumContainers));
+	for (const FName ContainerName : Data.ContainerNames)
+	{
+		AppendName(ContainerName);
+	}
+	OutBytes.AddZeroed(Align(OutBytes.Num(), 4) - OutBytes.Num());
+
+	// Record table - one block copy
+	Header.RecordTableOffset = OutBytes.Num();
+	OutBytes.Append(reinterpret_cast<const uint8*>(Data.Records.GetData()), Data.Records.Num() * sizeof(FInventorySaveRecord));
+
+	Header.FileSize = OutBytes.Num();
+	Header.PayloadCrc = FCrc::MemCrc32(OutBytes.GetData() + sizeof(FInventorySaveHeader), OutBytes.Num() - sizeof(FInventorySaveHeader));
+	FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(Header));
+}
+
+bool FInventorySaveFormat::Compress(TConstArrayView<uint8> Image, TArray<uint8>& OutBytes)
+{
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Image.Num());
+	OutBytes.SetNumUninitialized(sizeof(FInventoryCompressedHeader) + CompressedSize);
+
+	if (!FCompression::CompressMemory(NAME_Zlib, OutBytes.GetData() + sizeof(FInventoryCompressedHeader), CompressedSize,
+		Image.GetData(), Image.Num()))
+	{
+		OutBytes.Reset();
+		return false;
+	}
+	OutBytes.SetNum(sizeof(FInventoryCompressedHeader) + CompressedSize);
+
+	FInventoryCompressedHeader Header;
+	Header.Magic = CompressedMagic;
+	Header.UncompressedSize = Image.Num();
+	Header.CompressedSize = CompressedSize;
+	FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(Header));
+	return true;
+}
+
+bool FInventorySaveFormat::IsCompressed(TConstArrayView<uint8> Bytes)
+{
+	uint32 FileMagic = 0;
+	if (Bytes.Num() >= static_cast<int32>(sizeof(FileMagic)))
+	{
+		FMemory::Memcpy(&FileMagic, Bytes.GetData(), sizeof(FileMagic));
+	}
+	return FileMagic == CompressedMagic;
+}
+
+bool FInventorySaveFormat::Decompress(TConstArrayView<uint8> Bytes, TArray<uint8>& OutImage)
+{
+	OutImage.Reset();
+
+	if (!IsCompressed(Bytes) || Bytes.Num() < static_cast<int32>(sizeof(FInventoryCompressedHeader)))
+	{
+		return false;
+	}
+
+	FInventoryCompressedHeader Header;
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+	if (static_cast<uint64>(Header.CompressedSize) + sizeof(Header) != static_cast<uint64>(Bytes.Num()) ||
+		Header.UncompressedSize > static_cast<uint32>(MAX_int32))
+	{
+		return false;
+	}
+
+	OutImage.SetNumUninitialized(Header.UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, OutImage.GetData(), OutImage.Num(),
+		Bytes.GetData() + sizeof(Header), Header.CompressedSize))
+	{
+		OutImage.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool FInventorySaveFormat::WriteToFile(const FInventorySaveData& Data, const FString& FilePath, bool bCompress, uint32* OutPayloadCrc)
+{
+	TArray<uint8> Bytes;
+	Serialize(Data, Bytes);
+
+	if (OutPayloadCrc)
+	{
+		*OutPayloadCrc = reinterpret_cast<const FInventorySaveHeader*>(Bytes.GetData())->PayloadCrc;
+	}
+
+	if (bCompress)
+	{
+		TArray<uint8> CompressedBytes;
+		if (!Compress(Bytes, CompressedBytes))
+		{
+			return false;
+		}
+		Bytes = MoveTemp(CompressedBytes);
+	}
+
+	// Write next to the target, then swap it in
+	const FString TempPath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		return false;
+	}
+	return IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+}
+
+bool FInventorySaveFormat::Parse(TConstArrayView<uint8> Bytes, FInventorySaveView& OutView)
+{
+	OutView = FInventorySaveView();
+
+	if (Bytes.Num() < static_cast<int32>(sizeof(FInventorySaveHeader)))
+	{
+		return false;
+	}
+
+	FInventorySaveHeader Header;
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+
+	if (Header.Magic != Magic || Header.Version == 0 || Header.Version > CurrentVersion)
+	{
+		return false;
+	}
+
+	// Bounds checks - everything must lie inside the file
+	const uint64 FileSize = Bytes.Num();
+	const uint64 RecordTableEnd = static_cast<uint64>(Header.RecordTableOffset) + static_cast<uint64>(Header.NumRecords) * sizeof(FInventorySaveRecord);
+	if (Header.HeaderSize < sizeof(FInventorySaveHeader) || Header.FileSize != FileSize ||
+		Header.DefinitionTableOffset < Header.HeaderSize || Header.RecordTableOffset < Header.DefinitionTableOffset ||
+		RecordTableEnd > FileSize || !IsAligned(Header.RecordTableOffset, alignof(FInventorySaveRecord)))
+	{
+		return false;
+	}
+
+	if (FCrc::MemCrc32(Bytes.GetData() + sizeof(FInventorySaveHeader), Bytes.Num() - sizeof(FInventorySaveHeader)) != Header.PayloadCrc)
+	{
+		return false;
+	}
+
+	// Tables sit between the header and the record table
+	uint64 Offset = Header.DefinitionTableOffset;
+	auto ReadName = [&Bytes, &Header, &Offset](FName& OutName)
+	{
+		uint16 Length = 0;
+		if (Offset + sizeof(Length) > Header.RecordTableOffset)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Length, Bytes.GetData() + Offset, sizeof(Length));
+		Offset += sizeof(Length);
+
+		if (Offset + Length > Header.RecordTableOffset)
+		{
+			return false;
+		}
+		const FUTF8ToTCHAR Chars(reinterpret_cast<const UTF8CHAR*>(Bytes.GetData() + Offset), Length);
+		OutName = FName(Chars.Length(), Chars.Get());
+		Offset += Length;
+		return true;
+	};
+
+	// Definition table
+	OutView.DefinitionIds.Reserve(Header.NumDefinitions);
+	if (Header.Version >= 2)
+	{
+		OutView.Definitions.Reserve(Header.NumDefinitions);
+	}
+	for (uint32 Index = 0; Index < Header.NumDefinitions; Index++)
+	{
+		if (!ReadName(OutView.DefinitionIds.AddDefaulted_GetRef()))
+		{
+			return false;
+		}
+
+		if (Header.Version >= 2)
+		{
+			uint32 DataSize = 0;
+			if (Offset + sizeof(DataSize) > Header.RecordTableOffset)
+			{
+				return false;
+			}
+			FMemory::Memcpy(&DataSize, Bytes.GetData() + Offset, sizeof(DataSize));
+			Offset += sizeof(DataSize);
+
+			if (Offset + DataSize > Header.RecordTableOffset)
+			{
+				return false;
+			}
+			FMemoryReaderView Reader(MakeArrayView(Bytes.GetData() + Offset, DataSize));
+			Reader << OutView.Definitions.AddDefaulted_GetRef();
+			if (Reader.IsError())
+			{
+				return false;
+			}
+			Offset += DataSize;
+		}
+	}
+
+	// Container table
+	if (Header.Version >= 3)
+	{
+		Offset = Align(Offset, 4);
+		uint32 NumContainers = 0;
+		if (Offset + sizeof(NumContainers) > Header.RecordTableOffset)
+		{
+			return false;
+		}
+		FMemory::Memcpy(&NumContainers, Bytes.GetData() + Offset, sizeof(NumContainers));
+		Offset += sizeof(NumContainers);
+
+		// Records can't reference more than this; each name takes at least its length prefix
+		if (NumContainers >= MAX_uint16 || Offset + NumContainers * sizeof(uint16) > Header.RecordTableOffset)
+		{
+			return false;
+		}
+		OutView.ContainerNames.Reserve(NumContainers);
+		for (uint32 Index = 0; Index < NumContainers; Index++)
+		{
+			if (!ReadName(OutView.ContainerNames.AddDefaulted_GetRef()))
+			{
+				return false;
+			}
+		}
+	}
+
+	// Records are used in place
+	const uint8* RecordData = Bytes.GetData() + Header.RecordTableOffset;
+	if (!IsAligned(RecordData, alignof(FInventorySaveRecord)))
+	{
+		return false;
+	}
+	OutView.Records = MakeArrayView(reinterpret_cast<const FInventorySaveRecord*>(RecordData), Header.NumRecords);
+	OutView.Version = Header.Version;
+	OutView.PayloadCrc = Header.PayloadCrc;
+	return true;
+}
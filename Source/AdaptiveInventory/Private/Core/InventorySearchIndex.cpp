@@ -0,0 +1,145 @@
+// InventorySearchIndex.cpp
+
+#include "Core/InventorySearchIndex.h"
+#include "Core/InventoryItemData.h"
+
+uint64 FInventorySearchIndex::MakeTrigram(const TCHAR* Chars)
+{
+	// 21 bits per character covers every Unicode code point
+	return (static_cast<uint64>(Chars[0]) << 42) | (static_cast<uint64>(Chars[1]) << 21) | static_cast<uint64>(Chars[2]);
+}
+
+void FInventorySearchIndex::GatherTrigrams(const FString& Text, TSet<uint64>& OutTrigrams)
+{
+	const TCHAR* Chars = *Text;
+	for (int32 Index = 0; Index + 3 <= Text.Len(); Index++)
+	{
+		OutTrigrams.Add(MakeTrigram(Chars + Index));
+	}
+}
+
+void FInventorySearchIndex::AddItem(UInventoryItemData* Item)
+{
+	if (!Item)
+	{
+		return;
+	}
+
+	const FString& Name = Item->GetNormalizedName();
+
+	// Existing name - just join its item set
+	if (const int32* ExistingId = NameToEntry.Find(Name))
+	{
+		NameEntries[*ExistingId].Items.Add(Item);
+		return;
+	}
+
+	// New name - post it under each of its trigrams
+	FNameEntry NewEntry;
+	NewEntry.Name = Name;
+	NewEntry.Items.Add(Item);
+	const int32 NameId = NameEntries.Add(MoveTemp(NewEntry));
+	NameToEntry.Add(Name, NameId);
+
+	TSet<uint64> Trigrams;
+	GatherTrigrams(Name, Trigrams);
+	for (uint64 Trigram : Trigrams)
+	{
+		TrigramPostings.FindOrAdd(Trigram).Add(NameId);
+	}
+}
+
+void FInventorySearchIndex::RemoveItem(UInventoryItemData* Item)
+{
+	if (!Item)
+	{
+		return;
+	}
+
+	const FString& Name = Item->GetNormalizedName();
+	const int32* FoundId = NameToEntry.Find(Name);
+	if (!FoundId)
+	{
+		return;
+	}
+
+	const int32 NameId = *FoundId;
+	FNameEntry& Entry = NameEntries[NameId];
+	Entry.Items.Remove(Item);
+	if (Entry.Items.Num() > 0)
+	{
+		return;
+	}
+
+	// Last item with this name - drop the name and its postings
+	TSet<uint64> Trigrams;
+	GatherTrigrams(Name, Trigrams);
+	for (uint64 Trigram : Trigrams)
+	{
+		if (TArray<int32>* Posting = TrigramPostings.Find(Trigram))
+		{
+			Posting->RemoveSingleSwap(NameId);
+			if (Posting->Num() == 0)
+			{
+				TrigramPostings.Remove(Trigram);
+			}
+		}
+	}
+
+	NameToEntry.Remove(Name);
+	NameEntries.RemoveAt(NameId);
+}
+
+void FInventorySearchIndex::Reset()
+{
+	NameEntries.Empty();
+	NameToEntry.Empty();
+	TrigramPostings.Empty();
+}
+
+void FInventorySearchIndex::Search(const FString& NormalizedQuery, TArray<UInventoryItemData*>& OutItems) const
+{
+	auto AppendMatches = [&OutItems, &NormalizedQuery](const FNameEntry& Entry)
+	{
+		// Query and names are both lower-cased already
+		if (Entry.Name.Contains(NormalizedQuery, ESearchCase::CaseSensitive))
+		{
+			for (UInventoryItemData* Item : Entry.Items)
+			{
+				OutItems.Add(Item);
+			}
+		}
+	};
+
+	// Too short for a trigram - scan distinct names, not items
+	if (NormalizedQuery.Len() < 3)
+	{
+		for (const FNameEntry& Entry : NameEntries)
+		{
+			AppendMatches(Entry);
+		}
+		return;
+	}
+
+	// Every match must appear in each query trigram's posting list - start from the rarest one
+	const TArray<int32>* Candidates = nullptr;
+	const TCHAR* QueryChars = *NormalizedQuery;
+	for (int32 Index = 0; Index + 3 <= NormalizedQuery.Len(); Index++)
+	{
+		const TArray<int32>* Posting = TrigramPostings.Find(MakeTrigram(QueryChars + Index));
+		if (!Posting)
+		{
+			return; // A trigram no name contains - no matches
+		}
+		if (!Candidates || Posting->Num() < Candidates->Num())
+		{
+			Candidates = Posting;
+		}
+	}
+
+	// Verify the survivors with a real substring check (trigram order/adjacency)
+	for (int32 NameId : *Candidates)
+	{
+		AppendMatches(NameEntries[NameId]);
+	}
+}
@@ -0,0 +1,85 @@
+// InventorySnapshot.cpp
+
+#include "Core/InventorySnapshot.h"
+#include "Core/InventoryItemDefinition.h"
+
+FInventorySnapshotItem FInventorySnapshotItem::Capture(const UInventoryItemData& Item)
+{
+	FInventorySnapshotItem Snapshot;
+	Snapshot.ItemGUID = Item.GetItemGUID();
+	Snapshot.DefinitionId = Item.GetItemDefinition() ? Item.GetItemDefinition()->GetDefinitionId() : NAME_None;
+	Snapshot.DisplayName = Item.GetItemName().ToString();
+	Snapshot.NormalizedName = Item.GetNormalizedName();
+	Snapshot.Category = Item.GetItemCategory();
+	Snapshot.Rarity = Item.GetItemRarity();
+	Snapshot.StackSize = Item.GetCurrentStackSize();
+	Snapshot.MaxStackSize = Item.GetMaxStackSize();
+	Snapshot.Durability = Item.CurrentDurability;
+	Snapshot.MaxDurability = Item.MaxDurability;
+	Snapshot.MinDamage = Item.MinDamage;
+	Snapshot.MaxDamage = Item.MaxDamage;
+	Snapshot.AttackSpeed = Item.AttackSpeed;
+	Snapshot.Weight = Item.Weight;
+	return Snapshot;
+}
+
+FInventorySnapshot::FInventorySnapshot(uint64 InVersion, TArray<FInventorySnapshotItemRef>&& InItems)
+	: Version(InVersion)
+	, Items(MoveTemp(InItems))
+{
+	for (const FInventorySnapshotItemRef& Item : Items)
+	{
+		TotalQuantity += Item->StackSize;
+		TotalWeight += static_cast<double>(Item->Weight) * Item->StackSize;
+	}
+}
+
+const FInventorySnapshotItem* FInventorySnapshot::FindItemByGUID(const FGuid& ItemGUID) const
+{
+	const FInventorySnapshotItemRef* Found = Items.FindByPredicate([&ItemGUID](const FInventorySnapshotItemRef& Item)
+	{
+		return Item->ItemGUID == ItemGUID;
+	});
+	return Found ? &Found->Get() : nullptr;
+}
+
+TArray<const FInventorySnapshotItem*> FInventorySnapshot::GetItemsByCategory(EItemCategory Category) const
+{
+	TArray<const FInventorySnapshotItem*> Result;
+	for (const FInventorySnapshotItemRef& Item : Items)
+	{
+		if (Item->Category == Category)
+		{
+			Result.Add(&Item.Get());
+		}
+	}
+	return Result;
+}
+
+TArray<const FInventorySnapshotItem*> FInventorySnapshot::GetItemsByRarity(EItemRarity Rarity) const
+{
+	TArray<const FInventorySnapshotItem*> Result;
+	for (const FInventorySnapshotItemRef& Item : Items)
+	{
+		if (Item->Rarity == Rarity)
+		{
+			Result.Add(&Item.Get());
+		}
+	}
+	return Result;
+}
+
+TArray<const FInventorySnapshotItem*> FInventorySnapshot::SearchItemsByName(const FString& SearchText) const
+{
+	const FString NormalizedSearch = SearchText.ToLower();
+
+	TArray<const FInventorySnapshotItem*> Result;
+	for (const FInventorySnapshotItemRef& Item : Items)
+	{
+		if (NormalizedSearch.IsEmpty() || Item->NormalizedName.Contains(NormalizedSearch, ESearchCase::CaseSensitive))
+		{
+			Result.Add(&Item.Get());
+		}
+	}
+	return Result;
+}
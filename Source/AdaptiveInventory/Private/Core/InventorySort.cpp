@@ -0,0 +1,271 @@
+// InventorySort.cpp
+
+#include "Core/InventorySort.h"
+#include "Core/InventoryItemData.h"
+#include "Algo/Sort.h"
+
+namespace InventorySort
+{
+	static int32 GetKeyBits(EInventorySortKey Key)
+	{
+		switch (Key)
+		{
+		case EInventorySortKey::Rarity:
+		case EInventorySortKey::Category:
+			return 8;
+		default:
+			return 32;
+		}
+	}
+
+	static int32 CompareKeys(const uint64* A, const uint64* B, int32 NumWords)
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			if (A[Word] != B[Word])
+			{
+				return A[Word] < B[Word] ? -1 : 1;
+			}
+		}
+		return 0;
+	}
+}
+
+void FInventorySorter::SetCriteria(TConstArrayView<FInventorySortCriterion> InCriteria)
+{
+	Criteria = InCriteria;
+	Fields.Reset();
+	NumWords = 0;
+
+	// Pack fields from the top bit down; a field that doesn't fit starts the next word
+	int32 BitsLeft = 0;
+	for (const FInventorySortCriterion& Criterion : Criteria)
+	{
+		const int32 Bits = InventorySort::GetKeyBits(Criterion.Key);
+		if (Bits > BitsLeft)
+		{
+			NumWords++;
+			BitsLeft = 64;
+		}
+		BitsLeft -= Bits;
+		Fields.Add({ Criterion.Key, Criterion.bDescending, NumWords - 1, BitsLeft, Bits });
+	}
+}
+
+bool FInventorySorter::UsesStackSize() const
+{
+	return Criteria.ContainsByPredicate([](const FInventorySortCriterion& Criterion)
+	{
+		return Criterion.Key == EInventorySortKey::StackSize;
+	});
+}
+
+uint32 FInventorySorter::FloatToOrderedBits(float Value)
+{
+	// Flip the sign bit of positives and every bit of negatives so unsigned order matches float order
+	const uint32 Bits = FMath::IsNaN(Value) ? 0 : BitCast<uint32>(Value);
+	return (Bits & 0x80000000u) ? ~Bits : (Bits | 0x80000000u);
+}
+
+bool FInventorySorter::UsesName() const
+{
+	return Criteria.ContainsByPredicate([](const FInventorySortCriterion& Criterion)
+	{
+		return Criterion.Key == EInventorySortKey::Name;
+	});
+}
+
+void FInventorySorter::RegisterNames(TConstArrayView<UInventoryItemData*> Items)
+{
+	if (!UsesName())
+	{
+		return;
+	}
+
+	bool bAddedName = false;
+	for (const UInventoryItemData* Item : Items)
+	{
+		if (Item)
+		{
+			bAddedName |= AddName(Item->GetNormalizedName());
+		}
+	}
+
+	// Re-collate only when something new turned up
+	if (bAddedName)
+	{
+		CollateNames();
+	}
+}
+
+bool FInventorySorter::AddName(const FString& NormalizedName)
+{
+	if (NameRanks.Contains(NormalizedName))
+	{
+		return false;
+	}
+	NameRanks.Add(NormalizedName, 0);
+	SortedNames.Add(NormalizedName);
+	return true;
+}
+
+void FInventorySorter::CollateNames()
+{
+	// Normalized names are already lower-cased, so an ordinal compare is a case-insensitive collation
+	Algo::Sort(SortedNames, [](const FString& A, const FString& B)
+	{
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	});
+	for (int32 Index = 0; Index < SortedNames.Num(); Index++)
+	{
+		NameRanks.Add(SortedNames[Index], Index);
+	}
+}
+
+uint32 FInventorySorter::GetNameRank(const FString& NormalizedName) const
+{
+	const uint32* Rank = NameRanks.Find(NormalizedName);
+	return Rank ? *Rank : MAX_uint32;
+}
+
+void FInventorySorter::MakeKey(const UInventoryItemData* Item, uint64* OutWords) const
+{
+	FMemory::Memzero(OutWords, NumWords * sizeof(uint64));
+
+	for (const FField& Field : Fields)
+	{
+		uint64 Value = 0;
+		switch (Field.Key)
+		{
+		case EInventorySortKey::Rarity:
+			Value = static_cast<uint8>(Item->GetItemRarity());
+			break;
+		case EInventorySortKey::Category:
+			Value = static_cast<uint8>(Item->GetItemCategory());
+			break;
+		case EInventorySortKey::Name:
+			Value = GetNameRank(Item->GetNormalizedName());
+			break;
+		case EInventorySortKey::StackSize:
+			Value = static_cast<uint32>(FMath::Max(0, Item->GetCurrentStackSize()));
+			break;
+		case EInventorySortKey::Weight:
+			Value = FloatToOrderedBits(Item->Weight);
+			break;
+		}
+
+		const uint64 Mask = (Field.Bits >= 64) ? ~0ull : ((1ull << Field.Bits) - 1);
+		if (Field.bDescending)
+		{
+			Value = Mask - Value;
+		}
+		OutWords[Field.Word] |= (Value & Mask) << Field.Shift;
+	}
+}
+
+void FInventorySorter::Sort(TConstArrayView<UInventoryItemData*> Items, TArray<int32>& OutOrder)
+{
+	const int32 NumItems = Items.Num();
+	OutOrder.SetNumUninitialized(NumItems);
+	for (int32 Index = 0; Index < NumItems; Index++)
+	{
+		OutOrder[Index] = Index;
+	}
+
+	if (!HasCriteria() || NumItems < 2)
+	{
+		return;
+	}
+
+	RegisterNames(Items);
+
+	// Keys laid out item by item
+	TArray<uint64> Keys;
+	Keys.SetNumUninitialized(NumItems * NumWords);
+	for (int32 Index = 0; Index < NumItems; Index++)
+	{
+		MakeKey(Items[Index], &Keys[Index * NumWords]);
+	}
+
+	// LSD radix: least significant word and byte first. Each pass is a stable counting sort.
+	TArray<int32> Scratch;
+	Scratch.SetNumUninitialized(NumItems);
+	for (int32 Word = NumWords - 1; Word >= 0; Word--)
+	{
+		// Bytes that are identical across every item can't change the order
+		uint64 AllOr = 0;
+		uint64 AllAnd = ~0ull;
+		for (int32 Index = 0; Index < NumItems; Index++)
+		{
+			AllOr |= Keys[Index * NumWords + Word];
+			AllAnd &= Keys[Index * NumWords + Word];
+		}
+		const uint64 VaryingBits = AllOr ^ AllAnd;
+
+		for (int32 Shift = 0; Shift < 64; Shift += 8)
+		{
+			if (((VaryingBits >> Shift) & 0xFF) == 0)
+			{
+				continue;
+			}
+
+			int32 Offsets[256] = {};
+			for (const int32 Index : OutOrder)
+			{
+				Offsets[(Keys[Index * NumWords + Word] >> Shift) & 0xFF]++;
+			}
+
+			int32 Total = 0;
+			for (int32& Offset : Offsets)
+			{
+				const int32 Count = Offset;
+				Offset = Total;
+				Total += Count;
+			}
+
+			for (const int32 Index : OutOrder)
+			{
+				Scratch[Offsets[(Keys[Index * NumWords + Word] >> Shift) & 0xFF]++] = Index;
+			}
+			Swap(OutOrder, Scratch);
+		}
+	}
+}
+
+int32 FInventorySorter::FindInsertIndex(TConstArrayView<UInventoryItemData*> SortedItems, const UInventoryItemData* Item)
+{
+	if (!HasCriteria() || !Item)
+	{
+		return SortedItems.Num();
+	}
+
+	// A new name shifts the ranks, so keys are built per probe rather than cached
+	if (UsesName() && AddName(Item->GetNormalizedName()))
+	{
+		CollateNames();
+	}
+
+	TArray<uint64, TInlineAllocator<4>> ItemKey;
+	TArray<uint64, TInlineAllocator<4>> ProbeKey;
+	ItemKey.SetNumUninitialized(NumWords);
+	ProbeKey.SetNumUninitialized(NumWords);
+	MakeKey(Item, ItemKey.GetData());
+
+	// Upper bound - after every equal item, like a stable sort would place it
+	int32 Low = 0;
+	int32 High = SortedItems.Num();
+	while (Low < High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+		MakeKey(SortedItems[Middle], ProbeKey.GetData());
+		if (InventorySort::CompareKeys(ProbeKey.GetData(), ItemKey.GetData(), NumWords) <= 0)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+	return Low;
+}
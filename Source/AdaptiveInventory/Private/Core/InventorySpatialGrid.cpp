@@ -0,0 +1,216 @@
+// InventorySpatialGrid.cpp
+
+#include "Core/InventorySpatialGrid.h"
+
+void FInventorySpatialGrid::Init(int32 InWidth, int32 InHeight)
+{
+	check(InWidth > 0 && InWidth <= MaxWidth && InHeight > 0);
+
+	Width = InWidth;
+	Height = InHeight;
+	FullRowMask = MakeRowMask(0, Width);
+	Rows.SetNumZeroed(Height);
+}
+
+void FInventorySpatialGrid::Reset()
+{
+	FMemory::Memzero(Rows.GetData(), Rows.Num() * sizeof(uint64));
+}
+
+uint64 FInventorySpatialGrid::MakeRowMask(int32 X, int32 W)
+{
+	const uint64 Run = (W >= 64) ? ~0ull : ((1ull << W) - 1);
+	return Run << X;
+}
+
+bool FInventorySpatialGrid::IsAreaFree(FIntPoint Position, FIntPoint Size) const
+{
+	if (Position.X < 0 || Position.Y < 0 || Size.X <= 0 || Size.Y <= 0 ||
+		Position.X + Size.X > Width || Position.Y + Size.Y > Height)
+	{
+		return false;
+	}
+
+	const uint64 Mask = MakeRowMask(Position.X, Size.X);
+	for (int32 Y = Position.Y; Y < Position.Y + Size.Y; Y++)
+	{
+		if (Rows[Y] & Mask)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FInventorySpatialGrid::Fill(FIntPoint Position, FIntPoint Size)
+{
+	check(Position.X >= 0 && Position.Y >= 0 && Position.X + Size.X <= Width && Position.Y + Size.Y <= Height);
+
+	const uint64 Mask = MakeRowMask(Position.X, Size.X);
+	for (int32 Y = Position.Y; Y < Position.Y + Size.Y; Y++)
+	{
+		Rows[Y] |= Mask;
+	}
+}
+
+void FInventorySpatialGrid::Clear(FIntPoint Position, FIntPoint Size)
+{
+	check(Position.X >= 0 && Position.Y >= 0 && Position.X + Size.X <= Width && Position.Y + Size.Y <= Height);
+
+	const uint64 Mask = MakeRowMask(Position.X, Size.X);
+	for (int32 Y = Position.Y; Y < Position.Y + Size.Y; Y++)
+	{
+		Rows[Y] &= ~Mask;
+	}
+}
+
+int32 FInventorySpatialGrid::GetNumFreeCells() const
+{
+	int32 NumTaken = 0;
+	for (const uint64 Row : Rows)
+	{
+		NumTaken += FMath::CountBits(Row);
+	}
+	return Width * Height - NumTaken;
+}
+
+uint64 FInventorySpatialGrid::FindFreeRunStarts(int32 Y, int32 W, int32 H) const
+{
+	// A column is usable only if it is free on every row the item covers
+	uint64 Taken = 0;
+	for (int32 Row = Y; Row < Y + H; Row++)
+	{
+		Taken |= Rows[Row];
+	}
+	const uint64 Free = ~Taken & FullRowMask;
+
+	// Bit X survives when bits X..X+W-1 are all free. Each step doubles the run length checked,
+	// so a W-wide item takes log2(W) shift-and-ANDs. Bits past the grid edge are zero, so runs
+	// can't spill over the right side.
+	uint64 Starts = Free;
+	int32 RunLength = 1;
+	while (RunLength < W)
+	{
+		const int32 Step = FMath::Min(RunLength, W - RunLength);
+		Starts &= Starts >> Step;
+		RunLength += Step;
+	}
+	return Starts;
+}
+
+bool FInventorySpatialGrid::FindFirstFit(int32 W, int32 H, FIntPoint& OutPosition) const
+{
+	for (int32 Y = 0; Y + H <= Height; Y++)
+	{
+		const uint64 Starts = FindFreeRunStarts(Y, W, H);
+		if (Starts)
+		{
+			OutPosition = FIntPoint(static_cast<int32>(FMath::CountTrailingZeros64(Starts)), Y);
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FInventorySpatialGrid::CalculateContactScore(int32 X, int32 Y, int32 W, int32 H) const
+{
+	const uint64 Mask = MakeRowMask(X, W);
+
+	// Edges above and below: the grid border counts as fully touching
+	int32 Score = (Y == 0) ? W : FMath::CountBits(Rows[Y - 1] & Mask);
+	Score += (Y + H == Height) ? W : FMath::CountBits(Rows[Y + H] & Mask);
+
+	// Edges left and right
+	Score += (X == 0) ? H : 0;
+	Score += (X + W == Width) ? H : 0;
+	for (int32 Row = Y; Row < Y + H; Row++)
+	{
+		if (X > 0)
+		{
+			Score += static_cast<int32>((Rows[Row] >> (X - 1)) & 1);
+		}
+		if (X + W < Width)
+		{
+			Score += static_cast<int32>((Rows[Row] >> (X + W)) & 1);
+		}
+	}
+	return Score;
+}
+
+bool FInventorySpatialGrid::FindBestFit(int32 W, int32 H, FIntPoint& OutPosition, int32& OutScore) const
+{
+	OutScore = -1;
+
+	for (int32 Y = 0; Y + H <= Height; Y++)
+	{
+		uint64 Starts = FindFreeRunStarts(Y, W, H);
+		while (Starts)
+		{
+			const int32 X = static_cast<int32>(FMath::CountTrailingZeros64(Starts));
+			Starts &= Starts - 1;
+
+			// Ties keep the earlier (top-left) spot
+			const int32 Score = CalculateContactScore(X, Y, W, H);
+			if (Score > OutScore)
+			{
+				OutScore = Score;
+				OutPosition = FIntPoint(X, Y);
+			}
+		}
+	}
+	return OutScore >= 0;
+}
+
+bool FInventorySpatialGrid::FindPlacement(FIntPoint Size, bool bAllowRotation, EInventoryPlacementMode Mode, FIntPoint& OutPosition, bool& bOutRotated) const
+{
+	bOutRotated = false;
+	if (Size.X <= 0 || Size.Y <= 0)
+	{
+		return false;
+	}
+
+	const bool bCanRotate = bAllowRotation && Size.X != Size.Y;
+	const bool bFitsUpright = Size.X <= Width && Size.Y <= Height;
+	const bool bFitsRotated = bCanRotate && Size.Y <= Width && Size.X <= Height;
+
+	if (Mode == EInventoryPlacementMode::FirstFit)
+	{
+		FIntPoint UprightPosition;
+		FIntPoint RotatedPosition;
+		const bool bFoundUpright = bFitsUpright && FindFirstFit(Size.X, Size.Y, UprightPosition);
+		const bool bFoundRotated = bFitsRotated && FindFirstFit(Size.Y, Size.X, RotatedPosition);
+
+		// Earliest spot in reading order wins; upright on a tie
+		if (bFoundRotated && (!bFoundUpright || RotatedPosition.Y < UprightPosition.Y ||
+			(RotatedPosition.Y == UprightPosition.Y && RotatedPosition.X < UprightPosition.X)))
+		{
+			OutPosition = RotatedPosition;
+			bOutRotated = true;
+			return true;
+		}
+		OutPosition = UprightPosition;
+		return bFoundUpright;
+	}
+
+	FIntPoint UprightPosition;
+	FIntPoint RotatedPosition;
+	int32 UprightScore = -1;
+	int32 RotatedScore = -1;
+	if (bFitsUpright)
+	{
+		FindBestFit(Size.X, Size.Y, UprightPosition, UprightScore);
+	}
+	if (bFitsRotated)
+	{
+		FindBestFit(Size.Y, Size.X, RotatedPosition, RotatedScore);
+	}
+
+	if (RotatedScore > UprightScore)
+	{
+		OutPosition = RotatedPosition;
+		bOutRotated = true;
+		return true;
+	}
+	OutPosition = UprightPosition;
+	return UprightScore >= 0;
+}
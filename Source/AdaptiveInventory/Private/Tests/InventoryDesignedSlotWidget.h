@@ -0,0 +1,67 @@
+// InventoryDesignedSlotWidget.h
+// A native slot with the widget tree its blueprint would have - the UMG side of the grid paint benchmark
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UI/InventorySlotWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Border.h"
+#include "Components/Image.h"
+#include "Components/Overlay.h"
+#include "Components/OverlaySlot.h"
+#include "Components/TextBlock.h"
+#include "InventoryDesignedSlotWidget.generated.h"
+
+/**
+ * Border around an overlay of icon, rarity bar, stack count and selection highlight, bound to
+ * the slot's BindWidget properties. Built in code so a UMG grid has something to lay out and
+ * paint without a widget blueprint asset. Only used by the automation tests.
+ */
+UCLASS()
+class UInventoryDesignedSlotWidget : public UInventorySlotWidget
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryDesignedSlotWidget(const FObjectInitializer& ObjectInitializer)
+		: Super(ObjectInitializer)
+	{
+	}
+
+	virtual bool Initialize() override
+	{
+		if (!Super::Initialize())
+		{
+			return false;
+		}
+
+		SlotBorder = WidgetTree->ConstructWidget<UBorder>();
+		WidgetTree->RootWidget = SlotBorder;
+
+		UOverlay* Overlay = WidgetTree->ConstructWidget<UOverlay>();
+		SlotBorder->SetContent(Overlay);
+
+		auto AddLayer = [Overlay](UWidget* Widget, EHorizontalAlignment HAlign, EVerticalAlignment VAlign)
+		{
+			UOverlaySlot* Layer = Overlay->AddChildToOverlay(Widget);
+			Layer->SetHorizontalAlignment(HAlign);
+			Layer->SetVerticalAlignment(VAlign);
+		};
+
+		ItemIcon = WidgetTree->ConstructWidget<UImage>();
+		ItemIcon->SetDesiredSizeOverride(FVector2D(56.0f, 56.0f));
+		AddLayer(ItemIcon, HAlign_Center, VAlign_Center);
+
+		RarityBar = WidgetTree->ConstructWidget<UImage>();
+		RarityBar->SetDesiredSizeOverride(FVector2D(80.0f, 4.0f));
+		AddLayer(RarityBar, HAlign_Fill, VAlign_Bottom);
+
+		StackCountText = WidgetTree->ConstructWidget<UTextBlock>();
+		AddLayer(StackCountText, HAlign_Right, VAlign_Bottom);
+
+		SelectionHighlight = WidgetTree->ConstructWidget<UImage>();
+		AddLayer(SelectionHighlight, HAlign_Fill, VAlign_Fill);
+		return true;
+	}
+};
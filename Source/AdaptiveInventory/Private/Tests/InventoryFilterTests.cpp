@@ -0,0 +1,94 @@
+// InventoryFilterTests.cpp
+// Filter expressions: correctness against hand-written filters, freshness and cost
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryFilterStackSizeTest, "AdaptiveInventory.Filter.FollowsStackChanges",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryFilterStackSizeTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	FTestInventory Inventory;
+	UInventoryItemDefinition* Definition = Inventory.AddDefinition(TEXT("Arrow"), EItemCategory::Consumable, EItemRarity::Common, 100);
+
+	UInventoryItemData* Small = Inventory.MakeItem(Definition, 100);
+	UInventoryItemData* Large = Inventory.MakeItem(Definition, 100);
+	Inventory->AddItem(Small);
+	Inventory->AddItem(Large);
+	Small->RemoveFromStack(90);
+
+	TestEqual(TEXT("One stack of 50 or more"), Inventory->FilterItems(TEXT("StackSize >= 50")).Num(), 1);
+
+	// Direct edits, outside any inventory call
+	Small->AddToStack(60);
+	TestEqual(TEXT("Direct AddToStack is seen by the next filter"), Inventory->FilterItems(TEXT("StackSize >= 50")).Num(), 2);
+
+	Large->RemoveFromStack(95);
+	TestEqual(TEXT("Direct RemoveFromStack is seen by the next filter"), Inventory->FilterItems(TEXT("StackSize >= 50")).Num(), 1);
+
+	// And inside a batch, before it flushes
+	{
+		FInventoryBatchScope BatchScope(&*Inventory);
+		Large->SetStackSize(80);
+		TestEqual(TEXT("Stack changes inside an open batch are seen"), Inventory->FilterItems(TEXT("StackSize >= 50")).Num(), 2);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryFilterBenchmarkTest, "AdaptiveInventory.Filter.CompiledVsFilterByPredicate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryFilterBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 50000;
+	constexpr int32 Iterations = 50;
+	const FString Expression = TEXT("Weapon AND Rarity >= Rare AND MinDamage > 20 AND Name CONTAINS 'item 1'");
+
+	FTestInventory Inventory;
+	Inventory.Populate(NumItems);
+	const TArray<UInventoryItemData*> AllItems(Inventory->GetItems());
+
+	// The same filter written the way it was before, one pass per condition
+	auto FilterChained = [&AllItems]()
+	{
+		return AllItems
+			.FilterByPredicate([](const UInventoryItemData* Item) { return Item->GetItemCategory() == EItemCategory::Weapon; })
+			.FilterByPredicate([](const UInventoryItemData* Item) { return Item->GetItemRarity() >= EItemRarity::Rare; })
+			.FilterByPredicate([](const UInventoryItemData* Item) { return Item->MinDamage > 20.0f; })
+			.FilterByPredicate([](const UInventoryItemData* Item) { return Item->GetNormalizedName().Contains(TEXT("item 1")); });
+	};
+
+	const TArray<UInventoryItemData*> Expected = FilterChained();
+	const TArray<UInventoryItemData*> Compiled = Inventory->FilterItems(Expression);
+	TestTrue(TEXT("Some items match"), Expected.Num() > 0);
+	TestTrue(TEXT("Compiled filter returns the same items in the same order"), Compiled == Expected);
+
+	TArray<UInventoryItemData*> Result;
+	const double ChainedSeconds = TimePerCall(Iterations, [&]() { Result = FilterChained(); });
+	const double CompiledSeconds = TimePerCall(Iterations, [&]() { Result = Inventory->FilterItems(Expression); });
+
+	// After a change the first filter also rebuilds the columns
+	UInventoryItemData* First = AllItems[0];
+	const double RebuildSeconds = TimePerCall(Iterations, [&]()
+	{
+		Inventory->SetItemDurability(First->GetItemGUID(), First->CurrentDurability > 50.0f ? 10.0f : 90.0f);
+		Result = Inventory->FilterItems(Expression);
+	});
+
+	AddInfo(FString::Printf(TEXT("%d items, %d matches: chained FilterByPredicate %.3f ms, compiled %.3f ms (%.1fx), compiled after a change %.3f ms"),
+		NumItems, Expected.Num(), ChainedSeconds * 1000.0, CompiledSeconds * 1000.0,
+		ChainedSeconds / FMath::Max(CompiledSeconds, 1e-9), RebuildSeconds * 1000.0));
+
+	TestTrue(TEXT("Compiled evaluation is faster than chained FilterByPredicate"), CompiledSeconds < ChainedSeconds);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,123 @@
+// InventoryItemTests.cpp
+// Shared definitions: identity and per-item cost
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "Core/InventoryBlueprintLibrary.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryDefinitionIdTest, "AdaptiveInventory.Items.DefinitionIdIsExact",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryDefinitionIdTest::RunTest(const FString& Parameters)
+{
+	auto MakeId = [](const TCHAR* Name, const TCHAR* Description)
+	{
+		return UInventoryBlueprintLibrary::MakeItemDefinitionId(FText::FromString(Name), FText::FromString(Description),
+			EItemCategory::Consumable, EItemRarity::Common, 20);
+	};
+
+	const FName Potion = MakeId(TEXT("Potion"), TEXT("Heals 50"));
+	TestTrue(TEXT("Same fields give the same ID"), Potion.IsEqual(MakeId(TEXT("Potion"), TEXT("Heals 50")), ENameCase::CaseSensitive));
+	TestFalse(TEXT("Name case is part of the ID"), Potion == MakeId(TEXT("potion"), TEXT("Heals 50")));
+	TestFalse(TEXT("Description is part of the ID"), Potion == MakeId(TEXT("Potion"), TEXT("Heals 80")));
+	TestFalse(TEXT("Description case is part of the ID"), Potion == MakeId(TEXT("Potion"), TEXT("heals 50")));
+	return true;
+}
+
+namespace InventoryItemTests
+{
+	/** The item object plus the text it allocates itself (shared definition text isn't counted) */
+	int64 GetItemBytes(const UInventoryItemData& Item)
+	{
+		return Item.GetClass()->GetStructureSize() +
+			Item.ItemName.ToString().GetAllocatedSize() + Item.ItemDescription.ToString().GetAllocatedSize();
+	}
+
+	/** Average full GC time with whatever the inventory currently holds */
+	double TimeGarbageCollection()
+	{
+		return InventoryTests::TimePerCall(3, []() { CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true); });
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryDefinitionMemoryTest, "AdaptiveInventory.Items.DefinitionSharingMemory",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryDefinitionMemoryTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+	using namespace InventoryItemTests;
+
+	constexpr int32 NumItems = 10000;
+	constexpr int32 StackSize = 99;
+
+	FTestInventory Inventory;
+	const double BaselineGCSeconds = TimeGarbageCollection();
+
+	// Before definitions: every stack carries its own name and description
+	int64 StandaloneBytes = 0;
+	{
+		FInventoryBatchScope BatchScope(&*Inventory);
+		for (int32 Index = 0; Index < NumItems; Index++)
+		{
+			UInventoryItemData* Item = NewObject<UInventoryItemData>(Inventory.GetGameInstance());
+			Item->ItemName = FText::FromString(TEXT("Iron Ore"));
+			Item->ItemDescription = FText::FromString(TEXT("A crafting material: Iron Ore"));
+			Item->ItemCategory = EItemCategory::Material;
+			Item->bIsStackable = true;
+			Item->MaxStackSize = StackSize;
+			Item->CurrentStackSize = StackSize;
+			Inventory->AddItem(Item);
+			StandaloneBytes += GetItemBytes(*Item);
+		}
+	}
+	const double StandaloneGCSeconds = TimeGarbageCollection();
+	TestEqual(TEXT("Standalone items stored"), Inventory->GetItemCount(), NumItems);
+
+	Inventory->ClearInventory();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	// Definition-backed: the text lives once on the definition
+	UInventoryItemDefinition* IronOre = Inventory.AddDefinition(TEXT("Iron Ore"), EItemCategory::Material, EItemRarity::Common, StackSize);
+	IronOre->Description = FText::FromString(TEXT("A crafting material: Iron Ore"));
+	int64 DefinitionBytes = IronOre->GetClass()->GetStructureSize();
+	int32 NumWithInlineText = 0;
+	{
+		FInventoryBatchScope BatchScope(&*Inventory);
+		for (int32 Index = 0; Index < NumItems; Index++)
+		{
+			UInventoryItemData* Item = Inventory.MakeItem(IronOre, StackSize);
+			Inventory->AddItem(Item);
+			DefinitionBytes += GetItemBytes(*Item);
+			NumWithInlineText += !Item->ItemName.IsEmpty() || !Item->ItemDescription.IsEmpty();
+		}
+	}
+	const double DefinitionGCSeconds = TimeGarbageCollection();
+	TestEqual(TEXT("Definition-backed items stored"), Inventory->GetItemCount(), NumItems);
+	TestEqual(TEXT("Definition-backed items carry no text of their own"), NumWithInlineText, 0);
+	TestTrue(TEXT("Items read their name from the definition"), Inventory->GetItems()[0]->GetItemName().EqualTo(IronOre->DisplayName));
+
+	// The same state as plain values in one allocation, for comparison
+	TArray<FInventoryItemInstance> Instances;
+	Instances.Reserve(NumItems);
+	for (const UInventoryItemData* Item : Inventory->GetItems())
+	{
+		Instances.Add(Item->ToInstance());
+	}
+	const int64 InstanceBytes = Instances.GetAllocatedSize() + IronOre->GetClass()->GetStructureSize();
+
+	AddInfo(FString::Printf(TEXT("Per %d stacks: standalone %.1f KB, %d UObjects, GC %.2f ms; definition-backed %.1f KB, %d UObjects, GC %.2f ms; ")
+		TEXT("instance array %.1f KB, 1 UObject (GC with an empty inventory %.2f ms)"),
+		NumItems,
+		StandaloneBytes / 1024.0, NumItems, StandaloneGCSeconds * 1000.0,
+		DefinitionBytes / 1024.0, NumItems + 1, DefinitionGCSeconds * 1000.0,
+		InstanceBytes / 1024.0, BaselineGCSeconds * 1000.0));
+
+	TestTrue(TEXT("Sharing the definition makes items smaller"), DefinitionBytes < StandaloneBytes);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
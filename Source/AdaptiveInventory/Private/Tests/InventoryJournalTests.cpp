@@ -0,0 +1,331 @@
+// InventoryJournalTests.cpp
+// Save + journal round trips
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "Core/InventorySaveFormat.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryJournalDurabilityTest, "AdaptiveInventory.Journal.ReplaysDurability",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryJournalDurabilityTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	const FString SavePath = GetTestSavePath(TEXT("JournalDurability.inv"));
+	DeleteSave(SavePath);
+
+	TMap<FGuid, float> Expected;
+	{
+		FTestInventory Inventory;
+		UInventoryItemDefinition* Sword = Inventory.AddDefinition(TEXT("Sword"), EItemCategory::Weapon);
+		for (int32 Index = 0; Index < 3; Index++)
+		{
+			Inventory->AddItem(Inventory.MakeItem(Sword));
+		}
+
+		TestTrue(TEXT("Journal opens"), Inventory->OpenJournal(SavePath));
+
+		// Only journaled, never folded into a full save
+		const TConstArrayView<UInventoryItemData*> Items = Inventory->GetItems();
+		Inventory->SetItemDurability(Items[0]->GetItemGUID(), 12.5f);
+		Inventory->SetItemDurability(Items[2]->GetItemGUID(), 40.0f);
+		Inventory->SetItemDurability(Items[2]->GetItemGUID(), 35.0f);
+
+		for (const UInventoryItemData* Item : Items)
+		{
+			Expected.Add(Item->GetItemGUID(), Item->CurrentDurability);
+		}
+		Inventory->CloseJournal();
+	}
+
+	{
+		FTestInventory Inventory;
+		Inventory.AddDefinition(TEXT("Sword"), EItemCategory::Weapon);
+		TestTrue(TEXT("Journal reopens"), Inventory->OpenJournal(SavePath));
+
+		TestEqual(TEXT("All items restored"), Inventory->GetItemCount(), Expected.Num());
+		for (const TPair<FGuid, float>& Pair : Expected)
+		{
+			const UInventoryItemData* Item = Inventory->FindItemByGUID(Pair.Key);
+			if (TestNotNull(TEXT("Item restored"), Item))
+			{
+				TestEqual(TEXT("Durability replayed from the journal"), Item->CurrentDurability, Pair.Value);
+			}
+		}
+		Inventory->CloseJournal();
+	}
+
+	DeleteSave(SavePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryJournalContainerMoveTest, "AdaptiveInventory.Journal.ReplaysContainerMoves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryJournalContainerMoveTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	const FString SavePath = GetTestSavePath(TEXT("JournalContainerMove.inv"));
+	DeleteSave(SavePath);
+
+	const FName Stash(TEXT("Stash"));
+	const FName Backpack(TEXT("Backpack"));
+
+	struct FLocation
+	{
+		FName ContainerName;
+		int32 SlotIndex = INDEX_NONE;
+	};
+	TMap<FGuid, FLocation> Expected;
+	FGuid RodGUID;
+
+	auto CheckLocations = [&](const FTestInventory& Inventory, const TCHAR* Stage)
+	{
+		TestEqual(FString::Printf(TEXT("%s: default inventory count"), Stage), Inventory->GetItemCount(), 1);
+		TestEqual(FString::Printf(TEXT("%s: stash count"), Stage), Inventory->GetContainerItemCount(Stash), 2);
+		TestEqual(FString::Printf(TEXT("%s: backpack count"), Stage), Inventory->GetContainerItemCount(Backpack), 2);
+		for (const TPair<FGuid, FLocation>& Pair : Expected)
+		{
+			FName ContainerName;
+			int32 SlotIndex = INDEX_NONE;
+			if (TestTrue(FString::Printf(TEXT("%s: item restored"), Stage), Inventory->FindItemLocation(Pair.Key, ContainerName, SlotIndex)))
+			{
+				TestEqual(FString::Printf(TEXT("%s: same container"), Stage), ContainerName, Pair.Value.ContainerName);
+				TestEqual(FString::Printf(TEXT("%s: same slot"), Stage), SlotIndex, Pair.Value.SlotIndex);
+			}
+		}
+
+		// Saved turned, so it still only fits where it was
+		FIntPoint Position;
+		FIntPoint Size;
+		if (TestTrue(FString::Printf(TEXT("%s: rod is in the grid"), Stage), Inventory->GetItemGridPlacement(RodGUID, Position, Size)))
+		{
+			TestEqual(FString::Printf(TEXT("%s: rod keeps its rotation"), Stage), Size, FIntPoint(3, 1));
+		}
+	};
+
+	auto CreateContainers = [&](const FTestInventory& Inventory)
+	{
+		Inventory.AddDefinition(TEXT("Sword"), EItemCategory::Weapon);
+		Inventory.AddDefinition(TEXT("Gem"), EItemCategory::Material);
+		Inventory.AddDefinition(TEXT("Rod"), EItemCategory::Weapon)->GridHeight = 3;
+		Inventory->CreateContainer(Stash, 4);
+		Inventory->CreateGridContainer(Backpack, 4, 4);
+	};
+
+	{
+		FTestInventory Inventory;
+		CreateContainers(Inventory);
+		UInventoryItemDefinition* Sword = Inventory->FindItemDefinition(TEXT("Sword"));
+		UInventoryItemDefinition* Gem = Inventory->FindItemDefinition(TEXT("Gem"));
+		UInventoryItemDefinition* Rod = Inventory->FindItemDefinition(TEXT("Rod"));
+		for (int32 Index = 0; Index < 4; Index++)
+		{
+			Inventory->AddItem(Inventory.MakeItem(Sword));
+		}
+		const TArray<UInventoryItemData*> Swords(Inventory->GetItems());
+
+		// One sword already in the stash before the base save
+		Inventory->MoveItemToContainer(Swords[0]->GetItemGUID(), Stash, 3);
+
+		TestTrue(TEXT("Journal opens"), Inventory->OpenJournal(SavePath));
+
+		// Only journaled: moves in, between containers and back out, direct adds and removes, a repack
+		TestTrue(TEXT("Move into the stash"), Inventory->MoveItemToContainer(Swords[1]->GetItemGUID(), Stash, 1));
+		TestTrue(TEXT("Move into the backpack"), Inventory->MoveItemToContainer(Swords[2]->GetItemGUID(), Backpack));
+		TestTrue(TEXT("Move from the stash to the backpack"), Inventory->MoveItemToContainer(Swords[0]->GetItemGUID(), Backpack, 5));
+		TestTrue(TEXT("Move back to the stash"), Inventory->MoveItemToContainer(Swords[0]->GetItemGUID(), Stash, 0));
+		TestTrue(TEXT("Move into the stash and back out"), Inventory->MoveItemToContainer(Swords[3]->GetItemGUID(), Stash, 2) &&
+			Inventory->MoveItemToContainer(Swords[3]->GetItemGUID(), NAME_None));
+
+		UInventoryItemData* GemItem = Inventory.MakeItem(Gem);
+		TestTrue(TEXT("Add straight into the stash"), Inventory->AddItemToContainer(Stash, GemItem, 2));
+		TestTrue(TEXT("Remove from the stash"), Inventory->RemoveItemFromContainer(GemItem->GetItemGUID()));
+
+		UInventoryItemData* RodItem = Inventory.MakeItem(Rod);
+		RodGUID = RodItem->GetItemGUID();
+		TestTrue(TEXT("Add straight into the backpack"), Inventory->AddItemToContainer(Backpack, RodItem));
+		TestTrue(TEXT("Repack the backpack"), Inventory->CompactGridContainer(Backpack));
+		TestTrue(TEXT("Turn it along the bottom row"), Inventory->MoveItemInGrid(RodGUID, Backpack, FIntPoint(1, 3), true));
+
+		for (const UInventoryItemData* Item : { Swords[0], Swords[1], Swords[2], Swords[3], RodItem })
+		{
+			FLocation& Location = Expected.Add(Item->GetItemGUID());
+			Inventory->FindItemLocation(Item->GetItemGUID(), Location.ContainerName, Location.SlotIndex);
+		}
+		Inventory->CloseJournal();
+	}
+
+	// Save + journal, folded into a new save on open
+	{
+		FTestInventory Inventory;
+		CreateContainers(Inventory);
+		TestTrue(TEXT("Journal reopens"), Inventory->OpenJournal(SavePath));
+		CheckLocations(Inventory, TEXT("Replayed"));
+		Inventory->CloseJournal();
+	}
+
+	// The folded save on its own
+	{
+		FTestInventory Inventory;
+		CreateContainers(Inventory);
+		TestTrue(TEXT("Save loads"), Inventory->LoadInventory(SavePath));
+		CheckLocations(Inventory, TEXT("Loaded"));
+
+		// Loading again replaces the container contents rather than adding to them
+		TestTrue(TEXT("Save loads again"), Inventory->LoadInventory(SavePath));
+		CheckLocations(Inventory, TEXT("Reloaded"));
+	}
+
+	// Without the backpack the journal can't open, and a plain load falls back to the default inventory
+	{
+		FTestInventory Inventory;
+		Inventory.AddDefinition(TEXT("Sword"), EItemCategory::Weapon);
+		Inventory.AddDefinition(TEXT("Rod"), EItemCategory::Weapon)->GridHeight = 3;
+		Inventory->CreateContainer(Stash, 4);
+
+		AddExpectedMessage(TEXT("saved items can't be restored"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+		AddExpectedMessage(TEXT("failed to load"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+		AddExpectedMessage(TEXT("has items that can't be restored"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 1);
+		TestFalse(TEXT("Journal refuses to open without a saved container"), Inventory->OpenJournal(SavePath));
+
+		AddExpectedMessage(TEXT("Container Backpack does not exist"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 2);
+		AddExpectedMessage(TEXT("into the inventory instead of container Backpack"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 2);
+		TestTrue(TEXT("Save loads"), Inventory->LoadInventory(SavePath));
+		TestEqual(TEXT("Backpack items are in the default inventory"), Inventory->GetItemCount(), 3);
+		TestEqual(TEXT("Stash items are still in the stash"), Inventory->GetContainerItemCount(Stash), 2);
+	}
+
+	DeleteSave(SavePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryJournalExactStateTest, "AdaptiveInventory.Journal.ReplaysExactState",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryJournalExactStateTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	const FString SavePath = GetTestSavePath(TEXT("JournalExactState.inv"));
+	DeleteSave(SavePath);
+
+	TArray<FItemState> Expected;
+	{
+		FTestInventory Inventory;
+		UInventoryItemDefinition* Potion = Inventory.AddDefinition(TEXT("Potion"), EItemCategory::Consumable, EItemRarity::Common, 20);
+		UInventoryItemDefinition* Sword = Inventory.AddDefinition(TEXT("Sword"), EItemCategory::Weapon, EItemRarity::Rare);
+		Inventory->AddItem(Inventory.MakeItem(Potion, 10));
+		Inventory->AddItem(Inventory.MakeItem(Sword));
+		Inventory->AddItem(Inventory.MakeItem(Sword));
+
+		TestTrue(TEXT("Journal opens"), Inventory->OpenJournal(SavePath));
+
+		// Created after the base save, so only the journal knows it
+		UInventoryItemDefinition* Gem = Inventory.AddDefinition(TEXT("Gem"), EItemCategory::Material, EItemRarity::Epic, 50);
+		Gem->Description = FText::FromString(TEXT("Only ever journaled"));
+
+		// Merges 10 into the first potion stack and stores the other 5 as a new stack
+		Inventory->AddItem(Inventory.MakeItem(Potion, 15));
+		Inventory->AddItem(Inventory.MakeItem(Gem, 30));
+		Inventory->AddItem(Inventory.MakeItem(Gem, 30));
+
+		const TArray<UInventoryItemData*> Items(Inventory->GetItems());
+		Inventory->RemoveItemQuantity(Items.Last()->GetItemGUID(), 4);
+		Items[0]->RemoveFromStack(3);
+		Inventory->SetItemDurability(Items[1]->GetItemGUID(), 61.0f);
+		Inventory->SwapItems(Items[0]->GetItemGUID(), Items[2]->GetItemGUID());
+		Inventory->MoveItem(Items.Last()->GetItemGUID(), 0);
+		Inventory->RemoveItem(Items[1]->GetItemGUID());
+
+		// A sort is journaled as its criteria - the base save stays as it was
+		TArray<uint8> BaseSaveBefore;
+		FFileHelper::LoadFileToArray(BaseSaveBefore, *SavePath);
+
+		TArray<FInventorySortCriterion> Criteria;
+		Criteria.AddDefaulted_GetRef().Key = EInventorySortKey::Rarity;
+		Criteria.Last().bDescending = true;
+		Criteria.AddDefaulted_GetRef().Key = EInventorySortKey::StackSize;
+		Inventory->SortInventory(Criteria);
+
+		TArray<uint8> BaseSaveAfter;
+		FFileHelper::LoadFileToArray(BaseSaveAfter, *SavePath);
+		TestTrue(TEXT("Sorting doesn't rewrite the base save"), BaseSaveAfter == BaseSaveBefore);
+
+		// Later records apply on top of the sorted order
+		Inventory->MoveItem(Inventory->GetItems().Last()->GetItemGUID(), 1);
+
+		Expected = CaptureState(*Inventory);
+		Inventory->CloseJournal();
+	}
+
+	// A fresh process: nothing registered, everything comes from the save and journal
+	{
+		FTestInventory Inventory;
+		TestTrue(TEXT("Journal reopens without any registered definitions"), Inventory->OpenJournal(SavePath));
+		TestTrue(TEXT("Save + journal replay to exactly the same items, stacks and order"), CaptureState(*Inventory) == Expected);
+
+		// Rebuilt from the journal's Define record
+		const UInventoryItemDefinition* Gem = Inventory->FindItemDefinition(TEXT("Gem"));
+		if (TestNotNull(TEXT("Journal-only definition rebuilt"), Gem))
+		{
+			TestEqual(TEXT("Rebuilt description"), Gem->Description.ToString(), FString(TEXT("Only ever journaled")));
+			TestEqual(TEXT("Rebuilt stack limit"), Gem->MaxStackSize, 50);
+			TestEqual(TEXT("Rebuilt rarity"), Gem->Rarity, EItemRarity::Epic);
+		}
+		Inventory->CloseJournal();
+	}
+
+	// The compacted save written by that open round-trips on its own
+	{
+		FTestInventory Inventory;
+		TestTrue(TEXT("Compacted save opens"), Inventory->OpenJournal(SavePath));
+		TestTrue(TEXT("Compacted save holds the same state"), CaptureState(*Inventory) == Expected);
+		Inventory->CloseJournal();
+	}
+
+	DeleteSave(SavePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryJournalUnresolvedTest, "AdaptiveInventory.Journal.KeepsSaveWithUnknownDefinitions",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryJournalUnresolvedTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	const FString SavePath = GetTestSavePath(TEXT("JournalUnresolved.inv"));
+	DeleteSave(SavePath);
+
+	// A save that only names its definition, as version 1 files did
+	FInventorySaveData SaveData;
+	SaveData.DefinitionIds.Add(TEXT("Mystery"));
+	FInventorySaveRecord& Record = SaveData.Records.AddDefaulted_GetRef();
+	FInventorySaveFormat::PackGuid(FGuid::NewGuid(), Record.Guid);
+	TestTrue(TEXT("Save written"), FInventorySaveFormat::WriteToFile(SaveData, SavePath, false));
+
+	TArray<uint8> BytesBefore;
+	FFileHelper::LoadFileToArray(BytesBefore, *SavePath);
+
+	{
+		FTestInventory Inventory;
+		AddExpectedMessage(TEXT("can't be restored"), ELogVerbosity::Warning, EAutomationExpectedMessageFlags::Contains, 0);
+		TestFalse(TEXT("Open fails when a saved item can't be restored"), Inventory->OpenJournal(SavePath));
+		TestFalse(TEXT("Not journaling"), Inventory->IsJournalOpen());
+	}
+
+	TArray<uint8> BytesAfter;
+	FFileHelper::LoadFileToArray(BytesAfter, *SavePath);
+	TestTrue(TEXT("Save file left untouched"), BytesAfter == BytesBefore);
+
+	DeleteSave(SavePath);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
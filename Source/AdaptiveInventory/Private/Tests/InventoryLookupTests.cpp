@@ -0,0 +1,141 @@
+// InventoryLookupTests.cpp
+// GUID index: lookup and removal cost against inventory size; category/rarity buckets under reordering and removal
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryLookupScalingTest, "AdaptiveInventory.Lookup.FlatFrom100To100k",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryLookupScalingTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumLookups = 20000;
+	constexpr int32 NumRemovals = 2000;
+	constexpr int32 NumOrderedRemovals = 200;
+
+	struct FResult
+	{
+		int32 NumItems = 0;
+		double LookupSeconds = 0.0;
+		double SwapRemoveSeconds = 0.0;
+		double OrderedRemoveSeconds = 0.0;
+	};
+	TArray<FResult> Results;
+
+	for (const int32 NumItems : { 100, 1000, 10000, 100000 })
+	{
+		FTestInventory Inventory;
+		const TArray<UInventoryItemData*> Items = Inventory.Populate(NumItems);
+		FRandomStream Random(NumItems);
+
+		FResult& Result = Results.AddDefaulted_GetRef();
+		Result.NumItems = NumItems;
+
+		int32 NumFound = 0;
+		Result.LookupSeconds = TimePerCall(NumLookups, [&]()
+		{
+			NumFound += Inventory->FindItemByGUID(Items[Random.RandRange(0, NumItems - 1)]->GetItemGUID()) != nullptr;
+		});
+		TestEqual(TEXT("Every lookup finds its item"), NumFound, NumLookups + 1);
+
+		// Remove and put back, so the size stays the same throughout
+		auto RemoveAndReAdd = [&]()
+		{
+			UInventoryItemData* Item = Items[Random.RandRange(0, NumItems - 1)];
+			Inventory->RemoveItem(Item->GetItemGUID());
+			Inventory->AddItem(Item);
+		};
+
+		Inventory->SetPreserveOrderOnRemove(false);
+		Result.SwapRemoveSeconds = TimePerCall(NumRemovals, RemoveAndReAdd);
+
+		// The stable mode still shifts the tail - reported for contrast
+		Inventory->SetPreserveOrderOnRemove(true);
+		Result.OrderedRemoveSeconds = TimePerCall(NumOrderedRemovals, RemoveAndReAdd);
+
+		TestEqual(TEXT("Inventory size unchanged"), Inventory->GetItemCount(), NumItems);
+		AddInfo(FString::Printf(TEXT("%6d items: lookup %.0f ns, swap-remove + add %.0f ns, ordered remove + add %.0f ns"),
+			NumItems, Result.LookupSeconds * 1e9, Result.SwapRemoveSeconds * 1e9, Result.OrderedRemoveSeconds * 1e9));
+	}
+
+	// A scan would grow 1000x from the smallest to the largest; allow for cache misses, not for that
+	const FResult& Smallest = Results[0];
+	const FResult& Largest = Results.Last();
+	TestTrue(TEXT("Lookup cost stays flat"), Largest.LookupSeconds < Smallest.LookupSeconds * 10.0);
+	TestTrue(TEXT("Swap-remove cost stays flat"), Largest.SwapRemoveSeconds < Smallest.SwapRemoveSeconds * 10.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryBucketOrderTest, "AdaptiveInventory.Lookup.BucketsFollowMovesAndSwaps",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryBucketOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 300;
+	constexpr int32 NumReorders = 3000;
+
+	FTestInventory Inventory;
+	Inventory.Populate(NumItems);
+	FRandomStream Random(9);
+
+	// Each bucket has to stay exactly the inventory filtered to it, in inventory order
+	auto BucketsMatchItems = [&Inventory]()
+	{
+		for (int32 Value = 0; Value < 5; Value++)
+		{
+			const EItemCategory Category = static_cast<EItemCategory>(Value);
+			const EItemRarity Rarity = static_cast<EItemRarity>(Value);
+			const TArray<UInventoryItemData*> ExpectedCategory = TArray<UInventoryItemData*>(Inventory->GetItems())
+				.FilterByPredicate([Category](const UInventoryItemData* Item) { return Item->GetItemCategory() == Category; });
+			const TArray<UInventoryItemData*> ExpectedRarity = TArray<UInventoryItemData*>(Inventory->GetItems())
+				.FilterByPredicate([Rarity](const UInventoryItemData* Item) { return Item->GetItemRarity() == Rarity; });
+			if (TArray<UInventoryItemData*>(Inventory->GetItemsByCategoryView(Category)) != ExpectedCategory ||
+				TArray<UInventoryItemData*>(Inventory->GetItemsByRarityView(Rarity)) != ExpectedRarity)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// Both removal modes: a swap-remove drops the last item into the hole, which its buckets must follow too
+	for (const bool bPreserveOrder : { true, false })
+	{
+		Inventory->SetPreserveOrderOnRemove(bPreserveOrder);
+
+		int32 NumMismatches = 0;
+		for (int32 Reorder = 0; Reorder < NumReorders; Reorder++)
+		{
+			const TConstArrayView<UInventoryItemData*> Items = Inventory->GetItems();
+			UInventoryItemData* Item = Items[Random.RandRange(0, NumItems - 1)];
+			switch (Random.RandRange(0, 2))
+			{
+				case 0:
+					Inventory->MoveItem(Item->GetItemGUID(), Random.RandRange(0, NumItems - 1));
+					break;
+				case 1:
+					Inventory->SwapItems(Item->GetItemGUID(), Items[Random.RandRange(0, NumItems - 1)]->GetItemGUID());
+					break;
+				default:
+					// Remove and put back, so the size stays the same throughout
+					Inventory->RemoveItem(Item->GetItemGUID());
+					Inventory->AddItem(Item);
+					break;
+			}
+			NumMismatches += !BucketsMatchItems();
+		}
+
+		TestEqual(FString::Printf(TEXT("Buckets follow the inventory after every move, swap and %s remove"),
+			bPreserveOrder ? TEXT("ordered") : TEXT("swap")), NumMismatches, 0);
+		TestEqual(TEXT("Inventory size unchanged"), Inventory->GetItemCount(), NumItems);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
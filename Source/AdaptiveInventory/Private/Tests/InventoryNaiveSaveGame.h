@@ -0,0 +1,41 @@
+// InventoryNaiveSaveGame.h
+// The straightforward USaveGame an inventory would otherwise be saved with - the baseline for the save benchmark
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "InventoryNaiveSaveGame.generated.h"
+
+/** One item, as UPROPERTYs */
+USTRUCT()
+struct FInventoryNaiveSavedItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(SaveGame)
+	FName DefinitionId;
+
+	UPROPERTY(SaveGame)
+	FGuid ItemGUID;
+
+	UPROPERTY(SaveGame)
+	int32 StackCount = 1;
+
+	UPROPERTY(SaveGame)
+	float Durability = 100.0f;
+};
+
+/**
+ * The same data the binary save holds, written with tagged property serialization
+ * (UGameplayStatics::SaveGameToMemory / LoadGameFromMemory). Only used by the automation tests.
+ */
+UCLASS()
+class UInventoryNaiveSaveGame : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(SaveGame)
+	TArray<FInventoryNaiveSavedItem> Items;
+};
@@ -0,0 +1,90 @@
+// InventoryQueryTests.cpp
+// Parallel scans: how FInventoryQuery scales from one core to all of them
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "Core/InventoryQuery.h"
+#include "Async/TaskGraphInterfaces.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryQueryScalingTest, "AdaptiveInventory.Query.ScalingAcrossCores",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryQueryScalingTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 200000;
+	constexpr int32 Iterations = 20;
+
+	FTestInventory Inventory;
+	Inventory.Populate(NumItems);
+	const TConstArrayView<UInventoryItemData*> Items = Inventory->GetItems();
+
+	const FInventoryItemPredicate Predicate =
+		FInventoryItemPredicate::Category(EItemCategory::Weapon) &&
+		FInventoryItemPredicate::RarityBetween(EItemRarity::Uncommon, EItemRarity::Legendary) &&
+		FInventoryItemPredicate::StatAtLeast(EInventoryItemStat::MinDamage, 20.0f);
+
+	// Small chunks so even the widest run has several per thread; every run uses the same ones
+	FInventoryQueryOptions Options;
+	Options.MinItemsPerChunk = 1024;
+	Options.bWarmNameCaches = false;
+	const int32 NumChunks = FInventoryQuery::GetNumChunks(Items.Num(), Options);
+
+	TArray<UInventoryItemData*> Matches;
+	int64 Quantity = 0;
+	auto TimeScan = [&](double& OutFindSeconds, double& OutSumSeconds)
+	{
+		OutFindSeconds = TimePerCall(Iterations, [&]() { FInventoryQuery::FindItems(Items, Predicate, Matches, Options); });
+		OutSumSeconds = TimePerCall(Iterations, [&]() { Quantity = FInventoryQuery::SumQuantity(Items, Predicate, Options); });
+	};
+
+	// Baseline: the same chunks, all on this thread
+	Options.bSingleThreaded = true;
+	double BaselineFindSeconds = 0.0;
+	double BaselineSumSeconds = 0.0;
+	TimeScan(BaselineFindSeconds, BaselineSumSeconds);
+	const TArray<UInventoryItemData*> ExpectedMatches = Matches;
+	const int64 ExpectedQuantity = Quantity;
+	TestTrue(TEXT("The predicate matches something"), ExpectedMatches.Num() > 0);
+
+	AddInfo(FString::Printf(TEXT("%d items in %d chunks, %d matches: single-threaded find %.2f ms, sum %.2f ms"),
+		NumItems, NumChunks, ExpectedMatches.Num(), BaselineFindSeconds * 1000.0, BaselineSumSeconds * 1000.0));
+
+	// 1, 2, 4... cores, always ending on every worker plus this thread
+	Options.bSingleThreaded = false;
+	const int32 NumCores = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	double WidestSumSeconds = BaselineSumSeconds;
+	for (int32 NumThreads = 1; ; NumThreads = FMath::Min(NumThreads * 2, NumCores))
+	{
+		Options.MaxThreads = NumThreads;
+		double FindSeconds = 0.0;
+		double SumSeconds = 0.0;
+		TimeScan(FindSeconds, SumSeconds);
+
+		TestTrue(FString::Printf(TEXT("%d threads find the same items in the same order"), NumThreads), Matches == ExpectedMatches);
+		TestEqual(FString::Printf(TEXT("%d threads sum the same quantity"), NumThreads), Quantity, ExpectedQuantity);
+
+		const double FindSpeedup = BaselineFindSeconds / FMath::Max(FindSeconds, 1e-9);
+		const double SumSpeedup = BaselineSumSeconds / FMath::Max(SumSeconds, 1e-9);
+		AddInfo(FString::Printf(TEXT("%2d threads: find %.2f ms (%.2fx, %.0f%% efficient), sum %.2f ms (%.2fx, %.0f%% efficient)"),
+			NumThreads, FindSeconds * 1000.0, FindSpeedup, FindSpeedup / NumThreads * 100.0,
+			SumSeconds * 1000.0, SumSpeedup, SumSpeedup / NumThreads * 100.0));
+
+		WidestSumSeconds = SumSeconds;
+		if (NumThreads == NumCores)
+		{
+			break;
+		}
+	}
+
+	if (NumCores > 1)
+	{
+		TestTrue(TEXT("Scanning on every core beats the single-threaded baseline"), WidestSumSeconds < BaselineSumSeconds);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
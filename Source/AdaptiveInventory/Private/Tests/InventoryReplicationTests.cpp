@@ -0,0 +1,488 @@
+// InventoryReplicationTests.cpp
+// Replication traffic and client command batching of a listen server with two clients, in PIE
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Core/InventoryManagerSubsystem.h"
+#include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
+#include "Core/InventoryReplicationComponent.h"
+#include "InventoryTestReplicationComponent.h"
+#include "Editor.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationCommon.h"
+#include "UObject/Package.h"
+
+namespace InventoryReplicationTest
+{
+	constexpr int32 NumClients = 2;
+	constexpr int32 NumDefinitions = 10;
+	constexpr int32 NumStartItems = 100;
+	constexpr int32 MutationsPerPhase = 60;
+
+	/** Frames after the last mutation of a phase for its updates to go out */
+	constexpr int32 DrainFrames = 30;
+
+	constexpr double TimeoutSeconds = 60.0;
+
+	/** Client command run: frames with commands, removals queued per client per frame, and how often a client tries an add instead */
+	constexpr int32 CommandFrames = 60;
+	constexpr int32 RemovalsPerFrame = 3;
+	constexpr int32 AddEveryNFrames = 10;
+
+	enum class EPhase : uint8
+	{
+		Idle,
+		Durability,
+		StackSize,
+		Add
+	};
+
+	const TCHAR* GetPhaseName(EPhase Phase)
+	{
+		switch (Phase)
+		{
+			case EPhase::Durability:
+				return TEXT("durability change");
+			case EPhase::StackSize:
+				return TEXT("stack change");
+			case EPhase::Add:
+				return TEXT("add");
+			default:
+				return TEXT("idle");
+		}
+	}
+
+	/** Shared between the latent commands of one run */
+	struct FState
+	{
+		FAutomationTestBase* Test = nullptr;
+		TArray<UInventoryItemDefinition*> Definitions;
+		FRandomStream Random{ 2021 };
+
+		/** Component given to each remote player; the base one refuses all client commands */
+		TSubclassOf<UInventoryReplicationComponent> ComponentClass = UInventoryReplicationComponent::StaticClass();
+
+		bool bServerSetUp = false;
+		bool bReady = false;
+
+		int32 PhaseFrame = 0;
+		int64 PhaseStartBytes = 0;
+		TMap<EPhase, int64> BytesByPhase;
+
+		/** Server items before the clients' commands ran, and any that appeared since */
+		TSet<FGuid> StartItems;
+		int32 NumUnexpectedServerItems = 0;
+	};
+
+	UWorld* FindPIEWorld(ENetMode NetMode, int32 Skip = 0)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (Context.WorldType == EWorldType::PIE && World && World->GetNetMode() == NetMode && Skip-- == 0)
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+
+	UInventoryManagerSubsystem* GetInventoryManager(const UWorld* World)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<UInventoryManagerSubsystem>() : nullptr;
+	}
+
+	/** A client's copy of its replication component */
+	UInventoryReplicationComponent* GetClientComponent(int32 ClientIndex)
+	{
+		const UWorld* World = FindPIEWorld(NM_Client, ClientIndex);
+		const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		return PlayerController ? PlayerController->FindComponentByClass<UInventoryReplicationComponent>() : nullptr;
+	}
+
+	/** Everything the server has sent its clients so far */
+	int64 GetBytesSentToClients(const UWorld* ServerWorld)
+	{
+		int64 Bytes = 0;
+		if (const UNetDriver* NetDriver = ServerWorld ? ServerWorld->GetNetDriver() : nullptr)
+		{
+			for (const UNetConnection* Connection : NetDriver->ClientConnections)
+			{
+				if (Connection)
+				{
+					Bytes += static_cast<int64>(Connection->OutTotalBytes);
+				}
+			}
+		}
+		return Bytes;
+	}
+
+	/**
+	 * Stand-ins for definition assets: a named package and RF_WasLoaded make the package map
+	 * refer to them by path, which the clients resolve because PIE runs them in this process
+	 */
+	void CreateDefinitions(FState& State)
+	{
+		UPackage* Package = CreatePackage(TEXT("/Temp/InventoryReplicationTest"));
+		for (int32 Index = 0; Index < NumDefinitions; Index++)
+		{
+			const FName Name(*FString::Printf(TEXT("TestDefinition_%d"), Index));
+			UInventoryItemDefinition* Definition = NewObject<UInventoryItemDefinition>(Package, Name, RF_Public | RF_WasLoaded);
+			Definition->DefinitionId = Name;
+			Definition->DisplayName = FText::FromName(Name);
+			Definition->Category = static_cast<EItemCategory>(Index % 5);
+			Definition->bIsStackable = true;
+			Definition->MaxStackSize = 50;
+			Definition->AddToRoot();
+			State.Definitions.Add(Definition);
+		}
+	}
+
+	/** A full stack, so auto-stacking never folds it into another */
+	UInventoryItemData* MakeItem(FState& State, UInventoryManagerSubsystem& Manager)
+	{
+		UInventoryItemData* Item = NewObject<UInventoryItemData>(Manager.GetGameInstance());
+		Item->InitializeFromDefinition(State.Definitions[State.Random.RandRange(0, NumDefinitions - 1)], 50);
+		return Item;
+	}
+
+	/** Every client ended up with the server's items, stacks and durabilities */
+	void TestClientsMatchServer(FAutomationTestBase& Test, const UInventoryManagerSubsystem& ServerManager)
+	{
+		for (int32 ClientIndex = 0; ClientIndex < NumClients; ClientIndex++)
+		{
+			const UInventoryManagerSubsystem* ClientManager = GetInventoryManager(FindPIEWorld(NM_Client, ClientIndex));
+			if (!Test.TestNotNull(TEXT("Client inventory"), ClientManager))
+			{
+				continue;
+			}
+
+			Test.TestEqual(TEXT("Client item count matches the server"), ClientManager->GetItemCount(), ServerManager.GetItemCount());
+			Test.TestEqual(TEXT("Client quantity matches the server"), ClientManager->GetTotalItemQuantity(), ServerManager.GetTotalItemQuantity());
+
+			int32 NumDurabilityMismatches = 0;
+			for (const UInventoryItemData* ServerItem : ServerManager.GetItems())
+			{
+				const UInventoryItemData* ClientItem = ClientManager->FindItemByGUID(ServerItem->GetItemGUID());
+				NumDurabilityMismatches += !ClientItem || !FMath::IsNearlyEqual(ClientItem->CurrentDurability, ServerItem->CurrentDurability);
+			}
+			Test.TestEqual(TEXT("Client durabilities match the server"), NumDurabilityMismatches, 0);
+		}
+	}
+
+	void ReleaseDefinitions(FState& State)
+	{
+		for (UInventoryItemDefinition* Definition : State.Definitions)
+		{
+			Definition->RemoveFromRoot();
+		}
+		State.Definitions.Reset();
+	}
+
+	void Mutate(FState& State, UInventoryManagerSubsystem& Manager, EPhase Phase)
+	{
+		const TConstArrayView<UInventoryItemData*> Items = Manager.GetItems();
+		UInventoryItemData* Item = Items[State.Random.RandRange(0, Items.Num() - 1)];
+
+		switch (Phase)
+		{
+			case EPhase::Durability:
+				Manager.SetItemDurability(Item->GetItemGUID(), State.Random.FRandRange(0.0f, Item->MaxDurability));
+				break;
+			case EPhase::StackSize:
+				Manager.RemoveItemQuantity(Item->GetItemGUID(), 1);
+				break;
+			case EPhase::Add:
+				Manager.AddItem(MakeItem(State, Manager));
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+using namespace InventoryReplicationTest;
+
+/** Start PIE as a listen server plus clients, all in this process */
+DEFINE_LATENT_AUTOMATION_COMMAND(FInventoryStartListenServerCommand);
+
+bool FInventoryStartListenServerCommand::Update()
+{
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_ListenServer);
+	PlaySettings->SetPlayNumberOfClients(NumClients + 1);
+	PlaySettings->SetRunUnderOneProcess(true);
+	PlaySettings->bLaunchSeparateServer = false;
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.EditorPlaySettings = PlaySettings;
+	GEditor->RequestPlaySession(Params);
+	return true;
+}
+
+/** Give each client a replication component and wait until they mirror the server */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FInventoryWaitForClientsCommand, TSharedRef<FState>, State);
+
+bool FInventoryWaitForClientsCommand::Update()
+{
+	if (GetCurrentRunTime() > TimeoutSeconds)
+	{
+		State->Test->AddError(TEXT("Clients did not receive the server's inventory in time"));
+		return true;
+	}
+
+	UWorld* ServerWorld = FindPIEWorld(NM_ListenServer);
+	UInventoryManagerSubsystem* ServerManager = GetInventoryManager(ServerWorld);
+	if (!ServerManager || ServerWorld->GetNumPlayerControllers() < NumClients + 1)
+	{
+		return false;
+	}
+
+	if (!State->bServerSetUp)
+	{
+		CreateDefinitions(*State);
+		{
+			FInventoryBatchScope BatchScope(ServerManager);
+			ServerManager->SetMaxInventorySlots(NumStartItems + MutationsPerPhase);
+			for (int32 Index = 0; Index < NumStartItems; Index++)
+			{
+				ServerManager->AddItem(MakeItem(*State, *ServerManager));
+			}
+		}
+
+		// The list replicates to the owning connection only - one component per remote player
+		for (FConstPlayerControllerIterator It = ServerWorld->GetPlayerControllerIterator(); It; ++It)
+		{
+			APlayerController* PlayerController = It->Get();
+			if (PlayerController && !PlayerController->IsLocalController())
+			{
+				UInventoryReplicationComponent* Component = NewObject<UInventoryReplicationComponent>(PlayerController, State->ComponentClass);
+				Component->RegisterComponent();
+			}
+		}
+		State->bServerSetUp = true;
+	}
+
+	for (int32 ClientIndex = 0; ClientIndex < NumClients; ClientIndex++)
+	{
+		const UInventoryManagerSubsystem* ClientManager = GetInventoryManager(FindPIEWorld(NM_Client, ClientIndex));
+		if (!ClientManager || ClientManager->GetItemCount() != ServerManager->GetItemCount())
+		{
+			return false;
+		}
+	}
+
+	State->bReady = true;
+	return true;
+}
+
+/** Apply one mutation per frame on the server and count the bytes sent to the clients */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FInventoryMeasurePhaseCommand, TSharedRef<FState>, State, EPhase, Phase);
+
+bool FInventoryMeasurePhaseCommand::Update()
+{
+	UWorld* ServerWorld = FindPIEWorld(NM_ListenServer);
+	UInventoryManagerSubsystem* ServerManager = GetInventoryManager(ServerWorld);
+	if (!State->bReady || !ServerManager)
+	{
+		return true;
+	}
+
+	if (State->PhaseFrame == 0)
+	{
+		State->PhaseStartBytes = GetBytesSentToClients(ServerWorld);
+	}
+	if (State->PhaseFrame < MutationsPerPhase)
+	{
+		Mutate(*State, *ServerManager, Phase);
+	}
+
+	if (++State->PhaseFrame < MutationsPerPhase + DrainFrames)
+	{
+		return false;
+	}
+
+	State->BytesByPhase.Add(Phase, GetBytesSentToClients(ServerWorld) - State->PhaseStartBytes);
+	State->PhaseFrame = 0;
+	return true;
+}
+
+/** Report bytes per mutation and check the clients ended up with the server's state */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FInventoryReportCommand, TSharedRef<FState>, State);
+
+bool FInventoryReportCommand::Update()
+{
+	FAutomationTestBase& Test = *State->Test;
+	const UInventoryManagerSubsystem* ServerManager = GetInventoryManager(FindPIEWorld(NM_ListenServer));
+
+	if (State->bReady && ServerManager)
+	{
+		// Whatever the session sends anyway (movement, acks) over the same number of frames
+		const int64 IdleBytes = State->BytesByPhase.FindRef(EPhase::Idle);
+		for (const EPhase Phase : { EPhase::Durability, EPhase::StackSize, EPhase::Add })
+		{
+			const int64 Bytes = State->BytesByPhase.FindRef(Phase);
+			const double BytesPerMutation = static_cast<double>(Bytes - IdleBytes) / (MutationsPerPhase * NumClients);
+			Test.AddInfo(FString::Printf(TEXT("%s: %.1f bytes per mutation per client (%lld bytes for %d mutations to %d clients, %lld idle)"),
+				GetPhaseName(Phase), BytesPerMutation, Bytes, MutationsPerPhase, NumClients, IdleBytes));
+		}
+
+		TestClientsMatchServer(Test, *ServerManager);
+	}
+
+	ReleaseDefinitions(*State);
+	return true;
+}
+
+/**
+ * Both clients queue removals every frame, all against the one shared inventory, so their
+ * predictions conflict; every AddEveryNFrames-th frame a client tries an add instead, which
+ * the server must refuse. Runs with UInventoryTestReplicationComponent, as the base component
+ * refuses the removals too.
+ */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FInventoryClientCommandsCommand, TSharedRef<FState>, State);
+
+bool FInventoryClientCommandsCommand::Update()
+{
+	const UInventoryManagerSubsystem* ServerManager = GetInventoryManager(FindPIEWorld(NM_ListenServer));
+	if (!State->bReady || !ServerManager)
+	{
+		return true;
+	}
+
+	if (State->PhaseFrame == 0)
+	{
+		for (const UInventoryItemData* Item : ServerManager->GetItems())
+		{
+			State->StartItems.Add(Item->GetItemGUID());
+		}
+
+		// Room for the adds to be predicted, so it is the server that refuses them
+		for (int32 ClientIndex = 0; ClientIndex < NumClients; ClientIndex++)
+		{
+			if (UInventoryManagerSubsystem* ClientManager = GetInventoryManager(FindPIEWorld(NM_Client, ClientIndex)))
+			{
+				ClientManager->SetMaxInventorySlots(NumStartItems + CommandFrames);
+			}
+		}
+	}
+
+	if (State->PhaseFrame < CommandFrames)
+	{
+		for (int32 ClientIndex = 0; ClientIndex < NumClients; ClientIndex++)
+		{
+			UInventoryReplicationComponent* Component = GetClientComponent(ClientIndex);
+			const UInventoryManagerSubsystem* ClientManager = GetInventoryManager(FindPIEWorld(NM_Client, ClientIndex));
+			if (!Component || !ClientManager || ClientManager->GetItemCount() == 0)
+			{
+				continue;
+			}
+
+			// Adds go out on frames of their own, so their rejection doesn't take removals with it
+			if (State->PhaseFrame % AddEveryNFrames == AddEveryNFrames - 1)
+			{
+				Component->QueueAddItem(State->Definitions[State->Random.RandRange(0, NumDefinitions - 1)], 50);
+				continue;
+			}
+
+			for (int32 Removal = 0; Removal < RemovalsPerFrame; Removal++)
+			{
+				const TConstArrayView<UInventoryItemData*> Items = ClientManager->GetItems();
+				Component->QueueRemoveItemQuantity(Items[State->Random.RandRange(0, Items.Num() - 1)]->GetItemGUID(), 1);
+			}
+		}
+	}
+
+	for (const UInventoryItemData* Item : ServerManager->GetItems())
+	{
+		State->NumUnexpectedServerItems += !State->StartItems.Contains(Item->GetItemGUID());
+	}
+
+	return ++State->PhaseFrame >= CommandFrames + DrainFrames;
+}
+
+/** Report RPCs and corrections per client and check nothing is left in flight */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FInventoryCommandReportCommand, TSharedRef<FState>, State);
+
+bool FInventoryCommandReportCommand::Update()
+{
+	FAutomationTestBase& Test = *State->Test;
+	const UInventoryManagerSubsystem* ServerManager = GetInventoryManager(FindPIEWorld(NM_ListenServer));
+
+	if (State->bReady && ServerManager)
+	{
+		Test.TestEqual(TEXT("The server accepted no client adds"), State->NumUnexpectedServerItems, 0);
+
+		for (int32 ClientIndex = 0; ClientIndex < NumClients; ClientIndex++)
+		{
+			const UInventoryReplicationComponent* Component = GetClientComponent(ClientIndex);
+			if (!Test.TestNotNull(TEXT("Client replication component"), Component))
+			{
+				continue;
+			}
+
+			const FInventoryCommandStats Stats = Component->GetCommandStats();
+			Test.AddInfo(FString::Printf(TEXT("Client %d: %d commands in %d RPCs (%.1f per RPC), %d acked, %d corrections (%.1f%% of RPCs)"),
+				ClientIndex, Stats.CommandsQueued, Stats.RPCsSent, static_cast<double>(Stats.CommandsQueued) / FMath::Max(1, Stats.RPCsSent),
+				Stats.CommandsAcknowledged, Stats.Corrections, 100.0 * Stats.Corrections / FMath::Max(1, Stats.RPCsSent)));
+
+			Test.TestTrue(TEXT("At most one RPC per frame with commands"), Stats.RPCsSent <= CommandFrames);
+			Test.TestEqual(TEXT("Every command was acked"), Stats.CommandsAcknowledged, Stats.CommandsQueued);
+			Test.TestEqual(TEXT("Nothing left in flight"), Component->GetNumPendingCommands(), 0);
+			Test.TestTrue(TEXT("Refused adds were rolled back"), Stats.Corrections > 0);
+		}
+
+		TestClientsMatchServer(Test, *ServerManager);
+	}
+
+	ReleaseDefinitions(*State);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryReplicationBytesTest, "AdaptiveInventory.Replication.ListenServerBytesPerMutation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryReplicationBytesTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FState> State = MakeShared<FState>();
+	State->Test = this;
+
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryStartListenServerCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryWaitForClientsCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryMeasurePhaseCommand(State, EPhase::Idle));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryMeasurePhaseCommand(State, EPhase::Durability));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryMeasurePhaseCommand(State, EPhase::StackSize));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryMeasurePhaseCommand(State, EPhase::Add));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryReportCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryReplicationCommandsTest, "AdaptiveInventory.Replication.ClientCommandBatches",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryReplicationCommandsTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FState> State = MakeShared<FState>();
+	State->Test = this;
+	State->ComponentClass = UInventoryTestReplicationComponent::StaticClass();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryStartListenServerCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryWaitForClientsCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryClientCommandsCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FInventoryCommandReportCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
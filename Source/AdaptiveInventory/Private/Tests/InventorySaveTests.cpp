@@ -0,0 +1,189 @@
+// InventorySaveTests.cpp
+// Save files: async saves under concurrent changes, load cost against a plain USaveGame
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "InventoryNaiveSaveGame.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryAsyncSavePointInTimeTest, "AdaptiveInventory.Save.AsyncSaveIsPointInTime",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventoryAsyncSavePointInTimeTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 100000;
+	constexpr int32 NumMutations = 50000;
+	constexpr double TimeoutSeconds = 60.0;
+
+	const FString SavePath = GetTestSavePath(TEXT("AsyncPointInTime.inv"));
+	DeleteSave(SavePath);
+
+	TArray<FItemState> Expected;
+	{
+		FTestInventory Inventory;
+		Inventory.Populate(NumItems);
+		UInventoryItemDefinition* Arrow = Inventory.AddDefinition(TEXT("Arrow"), EItemCategory::Consumable, EItemRarity::Common, 100);
+		Inventory->AddItem(Inventory.MakeItem(Arrow, 100));
+
+		// The save must hold exactly this, whatever happens after the call
+		Expected = CaptureState(*Inventory);
+		Inventory->SaveInventoryAsync(SavePath);
+
+		// Hammer the inventory while the save is written: every kind of change, including to
+		// items the save already captured
+		FRandomStream Random(12);
+		int32 NumMutationsBeforeFileWritten = INDEX_NONE;
+		for (int32 Mutation = 0; Mutation < NumMutations; Mutation++)
+		{
+			const TConstArrayView<UInventoryItemData*> Items = Inventory->GetItems();
+			UInventoryItemData* Item = Items[Random.RandRange(0, Items.Num() - 1)];
+			switch (Mutation % 5)
+			{
+				case 0:
+					Inventory->SetItemDurability(Item->GetItemGUID(), Random.FRandRange(0.0f, 100.0f));
+					break;
+				case 1:
+					Inventory->SwapItems(Item->GetItemGUID(), Items[Random.RandRange(0, Items.Num() - 1)]->GetItemGUID());
+					break;
+				case 2:
+					Inventory->RemoveItem(Items.Last()->GetItemGUID());
+					break;
+				case 3:
+					Inventory->AddItem(Inventory.MakeItem(Arrow, Random.RandRange(1, 100)));
+					break;
+				default:
+					// Direct stack edit, outside any inventory call
+					Item->SetStackSize(Random.RandRange(1, 100));
+					break;
+			}
+
+			if (NumMutationsBeforeFileWritten == INDEX_NONE && IFileManager::Get().FileExists(*SavePath))
+			{
+				NumMutationsBeforeFileWritten = Mutation + 1;
+			}
+		}
+
+		// Pump the completion event back onto this thread
+		const double StartTime = FPlatformTime::Seconds();
+		while (Inventory->IsSaveInProgress() && FPlatformTime::Seconds() - StartTime < TimeoutSeconds)
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::Sleep(0.001f);
+		}
+		TestFalse(TEXT("Save completed"), Inventory->IsSaveInProgress());
+
+		AddInfo(FString::Printf(TEXT("%d items saved; %d of %d mutations ran before the file was in place"), Expected.Num(),
+			NumMutationsBeforeFileWritten == INDEX_NONE ? NumMutations : NumMutationsBeforeFileWritten, NumMutations));
+		TestTrue(TEXT("The inventory was changed while the save was in flight"), NumMutationsBeforeFileWritten != 1);
+	}
+
+	// Fresh process, nothing registered - the file alone has to reproduce the snapshot
+	{
+		FTestInventory Inventory;
+		TestTrue(TEXT("Save loads"), Inventory->LoadInventory(SavePath));
+		TestTrue(TEXT("Loaded items match the inventory at the moment of the save call"), CaptureState(*Inventory) == Expected);
+	}
+
+	DeleteSave(SavePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryLoadBenchmarkTest, "AdaptiveInventory.Save.LoadVsSaveGame",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryLoadBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 100000;
+	constexpr int32 Iterations = 3;
+
+	const FString SavePath = GetTestSavePath(TEXT("LoadBenchmark.inv"));
+	const FString SaveGamePath = GetTestSavePath(TEXT("LoadBenchmark.sav"));
+
+	FTestInventory Inventory;
+	Inventory.Populate(NumItems, 500);
+	const TArray<FItemState> Expected = CaptureState(*Inventory);
+
+	// The binary save
+	TestTrue(TEXT("Binary save written"), Inventory->SaveInventory(SavePath));
+
+	// The same items as UPROPERTYs of a USaveGame
+	{
+		UInventoryNaiveSaveGame* SaveGame = NewObject<UInventoryNaiveSaveGame>();
+		SaveGame->Items.Reserve(NumItems);
+		for (const UInventoryItemData* Item : Inventory->GetItems())
+		{
+			FInventoryNaiveSavedItem& Saved = SaveGame->Items.AddDefaulted_GetRef();
+			Saved.DefinitionId = Item->GetItemDefinition()->GetDefinitionId();
+			Saved.ItemGUID = Item->GetItemGUID();
+			Saved.StackCount = Item->GetCurrentStackSize();
+			Saved.Durability = Item->CurrentDurability;
+		}
+
+		TArray<uint8> Bytes;
+		TestTrue(TEXT("USaveGame serialized"), UGameplayStatics::SaveGameToMemory(SaveGame, Bytes));
+		TestTrue(TEXT("USaveGame written"), FFileHelper::SaveArrayToFile(Bytes, *SaveGamePath));
+	}
+
+	// Read the USaveGame back and rebuild the items from it, the way a game would
+	auto LoadSaveGame = [&]()
+	{
+		TArray<uint8> Bytes;
+		FFileHelper::LoadFileToArray(Bytes, *SaveGamePath);
+		const UInventoryNaiveSaveGame* SaveGame = Cast<UInventoryNaiveSaveGame>(UGameplayStatics::LoadGameFromMemory(Bytes));
+		if (!SaveGame)
+		{
+			return false;
+		}
+
+		Inventory->ClearInventory();
+		FInventoryBatchScope BatchScope(&*Inventory);
+		for (const FInventoryNaiveSavedItem& Saved : SaveGame->Items)
+		{
+			UInventoryItemData* Item = Inventory.MakeItem(Inventory->FindItemDefinition(Saved.DefinitionId));
+			FInventoryItemInstance Instance = Item->ToInstance();
+			Instance.ItemGUID = Saved.ItemGUID;
+			Instance.StackCount = Saved.StackCount;
+			Instance.Durability = Saved.Durability;
+			Item->ApplyInstance(Instance);
+			Inventory->AddItem(Item);
+		}
+		return true;
+	};
+
+	// Each load leaves the previous items behind as garbage - collect it outside the timed part
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	bool bBinaryLoaded = true;
+	const double BinarySeconds = TimePerCall(Iterations, [&]() { bBinaryLoaded &= Inventory->LoadInventory(SavePath); });
+	TestTrue(TEXT("Binary save loads"), bBinaryLoaded);
+	TestTrue(TEXT("Binary save brings back every item"), CaptureState(*Inventory) == Expected);
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	bool bSaveGameLoaded = true;
+	const double SaveGameSeconds = TimePerCall(Iterations, [&]() { bSaveGameLoaded &= LoadSaveGame(); });
+	TestTrue(TEXT("USaveGame loads"), bSaveGameLoaded);
+	TestTrue(TEXT("USaveGame brings back every item"), CaptureState(*Inventory) == Expected);
+
+	const int64 BinaryBytes = IFileManager::Get().FileSize(*SavePath);
+	const int64 SaveGameBytes = IFileManager::Get().FileSize(*SaveGamePath);
+	AddInfo(FString::Printf(TEXT("%d items: binary save %.1f KB, loads in %.1f ms; USaveGame %.1f KB, loads in %.1f ms (%.1fx)"),
+		NumItems, BinaryBytes / 1024.0, BinarySeconds * 1000.0, SaveGameBytes / 1024.0, SaveGameSeconds * 1000.0,
+		SaveGameSeconds / FMath::Max(BinarySeconds, 1e-9)));
+
+	TestTrue(TEXT("Binary save is smaller"), BinaryBytes < SaveGameBytes);
+	TestTrue(TEXT("Binary save loads faster"), BinarySeconds < SaveGameSeconds);
+
+	DeleteSave(SavePath);
+	IFileManager::Get().Delete(*SaveGamePath, false, false, true);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,60 @@
+// InventorySearchTests.cpp
+// Name search: trigram index against a full scan
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySearchLatencyTest, "AdaptiveInventory.Search.LatencyOn50kItems",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventorySearchLatencyTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 50000;
+	constexpr int32 NumNames = 5000;
+	constexpr int32 Iterations = 50;
+
+	FTestInventory Inventory;
+	Inventory.Populate(NumItems, NumNames);
+
+	// What SearchItemsByName did before the index: lower-case every name on every call
+	auto SearchByScan = [&Inventory](const FString& SearchText)
+	{
+		TArray<UInventoryItemData*> Results;
+		const FString Needle = SearchText.ToLower();
+		for (UInventoryItemData* Item : Inventory->GetItems())
+		{
+			if (Item->GetItemName().ToString().ToLower().Contains(Needle))
+			{
+				Results.Add(Item);
+			}
+		}
+		return Results;
+	};
+
+	// A rare substring, a common one, one everything matches, a short one and a miss
+	for (const TCHAR* Query : { TEXT("item 4321"), TEXT("item 12"), TEXT("test"), TEXT("7"), TEXT("sword") })
+	{
+		const TArray<UInventoryItemData*> Expected = SearchByScan(Query);
+		TArray<UInventoryItemData*> Found = Inventory->SearchItemsByName(Query);
+		TestTrue(FString::Printf(TEXT("'%s' finds the same items in the same order as a scan"), Query), Found == Expected);
+
+		const double ScanSeconds = TimePerCall(Iterations, [&]() { Found = SearchByScan(Query); });
+		const double IndexSeconds = TimePerCall(Iterations, [&]() { Found = Inventory->SearchItemsByName(Query); });
+		AddInfo(FString::Printf(TEXT("'%s': %d matches - index %.1f us, scan %.1f us (%.0fx)"),
+			Query, Expected.Num(), IndexSeconds * 1e6, ScanSeconds * 1e6, ScanSeconds / FMath::Max(IndexSeconds, 1e-9)));
+
+		// Matching everything still has to return everything; a selective query must beat the scan
+		if (Expected.Num() < NumItems / 10)
+		{
+			TestTrue(FString::Printf(TEXT("'%s' is faster through the index"), Query), IndexSeconds < ScanSeconds);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,151 @@
+// InventorySnapshotTests.cpp
+// Read snapshots under concurrent readers
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySnapshotParallelReadersTest, "AdaptiveInventory.Snapshot.ParallelReaders",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventorySnapshotParallelReadersTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+
+	constexpr int32 NumItems = 2000;
+	constexpr int32 NumReaders = 4;
+	constexpr int32 NumMutations = 4000;
+
+	FTestInventory Inventory;
+	UInventoryItemDefinition* Definition = Inventory.AddDefinition(TEXT("Arrow"), EItemCategory::Consumable, EItemRarity::Common, 1000);
+
+	// Full stacks, so auto-stacking leaves each add in its own slot
+	TArray<UInventoryItemData*> Stacks;
+	{
+		FInventoryBatchScope BatchScope(&*Inventory);
+		for (int32 Index = 0; Index < NumItems; Index++)
+		{
+			UInventoryItemData* Item = Inventory.MakeItem(Definition, 1000);
+			Inventory->AddItem(Item);
+			Stacks.Add(Item);
+		}
+	}
+	Inventory->SetReadSnapshotsEnabled(true);
+
+	// Readers record what each snapshot version claimed; the game thread records what it should be
+	struct FReaderResult
+	{
+		TArray<TPair<uint64, int32>> Samples;
+		int32 NumReads = 0;
+		int32 NumTornSnapshots = 0;
+		int32 NumVersionRegressions = 0;
+	};
+	TArray<FReaderResult> Results;
+	Results.SetNum(NumReaders);
+	std::atomic<bool> bStop{ false };
+
+	TArray<UE::Tasks::FTask> Readers;
+	for (int32 ReaderIndex = 0; ReaderIndex < NumReaders; ReaderIndex++)
+	{
+		Readers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Inventory, &bStop, &Result = Results[ReaderIndex]]()
+		{
+			uint64 LastVersion = 0;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				const FInventorySnapshotPtr Snapshot = Inventory->AcquireSnapshot();
+				if (!Snapshot)
+				{
+					continue;
+				}
+
+				// Rows are shared between snapshots - a row changed in place would break the total
+				int32 Quantity = 0;
+				for (const FInventorySnapshotItemRef& Row : Snapshot->GetItems())
+				{
+					Quantity += Row->StackSize;
+				}
+				Result.NumTornSnapshots += Quantity != Snapshot->GetTotalItemQuantity();
+				Result.NumVersionRegressions += Snapshot->GetVersion() < LastVersion;
+				LastVersion = Snapshot->GetVersion();
+
+				if (Result.Samples.Num() == 0 || Result.Samples.Last().Key != Snapshot->GetVersion())
+				{
+					Result.Samples.Emplace(Snapshot->GetVersion(), Quantity);
+				}
+				Result.NumReads++;
+			}
+		}));
+	}
+
+	// Game thread: direct stack edits (no batch) plus batched moves between stacks
+	TMap<uint64, int32> ExpectedTotals;
+	ExpectedTotals.Add(Inventory->AcquireSnapshot()->GetVersion(), Inventory->GetTotalItemQuantity());
+
+	FRandomStream Random(2024);
+	int32 NumStaleAfterDirectEdit = 0;
+	for (int32 Mutation = 0; Mutation < NumMutations; Mutation++)
+	{
+		UInventoryItemData* Item = Stacks[Random.RandRange(0, NumItems - 1)];
+		if (Mutation % 2 == 0)
+		{
+			// The regression: a direct call updated the totals but never reached the snapshot
+			if (Random.RandBool())
+			{
+				Item->AddToStack(Random.RandRange(1, 10));
+			}
+			else
+			{
+				Item->RemoveFromStack(Random.RandRange(1, 10));
+			}
+
+			const FInventorySnapshotPtr Latest = Inventory->AcquireSnapshot();
+			const FInventorySnapshotItem* Row = Latest->FindItemByGUID(Item->GetItemGUID());
+			NumStaleAfterDirectEdit += !Row || Row->StackSize != Item->GetCurrentStackSize();
+		}
+		else
+		{
+			UInventoryItemData* Other = Stacks[Random.RandRange(0, NumItems - 1)];
+			FInventoryBatchScope BatchScope(&*Inventory);
+			if (Item != Other && Item->RemoveFromStack(5))
+			{
+				Other->AddToStack(5);
+			}
+		}
+
+		const FInventorySnapshotPtr Latest = Inventory->AcquireSnapshot();
+		ExpectedTotals.Add(Latest->GetVersion(), Inventory->GetTotalItemQuantity());
+	}
+
+	bStop = true;
+	UE::Tasks::Wait(Readers);
+
+	int32 NumReads = 0;
+	int32 NumSamples = 0;
+	int32 NumWrongTotals = 0;
+	for (const FReaderResult& Result : Results)
+	{
+		NumReads += Result.NumReads;
+		TestEqual(TEXT("Snapshot rows always add up to the snapshot total"), Result.NumTornSnapshots, 0);
+		TestEqual(TEXT("A reader never sees an older snapshot after a newer one"), Result.NumVersionRegressions, 0);
+
+		for (const TPair<uint64, int32>& Sample : Result.Samples)
+		{
+			const int32* Expected = ExpectedTotals.Find(Sample.Key);
+			NumWrongTotals += Expected && *Expected != Sample.Value;
+			NumSamples++;
+		}
+	}
+
+	TestEqual(TEXT("Snapshot follows direct AddToStack/RemoveFromStack calls"), NumStaleAfterDirectEdit, 0);
+	TestEqual(TEXT("Each snapshot version holds the quantities it was published with"), NumWrongTotals, 0);
+	TestTrue(TEXT("Readers ran"), NumReads > 0);
+
+	AddInfo(FString::Printf(TEXT("%d readers: %d snapshot reads, %d distinct versions sampled over %d mutations"),
+		NumReaders, NumReads, NumSamples, NumMutations));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,106 @@
+// InventorySpatialGridTests.cpp
+// Grid containers: placement query cost on a stash-sized grid
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "Core/InventorySpatialGrid.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace InventorySpatialGridTests
+{
+	constexpr int32 StashWidth = 20;
+	constexpr int32 StashHeight = 40;
+
+	/** Drop random footprints at random free spots until roughly Fraction of the cells are taken */
+	void FillRandomly(FInventorySpatialGrid& Grid, float Fraction, FRandomStream& Random)
+	{
+		const int32 TargetFreeCells = FMath::RoundToInt(StashWidth * StashHeight * (1.0f - Fraction));
+		for (int32 Attempt = 0; Attempt < 100000 && Grid.GetNumFreeCells() > TargetFreeCells; Attempt++)
+		{
+			const FIntPoint Size(Random.RandRange(1, 3), Random.RandRange(1, 4));
+			const FIntPoint Position(Random.RandRange(0, StashWidth - Size.X), Random.RandRange(0, StashHeight - Size.Y));
+			if (Grid.IsAreaFree(Position, Size))
+			{
+				Grid.Fill(Position, Size);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryPlacementBenchmarkTest, "AdaptiveInventory.Grid.PlacementOn20x40Stash",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryPlacementBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+	using namespace InventorySpatialGridTests;
+
+	constexpr int32 Iterations = 100000;
+	const FIntPoint Sizes[] = { FIntPoint(1, 1), FIntPoint(2, 3), FIntPoint(4, 4) };
+
+	struct FScenario
+	{
+		const TCHAR* Name;
+		FInventorySpatialGrid Grid;
+	};
+	FScenario Scenarios[3] = { { TEXT("empty") }, { TEXT("half full") }, { TEXT("full but for single cells") } };
+
+	FRandomStream Random(15);
+	for (FScenario& Scenario : Scenarios)
+	{
+		Scenario.Grid.Init(StashWidth, StashHeight);
+	}
+	FillRandomly(Scenarios[1].Grid, 0.5f, Random);
+
+	// Nothing larger than a cell fits anywhere, so every query but 1x1 scans the whole grid and fails
+	FInventorySpatialGrid& FullGrid = Scenarios[2].Grid;
+	FullGrid.Fill(FIntPoint::ZeroValue, FIntPoint(StashWidth, StashHeight));
+	for (int32 Y = 0; Y < StashHeight; Y += 2)
+	{
+		FullGrid.Clear(FIntPoint((Y * 7) % StashWidth, Y), FIntPoint(1, 1));
+	}
+
+	double SlowestQuerySeconds = 0.0;
+	for (const FScenario& Scenario : Scenarios)
+	{
+		for (const FIntPoint& Size : Sizes)
+		{
+			FIntPoint Position;
+			bool bRotated = false;
+			const bool bFits = Scenario.Grid.FindPlacement(Size, true, EInventoryPlacementMode::FirstFit, Position, bRotated);
+
+			// Results are summed so the queries can't be optimized away
+			int32 NumFound = 0;
+
+			const double FirstFitSeconds = TimePerCall(Iterations, [&]()
+			{
+				NumFound += Scenario.Grid.FindPlacement(Size, true, EInventoryPlacementMode::FirstFit, Position, bRotated);
+			});
+			const double BestFitSeconds = TimePerCall(Iterations, [&]()
+			{
+				NumFound += Scenario.Grid.FindPlacement(Size, true, EInventoryPlacementMode::BestFit, Position, bRotated);
+			});
+
+			// What a drag preview asks on every cursor move
+			const FIntPoint Probe(Random.RandRange(0, StashWidth - Size.X), Random.RandRange(0, StashHeight - Size.Y));
+			const double AreaFreeSeconds = TimePerCall(Iterations, [&]()
+			{
+				NumFound += Scenario.Grid.IsAreaFree(Probe, Size);
+			});
+
+			AddInfo(FString::Printf(TEXT("%dx%d stash, %s, %dx%d item: first fit %.0f ns, best fit %.0f ns, area test %.0f ns (%s)"),
+				StashWidth, StashHeight, Scenario.Name, Size.X, Size.Y, FirstFitSeconds * 1e9, BestFitSeconds * 1e9, AreaFreeSeconds * 1e9,
+				bFits ? TEXT("fits") : TEXT("doesn't fit")));
+			TestTrue(TEXT("Queries ran"), NumFound >= 0);
+
+			SlowestQuerySeconds = FMath::Max3(SlowestQuerySeconds, FirstFitSeconds, AreaFreeSeconds);
+		}
+	}
+
+	// Best fit scores every free spot, so it is reported rather than held to the bound
+	TestTrue(TEXT("First-fit placement and area tests stay under a microsecond"), SlowestQuerySeconds < 1e-6);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,25 @@
+// InventoryTestReplicationComponent.h
+// A replication component that lets clients remove from the shared inventory - the client side of the command batching test
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/InventoryReplicationComponent.h"
+#include "Core/InventoryCommand.h"
+#include "InventoryTestReplicationComponent.generated.h"
+
+/**
+ * Accepts every client removal, standing in for a game that checks which items a player may
+ * take. Adds are still refused, as the base component does. Only used by the automation tests.
+ */
+UCLASS()
+class UInventoryTestReplicationComponent : public UInventoryReplicationComponent
+{
+	GENERATED_BODY()
+
+protected:
+	virtual bool ValidateCommand(const FInventoryCommand& Command) const override
+	{
+		return Command.Op != EInventoryCommandOp::Add;
+	}
+};
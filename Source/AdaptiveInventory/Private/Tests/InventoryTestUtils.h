@@ -0,0 +1,314 @@
+// InventoryTestUtils.h
+// Shared setup for the inventory automation tests
+
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Core/InventoryManagerSubsystem.h"
+#include "Core/InventoryItemData.h"
+#include "Core/InventoryItemDefinition.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace InventoryTests
+{
+	/** Create and register a definition, outered to Outer */
+	inline UInventoryItemDefinition* AddDefinition(UInventoryManagerSubsystem& Manager, UObject* Outer, const FString& Name,
+		EItemCategory Category = EItemCategory::Material, EItemRarity Rarity = EItemRarity::Common, int32 MaxStackSize = 1)
+	{
+		UInventoryItemDefinition* Definition = NewObject<UInventoryItemDefinition>(Outer);
+		Definition->DefinitionId = FName(*Name);
+		Definition->DisplayName = FText::FromString(Name);
+		Definition->Category = Category;
+		Definition->Rarity = Rarity;
+		Definition->bIsStackable = MaxStackSize > 1;
+		Definition->MaxStackSize = MaxStackSize;
+		Definition->Weight = 0.5f;
+		Manager.RegisterItemDefinition(Definition);
+		return Definition;
+	}
+
+	/** A new, unstored item of a definition */
+	inline UInventoryItemData* MakeItem(UObject* Outer, UInventoryItemDefinition* Definition, int32 StackSize = 1)
+	{
+		UInventoryItemData* Item = NewObject<UInventoryItemData>(Outer);
+		Item->InitializeFromDefinition(Definition, StackSize);
+		return Item;
+	}
+
+	/**
+	 * Fill an inventory with non-stacking items spread over a few definitions per category
+	 * @return The items, in inventory order
+	 */
+	inline TArray<UInventoryItemData*> Populate(UInventoryManagerSubsystem& Manager, UObject* Outer, int32 NumItems, int32 NumDefinitions = 40)
+	{
+		TArray<UInventoryItemDefinition*> Definitions;
+		for (int32 Index = 0; Index < NumDefinitions; Index++)
+		{
+			Definitions.Add(AddDefinition(Manager, Outer, FString::Printf(TEXT("Test Item %d"), Index),
+				static_cast<EItemCategory>(Index % 5), static_cast<EItemRarity>((Index / 5) % 5)));
+		}
+
+		TArray<UInventoryItemData*> Added;
+		Added.Reserve(NumItems);
+		FInventoryBatchScope BatchScope(&Manager);
+		for (int32 Index = 0; Index < NumItems; Index++)
+		{
+			UInventoryItemData* Item = MakeItem(Outer, Definitions[Index % NumDefinitions]);
+			Item->MinDamage = static_cast<float>(Index % 100);
+			if (Manager.AddItem(Item))
+			{
+				Added.Add(Item);
+			}
+		}
+		return Added;
+	}
+
+	/**
+	 * An inventory manager outside any world, for tests that don't need a running game
+	 * The game instance and manager are rooted for the fixture's lifetime, so a GC in the middle
+	 * of a test keeps them and everything the manager holds. Initialize isn't run, so
+	 * there is no icon cache and the config defaults are used as-is.
+	 * The per-item LogTemp lines are muted while it exists; warnings still show.
+	 */
+	class FTestInventory : public FNoncopyable
+	{
+	public:
+		explicit FTestInventory(int32 MaxSlots = 1000000)
+		{
+			PreviousLogVerbosity = LogTemp.GetVerbosity();
+			LogTemp.SetVerbosity(ELogVerbosity::Warning);
+
+			GameInstance = NewObject<UGameInstance>(GetTransientPackage());
+			GameInstance->AddToRoot();
+
+			Manager = NewObject<UInventoryManagerSubsystem>(GameInstance);
+			Manager->AddToRoot();
+			Manager->SetMaxInventorySlots(MaxSlots);
+		}
+
+		~FTestInventory()
+		{
+			Manager->Deinitialize();
+			Manager->RemoveFromRoot();
+			GameInstance->RemoveFromRoot();
+
+			LogTemp.SetVerbosity(PreviousLogVerbosity);
+		}
+
+		UInventoryManagerSubsystem* operator->() const { return Manager; }
+		UInventoryManagerSubsystem& operator*() const { return *Manager; }
+
+		UGameInstance* GetGameInstance() const { return GameInstance; }
+
+		/** Create and register a definition */
+		UInventoryItemDefinition* AddDefinition(const FString& Name, EItemCategory Category = EItemCategory::Material,
+			EItemRarity Rarity = EItemRarity::Common, int32 MaxStackSize = 1) const
+		{
+			return InventoryTests::AddDefinition(*Manager, GameInstance, Name, Category, Rarity, MaxStackSize);
+		}
+
+		/** A new, unstored item of a definition */
+		UInventoryItemData* MakeItem(UInventoryItemDefinition* Definition, int32 StackSize = 1) const
+		{
+			return InventoryTests::MakeItem(GameInstance, Definition, StackSize);
+		}
+
+		/** See InventoryTests::Populate */
+		TArray<UInventoryItemData*> Populate(int32 NumItems, int32 NumDefinitions = 40) const
+		{
+			return InventoryTests::Populate(*Manager, GameInstance, NumItems, NumDefinitions);
+		}
+
+	private:
+		UGameInstance* GameInstance = nullptr;
+		UInventoryManagerSubsystem* Manager = nullptr;
+		ELogVerbosity::Type PreviousLogVerbosity = ELogVerbosity::Log;
+	};
+
+	/**
+	 * A standalone game instance with its own world and initialized subsystems, for tests that
+	 * need what a running game has - widgets find its inventory manager the usual way
+	 */
+	class FTestGameInstance : public FNoncopyable
+	{
+	public:
+		FTestGameInstance()
+		{
+			PreviousLogVerbosity = LogTemp.GetVerbosity();
+			LogTemp.SetVerbosity(ELogVerbosity::Warning);
+
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone();
+		}
+
+		~FTestGameInstance()
+		{
+			UWorld* World = GameInstance->GetWorld();
+			GameInstance->Shutdown();
+			if (World)
+			{
+				GEngine->DestroyWorldContext(World);
+				World->DestroyWorld(false);
+			}
+			GameInstance->RemoveFromRoot();
+
+			LogTemp.SetVerbosity(PreviousLogVerbosity);
+		}
+
+		UGameInstance* GetGameInstance() const { return GameInstance; }
+		UInventoryManagerSubsystem& GetManager() const { return *GameInstance->GetSubsystem<UInventoryManagerSubsystem>(); }
+
+	private:
+		UGameInstance* GameInstance = nullptr;
+		ELogVerbosity::Type PreviousLogVerbosity = ELogVerbosity::Log;
+	};
+
+	/**
+	 * Counts the heap allocations made on the game thread while it exists
+	 * GMalloc is routed through a forwarding proxy meanwhile; other threads pass through uncounted.
+	 * The proxy outlives the scope, so a thread still holding it after GMalloc is restored is fine.
+	 */
+	class FScopedAllocationCounter : public FNoncopyable
+	{
+	public:
+		FScopedAllocationCounter()
+		{
+			FCountingMalloc& Proxy = FCountingMalloc::Get();
+			check(GMalloc != &Proxy);
+			Proxy.Inner = GMalloc;
+			Proxy.NumAllocations = 0;
+			GMalloc = &Proxy;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			GMalloc = FCountingMalloc::Get().Inner;
+		}
+
+		int32 GetCount() const { return FCountingMalloc::Get().NumAllocations; }
+
+	private:
+		class FCountingMalloc final : public FMalloc
+		{
+		public:
+			static FCountingMalloc& Get()
+			{
+				static FCountingMalloc Instance;
+				return Instance;
+			}
+
+			virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountOnGameThread();
+				return Inner->Malloc(Count, Alignment);
+			}
+
+			virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountOnGameThread();
+				return Inner->TryMalloc(Count, Alignment);
+			}
+
+			virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				// Shrinking or freeing through Realloc isn't a new allocation
+				SIZE_T OriginalSize = 0;
+				if (Count > 0 && (!Original || !Inner->GetAllocationSize(Original, OriginalSize) || Count > OriginalSize))
+				{
+					CountOnGameThread();
+				}
+				return Inner->Realloc(Original, Count, Alignment);
+			}
+
+			virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				CountOnGameThread();
+				return Inner->TryRealloc(Original, Count, Alignment);
+			}
+
+			virtual void Free(void* Original) override { Inner->Free(Original); }
+			virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+			virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+			virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+			virtual const TCHAR* GetDescriptiveName() override { return TEXT("InventoryTests counting proxy"); }
+
+			FMalloc* Inner = nullptr;
+			int32 NumAllocations = 0;
+
+		private:
+			void CountOnGameThread()
+			{
+				NumAllocations += IsInGameThread() ? 1 : 0;
+			}
+		};
+	};
+
+	/** A save file path under the automation transient directory */
+	inline FString GetTestSavePath(const TCHAR* Name)
+	{
+		return FPaths::AutomationTransientDir() / Name;
+	}
+
+	/** Delete a test save and its journal */
+	inline void DeleteSave(const FString& SavePath)
+	{
+		IFileManager::Get().Delete(*SavePath, false, false, true);
+		IFileManager::Get().Delete(*(SavePath + TEXT(".journal")), false, false, true);
+	}
+
+	/** Everything a save has to bring back for one item */
+	struct FItemState
+	{
+		FGuid ItemGUID;
+		FName DefinitionId;
+		int32 StackSize = 0;
+		float Durability = 0.0f;
+
+		bool operator==(const FItemState& Other) const
+		{
+			return ItemGUID == Other.ItemGUID && DefinitionId == Other.DefinitionId &&
+				StackSize == Other.StackSize && Durability == Other.Durability;
+		}
+	};
+
+	/** The inventory's items, in order */
+	inline TArray<FItemState> CaptureState(const UInventoryManagerSubsystem& Manager)
+	{
+		TArray<FItemState> State;
+		State.Reserve(Manager.GetItemCount());
+		for (const UInventoryItemData* Item : Manager.GetItems())
+		{
+			const UInventoryItemDefinition* Definition = Item->GetItemDefinition();
+			State.Add({ Item->GetItemGUID(), Definition ? Definition->GetDefinitionId() : NAME_None, Item->GetCurrentStackSize(), Item->CurrentDurability });
+		}
+		return State;
+	}
+
+	/**
+	 * Average seconds per call of Body over Iterations calls (after one warm-up call)
+	 */
+	template<typename BodyType>
+	double TimePerCall(int32 Iterations, BodyType&& Body)
+	{
+		Body();
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Body();
+		}
+		return (FPlatformTime::Seconds() - StartTime) / FMath::Max(1, Iterations);
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
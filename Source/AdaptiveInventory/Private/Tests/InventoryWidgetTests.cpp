@@ -0,0 +1,187 @@
+// InventoryWidgetTests.cpp
+// Grid widgets: what a refresh costs once the grid is up, and what a frame costs in Slate against UMG
+
+#include "Misc/AutomationTest.h"
+#include "InventoryTestUtils.h"
+#include "InventoryDesignedSlotWidget.h"
+#include "UI/InventoryGridWidget.h"
+#include "UI/InventorySlotWidget.h"
+#include "UI/SInventoryGrid.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/UniformGridPanel.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Input/HittestGrid.h"
+#include "Misc/App.h"
+#include "Rendering/DrawElements.h"
+#include "Types/PaintArgs.h"
+#include "Widgets/SVirtualWindow.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace InventoryWidgetTests
+{
+	/** Set one of the grid's designer-bound properties, as its widget blueprint would */
+	void SetGridProperty(UInventoryGridWidget* Grid, FName PropertyName, UObject* Value)
+	{
+		FObjectPropertyBase* Property = CastFieldChecked<FObjectPropertyBase>(UInventoryGridWidget::StaticClass()->FindPropertyByName(PropertyName));
+		Property->SetObjectPropertyValue_InContainer(Grid, Value);
+	}
+
+	/**
+	 * A UMG grid with native slots, standing in for a widget blueprint: a uniform grid panel as
+	 * SlotGrid and UInventorySlotWidget as the slot class. Constructed, so it is bound and populated.
+	 */
+	UInventoryGridWidget* CreateGrid(UGameInstance* GameInstance, TSharedPtr<SWidget>& OutSlateWidget,
+		TSubclassOf<UInventorySlotWidget> SlotWidgetClass = UInventorySlotWidget::StaticClass())
+	{
+		UInventoryGridWidget* Grid = CreateWidget<UInventoryGridWidget>(GameInstance, UInventoryGridWidget::StaticClass());
+		UUniformGridPanel* SlotGrid = Grid->WidgetTree->ConstructWidget<UUniformGridPanel>();
+		Grid->WidgetTree->RootWidget = SlotGrid;
+		SetGridProperty(Grid, TEXT("SlotGrid"), SlotGrid);
+		SetGridProperty(Grid, TEXT("SlotWidgetClass"), SlotWidgetClass);
+
+		OutSlateWidget = Grid->TakeWidget();
+		return Grid;
+	}
+
+	/** Average prepass and paint of a widget in an offscreen window, as the viewport runs them every frame */
+	void TimeFrame(const TSharedRef<SWidget>& Widget, const FVector2D& WindowSize, int32 Iterations,
+		double& OutPrepassSeconds, double& OutPaintSeconds)
+	{
+		TSharedRef<SVirtualWindow> Window = SNew(SVirtualWindow).Size(WindowSize);
+		Window->SetContent(Widget);
+		Window->GetHittestGrid().SetHittestArea(FVector2D::ZeroVector, WindowSize);
+
+		const FGeometry WindowGeometry = FGeometry::MakeRoot(WindowSize, FSlateLayoutTransform());
+		const FSlateRect CullingRect(FVector2D::ZeroVector, WindowSize);
+		FSlateWindowElementList DrawElements(Window);
+
+		OutPrepassSeconds = InventoryTests::TimePerCall(Iterations, [&]() { Window->SlatePrepass(1.0f); });
+		OutPaintSeconds = InventoryTests::TimePerCall(Iterations, [&]()
+		{
+			DrawElements.ResetElementList();
+			Window->GetHittestGrid().Clear();
+			FPaintArgs PaintArgs(nullptr, Window->GetHittestGrid(), FVector2D::ZeroVector, FApp::GetCurrentTime(), FApp::GetDeltaTime());
+			Window->Paint(PaintArgs, WindowGeometry, CullingRect, DrawElements, 0, FWidgetStyle(), true);
+		});
+
+		Window->SetContent(SNullWidget::NullWidget);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySteadyRefreshAllocationTest, "AdaptiveInventory.Widgets.SteadyRefreshDoesNotAllocate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FInventorySteadyRefreshAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+	using namespace InventoryWidgetTests;
+
+	constexpr int32 NumItems = 2000;
+	constexpr int32 NumRefreshes = 100;
+
+	FTestGameInstance Game;
+	UInventoryManagerSubsystem& Manager = Game.GetManager();
+	Manager.SetMaxInventorySlots(NumItems);
+	Populate(Manager, Game.GetGameInstance(), NumItems);
+
+	TSharedPtr<SWidget> SlateWidget;
+	UInventoryGridWidget* Grid = CreateGrid(Game.GetGameInstance(), SlateWidget);
+	TestEqual(TEXT("Grid shows the inventory"), Grid->GetDisplayedItems().Num(), NumItems);
+	TestNotNull(TEXT("Grid has slots"), Grid->GetSlotAtIndex(0));
+
+	// Everything has been sized by the first populate; from here refreshes reuse it
+	auto CountRefreshAllocations = [Grid]()
+	{
+		Grid->RefreshWidget();
+		FScopedAllocationCounter Counter;
+		for (int32 Refresh = 0; Refresh < NumRefreshes; Refresh++)
+		{
+			Grid->RefreshWidget();
+		}
+		return Counter.GetCount();
+	};
+
+	TestEqual(TEXT("Unfiltered refreshes allocate nothing"), CountRefreshAllocations(), 0);
+
+	Grid->SetCategoryFilter(EItemCategory::Weapon);
+	TestEqual(TEXT("Filtered refreshes allocate nothing"), CountRefreshAllocations(), 0);
+
+	// The read API the refresh is built on, including the Blueprint index loop
+	int32 NumRead = 0;
+	int32 NumAllocations = 0;
+	{
+		FScopedAllocationCounter Counter;
+		for (const UInventoryItemData* Item : Manager.GetItems())
+		{
+			NumRead += Item != nullptr;
+		}
+		for (int32 Index = 0; Index < Manager.GetItemCount(); Index++)
+		{
+			NumRead += Manager.GetItemAt(Index) != nullptr;
+		}
+		NumRead += Manager.GetItemsByCategoryView(EItemCategory::Weapon).Num();
+		NumAllocations = Counter.GetCount();
+	}
+	TestEqual(TEXT("Reading items allocates nothing"), NumAllocations, 0);
+	TestTrue(TEXT("Every item was read"), NumRead > NumItems * 2);
+
+	Grid->RemoveFromParent();
+	SlateWidget.Reset();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryGridFrameBenchmarkTest, "AdaptiveInventory.Widgets.SlateVsUMGFrame",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryGridFrameBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryTests;
+	using namespace InventoryWidgetTests;
+
+	// A full 5-column character inventory, every slot on screen so neither side can cull
+	constexpr int32 NumItems = 200;
+	constexpr int32 Iterations = 200;
+	const FVector2D WindowSize(1024.0f, 8192.0f);
+
+	if (!FSlateApplication::IsInitialized())
+	{
+		AddInfo(TEXT("No Slate application (null RHI / commandlet) - nothing to paint"));
+		return true;
+	}
+
+	FTestGameInstance Game;
+	UInventoryManagerSubsystem& Manager = Game.GetManager();
+	Manager.SetMaxInventorySlots(NumItems);
+	Populate(Manager, Game.GetGameInstance(), NumItems);
+
+	// One Slate widget painting every slot
+	TSharedRef<SInventoryGrid> SlateGrid = SNew(SInventoryGrid).Columns(5);
+	SlateGrid->SetItems(Manager.GetItems());
+	double SlatePrepassSeconds = 0.0;
+	double SlatePaintSeconds = 0.0;
+	TimeFrame(SlateGrid, WindowSize, Iterations, SlatePrepassSeconds, SlatePaintSeconds);
+
+	// A UserWidget per slot, each a border, overlay, three images and a text block
+	TSharedPtr<SWidget> UMGWidget;
+	UInventoryGridWidget* UMGGrid = CreateGrid(Game.GetGameInstance(), UMGWidget, UInventoryDesignedSlotWidget::StaticClass());
+	TestEqual(TEXT("UMG grid shows the inventory"), UMGGrid->GetDisplayedItems().Num(), NumItems);
+	double UMGPrepassSeconds = 0.0;
+	double UMGPaintSeconds = 0.0;
+	TimeFrame(UMGWidget.ToSharedRef(), WindowSize, Iterations, UMGPrepassSeconds, UMGPaintSeconds);
+
+	const double SlateFrameSeconds = SlatePrepassSeconds + SlatePaintSeconds;
+	const double UMGFrameSeconds = UMGPrepassSeconds + UMGPaintSeconds;
+	AddInfo(FString::Printf(TEXT("%d slots: Slate grid prepass %.1f us, paint %.1f us; UMG grid prepass %.1f us, paint %.1f us (%.1fx per frame)"),
+		NumItems, SlatePrepassSeconds * 1e6, SlatePaintSeconds * 1e6, UMGPrepassSeconds * 1e6, UMGPaintSeconds * 1e6,
+		UMGFrameSeconds / FMath::Max(SlateFrameSeconds, 1e-9)));
+
+	TestTrue(TEXT("The Slate grid prepasses and paints faster than the UMG grid"), SlateFrameSeconds < UMGFrameSeconds);
+
+	UMGGrid->RemoveFromParent();
+	UMGWidget.Reset();
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -85,6 +85,7 @@ void UInventoryWidgetBase::BindInventoryEvents_Implementation()
 	InventoryManager->OnItemAdded.AddDynamic(this, &UInventoryWidgetBase::OnItemAdded);
 	InventoryManager->OnItemRemoved.AddDynamic(this, &UInventoryWidgetBase::OnItemRemoved);
 	InventoryManager->OnItemStackChanged.AddDynamic(this, &UInventoryWidgetBase::OnItemStackChanged);
+	InventoryManager->OnInventoryBatchChanged.AddDynamic(this, &UInventoryWidgetBase::OnInventoryBatchChanged);
 
 	bEventsBound = true;
 
@@ -105,6 +106,7 @@ void UInventoryWidgetBase::UnbindInventoryEvents_Implementation()
 		InventoryManager->OnItemAdded.RemoveDynamic(this, &UInventoryWidgetBase::OnItemAdded);
 		InventoryManager->OnItemRemoved.RemoveDynamic(this, &UInventoryWidgetBase::OnItemRemoved);
 		InventoryManager->OnItemStackChanged.RemoveDynamic(this, &UInventoryWidgetBase::OnItemStackChanged);
+		InventoryManager->OnInventoryBatchChanged.RemoveDynamic(this, &UInventoryWidgetBase::OnInventoryBatchChanged);
 	}
 	
 	bEventsBound = false;
@@ -137,3 +139,9 @@ void UInventoryWidgetBase::OnItemStackChanged_Implementation(FGuid ItemGUID, int
 	// Base implementation delegates to general refresh
 	// Child classes can override for specific stack update behavior
 }
+
+void UInventoryWidgetBase::OnInventoryBatchChanged_Implementation(const FInventoryChangeDelta& Delta)
+{
+	// Base implementation does nothing - OnInventoryChanged follows and handles the refresh
+	// Child classes can override to react to exactly what changed
+}
@@ -8,6 +8,8 @@
 #include "InventoryItemData.h"
 #include "InventoryBlueprintLibrary.generated.h"
 
+class UInventoryItemDefinition;
+
 /**
  * Blueprint Function Library for Inventory System
  * Provides easy-to-use functions for creating items and testing
@@ -18,6 +20,54 @@ class ADAPTIVEINVENTORY_API UInventoryBlueprintLibrary : public UBlueprintFuncti
 	GENERATED_BODY()
 	
 public:
+	/**
+	 * Find or create the shared definition for an item type
+	 * Definitions are registered with the inventory manager, so every stack of the same
+	 * item shares one name/description instead of carrying its own copies.
+	 * Items only share a definition when all of these match exactly (text is case-sensitive).
+	 * @param WorldContextObject - World context (automatically provided in Blueprints)
+	 * @param ItemName - Display name of the item
+	 * @param ItemDescription - Description text
+	 * @param Category - Item category
+	 * @param Rarity - Item rarity
+	 * @param bStackable - Whether this item can stack
+	 * @param MaxStackSize - Maximum stack size (ignored if not stackable)
+	 * @return The shared definition, or nullptr if the inventory manager is unavailable
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Creation",
+		meta = (WorldContext = "WorldContextObject"))
+	static UInventoryItemDefinition* GetOrCreateItemDefinition(
+		UObject* WorldContextObject,
+		FText ItemName,
+		FText ItemDescription,
+		EItemCategory Category,
+		EItemRarity Rarity,
+		bool bStackable = false,
+		int32 MaxStackSize = 1);
+	
+	/**
+	 * Build the ID GetOrCreateItemDefinition registers an item type under
+	 * FName compares case-insensitively, so the exact name and description go in as a
+	 * case-sensitive hash - "Potion" and "potion" get different IDs.
+	 * @return Definition ID for this combination of fields
+	 */
+	static FName MakeItemDefinitionId(const FText& ItemName, const FText& ItemDescription, EItemCategory Category,
+		EItemRarity Rarity, int32 MaxStackSize);
+	
+	/**
+	 * Create a new item instance from a shared definition
+	 * @param WorldContextObject - World context
+	 * @param Definition - The item definition
+	 * @param StackSize - Starting stack size
+	 * @return The created item data object
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Creation",
+		meta = (WorldContext = "WorldContextObject", Keywords = "make create spawn"))
+	static UInventoryItemData* CreateItemFromDefinition(
+		UObject* WorldContextObject,
+		UInventoryItemDefinition* Definition,
+		int32 StackSize = 1);
+	
 	/**
 	 * Create a new inventory item with specified properties
 	 * @param WorldContextObject - World context (automatically provided in Blueprints)
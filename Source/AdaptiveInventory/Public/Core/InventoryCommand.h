@@ -0,0 +1,72 @@
+// InventoryCommand.h
+// A single inventory operation as queued by a client and sent to the server in a batch
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryCommand.generated.h"
+
+class UInventoryItemDefinition;
+class UInventoryManagerSubsystem;
+class UPackageMap;
+
+UENUM()
+enum class EInventoryCommandOp : uint8
+{
+	Add,
+	Remove,
+	RemoveQuantity
+};
+
+/**
+ * One queued inventory operation
+ *
+ * Adds carry the GUID the new item will get, chosen by the client, so a predicted item
+ * and the server's copy are the same item once the server state replicates back.
+ * Serialized packed: 2-bit op, varint sequence and quantity, and only the fields the op uses.
+ */
+USTRUCT()
+struct ADAPTIVEINVENTORY_API FInventoryCommand
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EInventoryCommandOp Op = EInventoryCommandOp::Add;
+
+	/** Client-assigned, increasing - the server acks the last one it processed */
+	UPROPERTY()
+	uint32 Sequence = 0;
+
+	UPROPERTY()
+	FGuid ItemGUID;
+
+	/** Add only */
+	UPROPERTY()
+	TObjectPtr<UInventoryItemDefinition> Definition = nullptr;
+
+	/** Add and RemoveQuantity */
+	UPROPERTY()
+	int32 Quantity = 0;
+
+	static FInventoryCommand MakeAdd(UInventoryItemDefinition* InDefinition, int32 InQuantity);
+	static FInventoryCommand MakeRemove(const FGuid& InItemGUID);
+	static FInventoryCommand MakeRemoveQuantity(const FGuid& InItemGUID, int32 InQuantity);
+
+	/**
+	 * Run the operation against an inventory
+	 * @param InventoryManager - Inventory to change
+	 * @return True if the operation succeeded
+	 */
+	bool Apply(UInventoryManagerSubsystem& InventoryManager) const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryCommand> : public TStructOpsTypeTraitsBase2<FInventoryCommand>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
@@ -0,0 +1,135 @@
+// InventoryFilterExpression.h
+// Filter expressions for inventory queries, compiled to a bitmask plan over a columnar item view
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryQuery.h"
+
+class FInventoryFilterParser;
+
+/**
+ * Item fields laid out as one array per field, for FInventoryFilterProgram
+ *
+ * Names are dictionary-encoded: each distinct normalized name is stored once and rows
+ * hold its index, so a name test runs once per distinct name instead of once per item.
+ * The view is a copy - rebuild it after the items change.
+ */
+class ADAPTIVEINVENTORY_API FInventoryColumnarView
+{
+public:
+	static constexpr int32 NumStats = 6;
+
+	/** Capture the items (null entries are skipped) */
+	void Build(TConstArrayView<UInventoryItemData*> InItems);
+
+	void Reset();
+
+	int32 Num() const { return Items.Num(); }
+
+	UInventoryItemData* GetItem(int32 Row) const { return Items[Row]; }
+
+	TConstArrayView<uint8> GetCategories() const { return Categories; }
+	TConstArrayView<uint8> GetRarities() const { return Rarities; }
+	TConstArrayView<float> GetStats(EInventoryItemStat Stat) const { return Stats[static_cast<int32>(Stat)]; }
+	TConstArrayView<int32> GetNameIds() const { return NameIds; }
+	TConstArrayView<FString> GetNames() const { return Names; }
+
+private:
+	TArray<UInventoryItemData*> Items;
+	TArray<uint8> Categories;
+	TArray<uint8> Rarities;
+	TArray<float> Stats[NumStats];
+
+	/** Per row, index into Names */
+	TArray<int32> NameIds;
+
+	/** Distinct normalized names */
+	TArray<FString> Names;
+};
+
+/**
+ * A compiled filter expression
+ *
+ * Syntax (keywords and field names are case-insensitive):
+ *   Weapon AND Rarity >= Rare AND MinDamage > 20 AND Name CONTAINS 'sword'
+ *   (Consumable OR Material) AND NOT StackSize < 5
+ *
+ * - A bare category or rarity name tests for it (Weapon = "Category = Weapon")
+ * - Category: = !=    Rarity: = != < <= > >= against a rarity name
+ * - StackSize, MinDamage, MaxDamage, AttackSpeed, Durability, Weight: = != < <= > >= against a number
+ * - Name: CONTAINS, = or != against a quoted string
+ * - NOT binds tightest, then AND, then OR; an empty expression matches everything
+ *
+ * Compiles to a flat postfix program. Category and rarity tests are folded into bitmasks of
+ * the accepted values at compile time. Evaluation runs each instruction over every row of
+ * a FInventoryColumnarView at once, producing one bit per row, and combines those bit sets
+ * 64 rows per operation.
+ */
+class ADAPTIVEINVENTORY_API FInventoryFilterProgram
+{
+public:
+	/**
+	 * Parse and compile an expression
+	 * @param Expression - Filter text
+	 * @param OutError - Why it failed to compile
+	 * @return The program, or null on an error
+	 */
+	static TSharedPtr<const FInventoryFilterProgram> Compile(const FString& Expression, FString& OutError);
+
+	/**
+	 * Run the filter over a view
+	 * @param View - Items to filter
+	 * @param OutItems - Receives the matching items in view order
+	 */
+	void Evaluate(const FInventoryColumnarView& View, TArray<UInventoryItemData*>& OutItems) const;
+
+	int32 GetNumInstructions() const { return Instructions.Num(); }
+
+private:
+	friend class FInventoryFilterParser;
+
+	enum class EOpCode : uint8
+	{
+		MatchAll,
+		CategoryMask,
+		RarityMask,
+		CompareStat,
+		NameContains,
+		NameEquals,
+		And,
+		Or,
+		Not
+	};
+
+	enum class ECompare : uint8
+	{
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual
+	};
+
+	struct FInstruction
+	{
+		EOpCode Op = EOpCode::MatchAll;
+		ECompare Compare = ECompare::Equal;
+		EInventoryItemStat Stat = EInventoryItemStat::StackSize;
+
+		/** Accepted values (CategoryMask/RarityMask), bit N = enum value N */
+		uint32 Mask = 0;
+
+		/** Operand for CompareStat */
+		float Value = 0.0f;
+
+		/** Lower-cased operand for the name ops */
+		FString Text;
+	};
+
+	TArray<FInstruction> Instructions;
+
+	/** Bit sets alive at once while evaluating */
+	int32 MaxStackDepth = 0;
+};
@@ -0,0 +1,81 @@
+// InventoryIconCache.h
+// Async icon streaming with an LRU-bounded set of resident icons
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Containers/List.h"
+
+class UTexture2D;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnInventoryIconLoaded, const FSoftObjectPath& /*IconPath*/);
+
+/**
+ * Streams item icons in on demand and keeps at most a budget of them resident
+ *
+ * A slot showing an icon pins it with Acquire and unpins it with Release. Unpinned icons stay
+ * loaded (so scrolling back is instant) in least-recently-released order, and the oldest are
+ * let go once more than MaxResidentIcons are held. Pinned icons are never dropped, so the budget
+ * can be exceeded while that many icons are on screen.
+ *
+ * Not a UObject - owned by UInventoryManagerSubsystem and shared with widgets.
+ */
+class ADAPTIVEINVENTORY_API FInventoryIconCache
+{
+public:
+	explicit FInventoryIconCache(int32 InMaxResidentIcons);
+	~FInventoryIconCache();
+
+	FInventoryIconCache(const FInventoryIconCache&) = delete;
+	FInventoryIconCache& operator=(const FInventoryIconCache&) = delete;
+
+	/**
+	 * Pin an icon, starting an async load if it isn't loaded yet
+	 * OnIconLoaded fires once the load completes.
+	 * @param Icon - Icon to pin (null icons are ignored)
+	 * @return The texture if it is already loaded, otherwise nullptr
+	 */
+	UTexture2D* Acquire(const TSoftObjectPtr<UTexture2D>& Icon);
+
+	/** Unpin an icon pinned with Acquire (it stays resident until evicted) */
+	void Release(const TSoftObjectPtr<UTexture2D>& Icon);
+
+	/** Change the resident-icon budget, evicting unpinned icons if now over it */
+	void SetMaxResidentIcons(int32 NewMax);
+	int32 GetMaxResidentIcons() const { return MaxResidentIcons; }
+
+	/** Icons currently held (loaded or loading) */
+	int32 GetNumResidentIcons() const { return Entries.Num(); }
+
+	/** Drop every icon, pinned or not, and cancel pending loads */
+	void Reset();
+
+	/** Fired when an icon finishes streaming in */
+	FOnInventoryIconLoaded OnIconLoaded;
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		int32 PinCount = 0;
+		/** Position in UnpinnedIcons while PinCount is 0 */
+		TDoubleLinkedList<FSoftObjectPath>::TDoubleLinkedListNode* LRUNode = nullptr;
+	};
+
+	void HandleIconLoaded(FSoftObjectPath IconPath);
+
+	/** Drop least recently released icons until within budget */
+	void TrimToBudget();
+
+	static void ReleaseHandle(const TSharedPtr<FStreamableHandle>& Handle);
+
+	FStreamableManager Streamable;
+
+	TMap<FSoftObjectPath, FEntry> Entries;
+
+	/** Unpinned icons, least recently released at the head */
+	TDoubleLinkedList<FSoftObjectPath> UnpinnedIcons;
+
+	int32 MaxResidentIcons = 0;
+};
@@ -6,6 +6,14 @@
 #include "UObject/NoExportTypes.h"
 #include "InventoryItemData.generated.h"
 
+class UInventoryItemDefinition;
+class UTexture2D;
+struct FInventoryItemInstance;
+class UInventoryItemData;
+
+// Native (C++ only) notification fired whenever an item's stack size changes, however it was changed
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnItemStackSizeChangedNative, UInventoryItemData* /*Item*/, int32 /*OldSize*/, int32 /*NewSize*/);
+
 /**
  *  Item Rarity
  */
@@ -36,6 +44,9 @@ enum class EItemCategory : uint8
 /**
  * Data class encapsulating all information about an inventory item
  * Follows Epic's UMG Best Practices - separates data from UI
+ *
+ * Items created from a UInventoryItemDefinition read their name, description and icon
+ * from the shared definition; the inline fields below are only used by items without one.
  */
 UCLASS(BlueprintType, Blueprintable)
 class ADAPTIVEINVENTORY_API UInventoryItemData : public UObject
@@ -45,6 +56,10 @@ class ADAPTIVEINVENTORY_API UInventoryItemData : public UObject
 public:
     UInventoryItemData();
 
+    // Shared definition (name, description, icon). Null for standalone items.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+    TObjectPtr<UInventoryItemDefinition> Definition;
+
     // Basic Item Info
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
     FText ItemName;
@@ -52,8 +67,9 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
     FText ItemDescription;
 
+    // Soft reference - streamed in by the icon cache when a slot shows it
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
-    UTexture2D* ItemIcon;
+    TSoftObjectPtr<UTexture2D> ItemIcon;
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
     EItemRarity ItemRarity;
@@ -96,13 +112,27 @@ public:
 
     // Public API Functions
     UFUNCTION(BlueprintCallable, Category = "Item Data")
-    FText GetItemName() const { return ItemName; }
+    FText GetItemName() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Item Data")
+    FText GetItemDescription() const;
 
+    // Icon texture if it is already loaded (nullptr while it hasn't been streamed in)
     UFUNCTION(BlueprintCallable, Category = "Item Data")
-    FText GetItemDescription() const { return ItemDescription; }
+    UTexture2D* GetItemIcon() const;
 
+    // Soft reference to the icon, for async loading
     UFUNCTION(BlueprintCallable, Category = "Item Data")
-    UTexture2D* GetItemIcon() const { return ItemIcon; }
+    TSoftObjectPtr<UTexture2D> GetItemIconAsset() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Item Data")
+    UInventoryItemDefinition* GetItemDefinition() const { return Definition; }
+
+    /**
+     * Lower-cased item name for search/filter matching
+     * Built once on first use (shared through the definition when there is one)
+     */
+    const FString& GetNormalizedName() const;
 
     UFUNCTION(BlueprintCallable, Category = "Item Data")
     EItemRarity GetItemRarity() const { return ItemRarity; }
@@ -119,6 +149,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Item Data")
     bool CanStack() const { return bIsStackable; }
 
+    // Cells the item takes in a grid container (from the definition; 1x1 without one)
+    UFUNCTION(BlueprintCallable, Category = "Item Data")
+    FIntPoint GetGridSize() const;
+
     UFUNCTION(BlueprintCallable, Category = "Item Data")
     FGuid GetItemGUID() const { return ItemGUID; }
 
@@ -139,6 +173,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Item Data")
     void SetStackSize(int32 NewSize);
 
+    /** Fired after AddToStack/RemoveFromStack/SetStackSize change the stack (used by the inventory indices) */
+    FOnItemStackSizeChangedNative OnStackSizeChanged;
+
+    // Definitions & instances
+
+    /**
+     * Bind this item to a shared definition and copy its scalar defaults
+     * Name, description and icon are read from the definition from then on
+     * @param InDefinition - The definition to use
+     * @param StackSize - Starting stack size (clamped to the definition's max)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Item Data")
+    void InitializeFromDefinition(UInventoryItemDefinition* InDefinition, int32 StackSize = 1);
+
+    /** Copy the per-instance state (GUID, stack, durability) into a compact value */
+    FInventoryItemInstance ToInstance() const;
+
+    /** Restore per-instance state from a compact value (the definition must already be set) */
+    void ApplyInstance(const FInventoryItemInstance& Instance);
+
     // Initialization
     virtual void PostInitProperties() override;
+
+private:
+    // Cached lower-cased name for items without a definition
+    mutable FString NormalizedNameCache;
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+// InventoryItemDefinition.h
+// Shared, immutable item definition and the small per-instance state that references it
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "InventoryItemData.h"
+#include "InventoryItemDefinition.generated.h"
+
+/**
+ * Immutable description of an item type (e.g. "Iron Ore")
+ * Every stack of the same item shares one definition instead of carrying its own
+ * copies of the name, description and icon.
+ *
+ * Usage:
+ * 1. Right-click Content Browser → Miscellaneous → Data Asset
+ * 2. Select InventoryItemDefinition
+ * 3. Fill in the shared item info and base stats
+ * 4. Create instances with UInventoryBlueprintLibrary::CreateItemFromDefinition
+ */
+UCLASS(BlueprintType)
+class ADAPTIVEINVENTORY_API UInventoryItemDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Stable identifier used for lookups and save data (falls back to the asset name when None) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	FName DefinitionId;
+
+	// Basic Item Info
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	FText DisplayName = FText::FromString(TEXT("New Item"));
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	FText Description;
+
+	/** Soft reference so definitions can be loaded without their icons */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	TSoftObjectPtr<UTexture2D> Icon;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	EItemRarity Rarity = EItemRarity::Common;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	EItemCategory Category = EItemCategory::Material;
+
+	// Stack Info
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info")
+	bool bIsStackable = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info", meta = (ClampMin = "1"))
+	int32 MaxStackSize = 1;
+
+	// Grid Footprint (cells taken in grid containers)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 GridWidth = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Info", meta = (ClampMin = "1"))
+	int32 GridHeight = 1;
+
+	// Base Stats (copied onto each instance, which may roll its own values)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Stats")
+	float MinDamage = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Stats")
+	float MaxDamage = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Stats")
+	float AttackSpeed = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Stats")
+	float MaxDurability = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Stats")
+	float Weight = 1.0f;
+
+	/** Get the identifier for this definition */
+	UFUNCTION(BlueprintCallable, Category = "Item Definition")
+	FName GetDefinitionId() const { return DefinitionId.IsNone() ? GetFName() : DefinitionId; }
+
+	/** Lower-cased display name for search/filter matching, built on first use */
+	const FString& GetNormalizedName() const;
+
+	//~ Begin UPrimaryDataAsset Interface
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	//~ End UPrimaryDataAsset Interface
+
+	/** Primary asset type all item definitions are registered under */
+	static const FPrimaryAssetType PrimaryAssetType;
+
+private:
+	/** Cached result of GetNormalizedName - definitions are immutable once in use */
+	mutable FString NormalizedNameCache;
+};
+
+/**
+ * Per-instance item state - everything that differs between two stacks of the same definition
+ * Compact value type for copying, saving and sending item state around
+ */
+USTRUCT(BlueprintType)
+struct ADAPTIVEINVENTORY_API FInventoryItemInstance
+{
+	GENERATED_BODY()
+
+	/** Shared definition this instance was created from */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Instance")
+	TObjectPtr<UInventoryItemDefinition> Definition = nullptr;
+
+	/** Unique ID for this item instance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Instance")
+	FGuid ItemGUID;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Instance")
+	int32 StackCount = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Instance")
+	float Durability = 100.0f;
+};
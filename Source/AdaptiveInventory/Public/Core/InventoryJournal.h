@@ -0,0 +1,148 @@
+// InventoryJournal.h
+// Append-only log of inventory mutations, replayed on top of the last full save
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/InventorySaveFormat.h"
+#include "Core/InventorySort.h"
+
+class IFileHandle;
+class UInventoryItemDefinition;
+
+/**
+ * Append-only journal used by UInventoryManagerSubsystem for low-cost persistence
+ *
+ * Each mutation is appended as a small checksummed record describing its effect
+ * (an add records the final item, an auto-stack records each stack's new size), so replay
+ * reproduces the exact state without re-running the stacking rules.
+ * The first add of each definition is preceded by a Define record, so a definition created
+ * after the base save can still be rebuilt on replay. A sort records only its criteria - replay
+ * re-runs the same stable sort on the same items, which gives the same order.
+ * An item entering or leaving a named container is one MoveToContainer record holding the slot it
+ * ended up in; an item added straight into a container is an Add followed by that move.
+ * Records are buffered in memory and only written/fsynced when Flush is called.
+ *
+ * The file header stores the payload CRC of the full save the journal applies to. After a
+ * compaction writes a new save, an old journal no longer matches it and is ignored on replay.
+ *
+ * Not a UObject - the owning subsystem drives it.
+ */
+class ADAPTIVEINVENTORY_API FInventoryJournal
+{
+public:
+	/** What a record describes */
+	enum class EOp : uint8
+	{
+		Add = 1,
+		Remove,
+		SetStack,
+		Move,
+		Swap,
+		Clear,
+		SetDurability,
+		Define,
+		Sort,
+		MoveToContainer,
+		CompactContainer
+	};
+
+	/** One decoded record */
+	struct FEntry
+	{
+		EOp Op = EOp::Clear;
+		FGuid ItemGUID;
+
+		/** Second item for Swap */
+		FGuid OtherGUID;
+
+		/** Definition for Add/Define */
+		FName DefinitionId;
+
+		/** How to rebuild the definition, for Define */
+		FInventorySavedDefinition SavedDefinition;
+
+		/** Target for MoveToContainer (None = default inventory), container for CompactContainer */
+		FName ContainerName;
+
+		/** Stack count for Add/SetStack, target index for Move, target slot for MoveToContainer */
+		int32 Value = 0;
+
+		/** Footprint turned, for MoveToContainer */
+		bool bRotated = false;
+
+		/** Durability for Add/SetDurability */
+		float Durability = 0.0f;
+
+		/** Keys for Sort */
+		TArray<FInventorySortCriterion> SortCriteria;
+	};
+
+	FInventoryJournal() = default;
+	~FInventoryJournal();
+
+	FInventoryJournal(const FInventoryJournal&) = delete;
+	FInventoryJournal& operator=(const FInventoryJournal&) = delete;
+
+	/**
+	 * Start a new, empty journal (replacing any existing file)
+	 * @param FilePath - Journal file
+	 * @param SnapshotCrc - Payload CRC of the full save this journal applies on top of
+	 * @return False if the file couldn't be created
+	 */
+	bool Open(const FString& FilePath, uint32 SnapshotCrc);
+
+	/** Flush (with fsync) and close the file */
+	void Close();
+
+	bool IsOpen() const { return FileHandle.IsValid(); }
+
+	// Record builders - buffered until the next Flush
+	void AppendAdd(const FGuid& ItemGUID, const UInventoryItemDefinition& Definition, int32 StackCount, float Durability);
+	void AppendRemove(const FGuid& ItemGUID);
+	void AppendSetStack(const FGuid& ItemGUID, int32 StackCount);
+	void AppendSetDurability(const FGuid& ItemGUID, float Durability);
+	void AppendMove(const FGuid& ItemGUID, int32 NewIndex);
+	void AppendSwap(const FGuid& FirstGUID, const FGuid& SecondGUID);
+	void AppendSort(TConstArrayView<FInventorySortCriterion> Criteria);
+	void AppendMoveToContainer(const FGuid& ItemGUID, FName ContainerName, int32 SlotIndex, bool bRotated);
+	void AppendCompactContainer(FName ContainerName);
+	void AppendClear();
+
+	/**
+	 * Write buffered records to the file
+	 * @param bSync - Also fsync, so the records survive a crash or power loss
+	 * @return False if the write failed
+	 */
+	bool Flush(bool bSync);
+
+	/** Any records waiting for Flush */
+	bool HasPendingRecords() const { return PendingBytes.Num() > 0; }
+
+	/** Records appended since Open (how much a compaction would save) */
+	int32 GetNumRecords() const { return NumRecords; }
+
+	/**
+	 * Read every intact record of a journal file
+	 * Stops quietly at a torn or corrupt record - that is the tail of an interrupted write.
+	 * @param FilePath - Journal file
+	 * @param OutSnapshotCrc - Receives the CRC of the save the journal applies to
+	 * @param OutEntries - Receives the records in order
+	 * @return False if the file is missing or not a journal
+	 */
+	static bool Read(const FString& FilePath, uint32& OutSnapshotCrc, TArray<FEntry>& OutEntries);
+
+private:
+	/** Frame a payload with its header and buffer it */
+	void AppendRecord(EOp Op, const TArray<uint8>& Payload);
+
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** Encoded records not yet written */
+	TArray<uint8> PendingBytes;
+
+	int32 NumRecords = 0;
+
+	/** Definitions with a Define record in this journal */
+	TSet<FName> DefinedIds;
+};
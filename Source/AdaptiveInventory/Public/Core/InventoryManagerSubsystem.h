@@ -5,14 +5,140 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "InventoryItemData.h"
+#include "InventorySearchIndex.h"
+#include "InventoryJournal.h"
+#include "InventorySpatialGrid.h"
+#include "InventorySort.h"
+#include "InventoryIconCache.h"
+#include "InventorySnapshot.h"
+#include "InventoryQuery.h"
+#include "InventoryFilterExpression.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Pipe.h"
 #include "InventoryManagerSubsystem.generated.h"
 
+class UInventoryItemDefinition;
+struct FInventorySaveView;
+struct FInventorySavedDefinition;
+
+/**
+ * Key identifying which stacks an item may merge with
+ * Definition-backed items match on definition ID; standalone items on exact name + category
+ */
+struct ADAPTIVEINVENTORY_API FInventoryStackKey
+{
+	FName DefinitionId;
+	FString Name;
+	EItemCategory Category = EItemCategory::Material;
+
+	/** Build the merge key for an item */
+	static FInventoryStackKey ForItem(const UInventoryItemData* Item);
+
+	friend bool operator==(const FInventoryStackKey& A, const FInventoryStackKey& B)
+	{
+		// Case-sensitive to match the previous FText::EqualTo behaviour
+		return A.DefinitionId == B.DefinitionId && A.Category == B.Category &&
+			A.Name.Equals(B.Name, ESearchCase::CaseSensitive);
+	}
+
+	friend uint32 GetTypeHash(const FInventoryStackKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.DefinitionId), FCrc::StrCrc32(*Key.Name)),
+			GetTypeHash(Key.Category));
+	}
+};
+
 // Delegate declarations - these broadcast events when inventory changes
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChanged);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemAdded, UInventoryItemData*, Item);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemRemoved, FGuid, ItemGUID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemStackChanged, FGuid, ItemGUID, int32, NewStackSize);
 
+/**
+ * Consolidated description of everything that changed during one batch of mutations
+ * An item added and removed within the same batch appears in neither list
+ */
+USTRUCT(BlueprintType)
+struct ADAPTIVEINVENTORY_API FInventoryChangeDelta
+{
+	GENERATED_BODY()
+
+	/** Items that entered the inventory */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FGuid> AddedItems;
+
+	/** Items that left the inventory */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FGuid> RemovedItems;
+
+	/** Items already in the inventory whose stack size changed */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FGuid> RestackedItems;
+
+	/** Items already in the inventory whose durability changed */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<FGuid> DurabilityChangedItems;
+
+	/** Items were moved, swapped, or shifted by a swap-remove filling the hole with the last item */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	bool bOrderChanged = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryBatchChanged, const FInventoryChangeDelta&, Delta);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnContainerItemAdded, FName, ContainerName, UInventoryItemData*, Item, int32, SlotIndex);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnContainerItemRemoved, FName, ContainerName, FGuid, ItemGUID, int32, SlotIndex);
+
+/**
+ * A named, fixed-capacity container (backpack, stash, equipment, quick-bar...)
+ * Holds references into the subsystem's item store - items are never copied between containers.
+ */
+USTRUCT()
+struct ADAPTIVEINVENTORY_API FInventoryContainer
+{
+	GENERATED_BODY()
+
+	/**
+	 * One entry per slot, null when empty. Sized to the capacity up front so moves never reallocate.
+	 * Grid containers have one slot per cell (Y * Width + X); an item sits in the slot of its top-left cell.
+	 */
+	UPROPERTY()
+	TArray<TObjectPtr<UInventoryItemData>> Slots;
+
+	/** Occupied slots */
+	int32 NumItems = 0;
+
+	/** Cell occupancy for grid containers (zero width for plain slot containers) */
+	FInventorySpatialGrid Grid;
+
+	/** How a grid container picks a spot when none is given */
+	EInventoryPlacementMode PlacementMode = EInventoryPlacementMode::FirstFit;
+
+	/** Do items take up a footprint of cells rather than one slot each */
+	bool IsSpatial() const { return Grid.GetWidth() > 0; }
+
+	/** First empty slot, or INDEX_NONE when full (plain slot containers) */
+	int32 FindFreeSlot() const;
+};
+
+/** Where an item in a named container lives */
+struct FInventoryItemLocation
+{
+	FName ContainerName;
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Footprint turned 90 degrees (grid containers) */
+	bool bRotated = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventorySaveCompleted, const FString&, FilePath, bool, bSuccess);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEncumbranceChanged, bool, bOverEncumbered, float, TotalWeight);
+
+// Callback for ForEachItem - visits one item at a time without copying the inventory
+DECLARE_DYNAMIC_DELEGATE_OneParam(FInventoryItemVisitor, UInventoryItemData*, Item);
+
 /**
  * Subsystem that manages the player's inventory
  * Handles adding, removing, searching, and organizing items
@@ -41,6 +167,51 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Inventory Events")
 	FOnItemStackChanged OnItemStackChanged;
 	
+	// Fired once per batch (or per standalone mutation) with everything that changed, just before OnInventoryChanged
+	UPROPERTY(BlueprintAssignable, Category = "Inventory Events")
+	FOnInventoryBatchChanged OnInventoryBatchChanged;
+	
+	// Fired when an item enters a named container (the default inventory uses OnItemAdded)
+	UPROPERTY(BlueprintAssignable, Category = "Inventory Events")
+	FOnContainerItemAdded OnContainerItemAdded;
+	
+	// Fired when an item leaves a named container (the default inventory uses OnItemRemoved)
+	UPROPERTY(BlueprintAssignable, Category = "Inventory Events")
+	FOnContainerItemRemoved OnContainerItemRemoved;
+	
+	// Fired on the game thread when a SaveInventoryAsync call has finished writing
+	UPROPERTY(BlueprintAssignable, Category = "Inventory Events")
+	FOnInventorySaveCompleted OnInventorySaveCompleted;
+	
+	// Fired when the total weight crosses MaxCarryWeight in either direction (checked when a batch ends)
+	UPROPERTY(BlueprintAssignable, Category = "Inventory Events")
+	FOnEncumbranceChanged OnEncumbranceChanged;
+	
+	// BATCHING
+	
+	/**
+	 * Start a batch of mutations
+	 * Per-item events still fire immediately, but OnInventoryBatchChanged and OnInventoryChanged
+	 * are held back and fire once when the outermost batch ends. Batches nest.
+	 * In C++ prefer FInventoryBatchScope so the batch can't be left open.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Batching")
+	void BeginBatch();
+	
+	/**
+	 * End a batch of mutations started with BeginBatch
+	 * Broadcasts the consolidated change events when the outermost batch ends
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Batching")
+	void EndBatch();
+	
+	/**
+	 * Check if a batch is currently open
+	 * @return True between BeginBatch and the matching EndBatch
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Batching")
+	bool IsInBatch() const { return BatchDepth > 0; }
+	
 	
 	// INVENTORY OPERATIONS
 	
@@ -71,13 +242,48 @@ public:
 	bool RemoveItemQuantity(FGuid ItemGUID, int32 Quantity);
 	
 	/**
-	 * Find an item by its GUID
+	 * Set an item's durability (clamped to its max)
+	 * @param ItemGUID - Unique identifier of the item
+	 * @param NewDurability - New durability value
+	 * @return True if the item was found
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool SetItemDurability(FGuid ItemGUID, float NewDurability);
+	
+	/**
+	 * Find an item by its GUID (O(1) hash lookup)
 	 * @param ItemGUID - Unique identifier to search for
 	 * @return The item data, or nullptr if not found
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	UInventoryItemData* FindItemByGUID(FGuid ItemGUID);
 	
+	/**
+	 * Find the position of an item in the inventory by its GUID
+	 * @param ItemGUID - Unique identifier to search for
+	 * @return Index into the item array, or INDEX_NONE if not found
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 FindItemIndexByGUID(FGuid ItemGUID) const;
+	
+	/**
+	 * Move an item to a new position in the inventory
+	 * @param ItemGUID - Unique identifier of the item to move
+	 * @param NewIndex - Destination index (clamped to valid range)
+	 * @return True if the item was found and moved
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool MoveItem(FGuid ItemGUID, int32 NewIndex);
+	
+	/**
+	 * Swap the positions of two items in the inventory
+	 * @param FirstGUID - Unique identifier of the first item
+	 * @param SecondGUID - Unique identifier of the second item
+	 * @return True if both items were found and swapped
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool SwapItems(FGuid FirstGUID, FGuid SecondGUID);
+	
 	/**
 	 * Clear all items from inventory
 	 */
@@ -88,11 +294,34 @@ public:
 	
 	/**
 	 * Get all items in the inventory
+	 * Copies the whole array - C++ should use GetItems(), Blueprint ForEachItem/GetItemAt
 	 * @return Array of all item data objects
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<UInventoryItemData*> GetAllItems() const { return Items; }
 	
+	/**
+	 * Read-only, zero-copy view of all items (C++ only)
+	 * Usable in range-based for loops. Valid until the inventory is next modified.
+	 */
+	TConstArrayView<UInventoryItemData*> GetItems() const { return Items; }
+	
+	/**
+	 * Call a function for every item without building an array
+	 * The visitor may modify the inventory; items added during the walk may be skipped
+	 * @param Visitor - Function (or Blueprint event) called once per item
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void ForEachItem(const FInventoryItemVisitor& Visitor) const;
+	
+	/**
+	 * Get the item at an index (pair with GetItemCount for Blueprint loops without copying)
+	 * @param Index - Index into the inventory
+	 * @return The item, or nullptr if the index is out of range
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	UInventoryItemData* GetItemAt(int32 Index) const { return Items.IsValidIndex(Index) ? Items[Index] : nullptr; }
+	
 	/**
 	 * Get items filtered by category
 	 * @param Category - The category to filter by
@@ -110,13 +339,92 @@ public:
 	TArray<UInventoryItemData*> GetItemsByRarity(EItemRarity Rarity) const;
 	
 	/**
-	 * Search items by name (partial match)
+	 * Fill a caller-provided array with the items of a category (reuses the array's allocation)
+	 * @param Category - The category to filter by
+	 * @param OutItems - Reset and filled with matching items
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void GetItemsByCategoryInto(EItemCategory Category, UPARAM(ref) TArray<UInventoryItemData*>& OutItems) const;
+	
+	/**
+	 * Fill a caller-provided array with the items of a rarity (reuses the array's allocation)
+	 * @param Rarity - The rarity to filter by
+	 * @param OutItems - Reset and filled with matching items
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void GetItemsByRarityInto(EItemRarity Rarity, UPARAM(ref) TArray<UInventoryItemData*>& OutItems) const;
+	
+	/**
+	 * Get how many items (stacks) are in a category - O(1)
+	 * @param Category - The category to count
+	 * @return Number of item entries in that category
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 GetItemCountByCategory(EItemCategory Category) const { return GetItemsByCategoryView(Category).Num(); }
+	
+	/**
+	 * Get how many items (stacks) have a rarity - O(1)
+	 * @param Rarity - The rarity to count
+	 * @return Number of item entries with that rarity
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 GetItemCountByRarity(EItemRarity Rarity) const { return GetItemsByRarityView(Rarity).Num(); }
+	
+	/**
+	 * Non-allocating view of the items in a category (C++ only)
+	 * Valid until the inventory is next modified
+	 */
+	TConstArrayView<UInventoryItemData*> GetItemsByCategoryView(EItemCategory Category) const;
+	
+	/**
+	 * Non-allocating view of the items with a rarity (C++ only)
+	 * Valid until the inventory is next modified
+	 */
+	TConstArrayView<UInventoryItemData*> GetItemsByRarityView(EItemRarity Rarity) const;
+	
+	/**
+	 * Search items by name (partial match, case insensitive)
+	 * Served from a trigram index, so cost scales with the matches rather than the inventory size
 	 * @param SearchText - Text to search for in item names
 	 * @return Array of matching items
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<UInventoryItemData*> SearchItemsByName(const FString& SearchText) const;
 	
+	/**
+	 * Find the items matching a predicate
+	 * Large inventories are scanned in parallel chunks (see FInventoryQuery).
+	 * @param Predicate - Conditions to match, combined with && || !
+	 * @return Matching items in inventory order
+	 */
+	TArray<UInventoryItemData*> QueryItems(const FInventoryItemPredicate& Predicate) const;
+	
+	/**
+	 * Sum the stack sizes of the items matching a predicate
+	 * @param Predicate - Conditions to match
+	 * @return Total quantity of the matches
+	 */
+	int64 GetMatchingItemQuantity(const FInventoryItemPredicate& Predicate) const;
+	
+	/**
+	 * Find the items matching a filter expression, e.g.
+	 * "Weapon AND Rarity >= Rare AND MinDamage > 20 AND Name CONTAINS 'sword'"
+	 * Expressions are compiled once and cached by their text (syntax: FInventoryFilterProgram).
+	 * @param Expression - Filter to apply (empty matches everything)
+	 * @return Matching items in inventory order - none if the expression doesn't compile
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Filter")
+	TArray<UInventoryItemData*> FilterItems(const FString& Expression) const;
+	
+	/**
+	 * Check that a filter expression compiles
+	 * @param Expression - Filter to check
+	 * @param OutError - What is wrong with it
+	 * @return True if the expression is valid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Filter")
+	bool ValidateFilterExpression(const FString& Expression, FString& OutError) const;
+	
 	/**
 	 * Get total number of items (counting stacks as 1 item)
 	 * Will give you how many unique item entries are in the inventory, not counting how many are in each stack.
@@ -127,10 +435,33 @@ public:
 	
 	/**
 	 * Get total number of individual items (counting stack quantities)
+	 * Kept as a running total, so this is cheap enough to poll every frame.
 	 * @return Total quantity of all items
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-	int32 GetTotalItemQuantity() const;
+	int32 GetTotalItemQuantity() const { return TotalQuantity; }
+	
+	/**
+	 * Get the number of individual items in a category (counting stack quantities)
+	 * @param Category - Category to count
+	 * @return Total quantity of the category's items
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 GetCategoryQuantity(EItemCategory Category) const;
+	
+	/**
+	 * Get the carried weight (each stack's count times its unit weight), kept as a running total
+	 * @return Total weight of all items
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	float GetTotalWeight() const { return static_cast<float>(TotalWeight); }
+	
+	/**
+	 * Check if the carried weight is above MaxCarryWeight
+	 * @return True if over-encumbered (never when MaxCarryWeight is 0)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool IsOverEncumbered() const { return bOverEncumbered; }
 	
 	/**
 	 * Check if inventory has room for more items
@@ -146,6 +477,328 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	float GetInventoryFillPercentage() const;
 	
+	// CONTAINERS
+	// Named containers share the item store with the default inventory. Every API that doesn't take a
+	// container name works on the default inventory; passing None (empty) as a container name does too.
+	// Items in named containers are saved and journaled with their container and slot, but the containers
+	// themselves are not - create them before LoadInventory/OpenJournal so their items have somewhere to go.
+	
+	/**
+	 * Create a named container
+	 * @param ContainerName - Name of the container (not None)
+	 * @param Capacity - Number of slots (at most FInventorySaveRecord::MaxContainerSlots, the most a save can address)
+	 * @return True if created, false if the name is taken or invalid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool CreateContainer(FName ContainerName, int32 Capacity);
+	
+	/**
+	 * Remove an empty named container
+	 * @param ContainerName - Name of the container
+	 * @return True if removed, false if it doesn't exist or still holds items
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool RemoveContainer(FName ContainerName);
+	
+	/**
+	 * Check if a container exists
+	 * @param ContainerName - Name of the container (None = default inventory, always exists)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool HasContainer(FName ContainerName) const { return ContainerName.IsNone() || Containers.Contains(ContainerName); }
+	
+	/**
+	 * Get the number of slots in a container
+	 * @param ContainerName - Name of the container (None = default inventory)
+	 * @return Capacity, or 0 if the container doesn't exist
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	int32 GetContainerCapacity(FName ContainerName) const;
+	
+	/**
+	 * Get the number of items in a container
+	 * @param ContainerName - Name of the container (None = default inventory)
+	 * @return Item count, or 0 if the container doesn't exist
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	int32 GetContainerItemCount(FName ContainerName) const;
+	
+	/**
+	 * Get the items in a container, in slot order
+	 * @param ContainerName - Name of the container (None = default inventory)
+	 * @return The items (empty slots are skipped)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	TArray<UInventoryItemData*> GetContainerItems(FName ContainerName) const;
+	
+	/**
+	 * Get the item in a container slot
+	 * @param ContainerName - Name of the container (None = default inventory, slot = index)
+	 * @param SlotIndex - Slot to read
+	 * @return The item, or nullptr if the slot is empty or invalid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	UInventoryItemData* GetItemInSlot(FName ContainerName, int32 SlotIndex) const;
+	
+	/**
+	 * Find which container an item is in
+	 * @param ItemGUID - Unique identifier of the item
+	 * @param OutContainerName - Receives the container (None = default inventory)
+	 * @param OutSlotIndex - Receives the slot (index for the default inventory)
+	 * @return True if the item is anywhere in the store
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool FindItemLocation(FGuid ItemGUID, FName& OutContainerName, int32& OutSlotIndex) const;
+	
+	/**
+	 * Put a new item into a container (no auto-stacking outside the default inventory)
+	 * @param ContainerName - Target container (None = AddItem)
+	 * @param Item - Item to add
+	 * @param SlotIndex - Slot to use, or -1 for the first free slot
+	 * @return True if added
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool AddItemToContainer(FName ContainerName, UInventoryItemData* Item, int32 SlotIndex = -1);
+	
+	/**
+	 * Remove an item from whichever container holds it
+	 * @param ItemGUID - Unique identifier of the item
+	 * @return True if found and removed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool RemoveItemFromContainer(FGuid ItemGUID);
+	
+	/**
+	 * Move an item to another container
+	 * The item object itself is moved - only its ownership changes. Between named containers this
+	 * is O(1); leaving the default inventory costs whatever its removal mode costs.
+	 * @param ItemGUID - Unique identifier of the item
+	 * @param TargetContainer - Destination (None = default inventory)
+	 * @param TargetSlot - Destination slot, or -1 for the first free slot (ignored for the default inventory)
+	 * @return True if moved, false if the item wasn't found or the target slot/container is full
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool MoveItemToContainer(FGuid ItemGUID, FName TargetContainer, int32 TargetSlot = -1);
+	
+	// GRID CONTAINERS
+	// Containers where items take a Width x Height footprint of cells (GetGridSize), Tetris-style.
+	// The regular container functions work on them too; a slot index is the item's top-left cell.
+	
+	/**
+	 * Create a named grid container
+	 * @param ContainerName - Name of the container (not None)
+	 * @param Width - Columns (1 to 64)
+	 * @param Height - Rows
+	 * @param PlacementMode - How items are placed when no position is given
+	 * @return True if created
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool CreateGridContainer(FName ContainerName, int32 Width, int32 Height, EInventoryPlacementMode PlacementMode = EInventoryPlacementMode::FirstFit);
+	
+	/**
+	 * Get a grid container's size
+	 * @param ContainerName - Name of the container
+	 * @return Columns and rows, or (0, 0) if it isn't a grid container
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	FIntPoint GetGridContainerSize(FName ContainerName) const;
+	
+	/**
+	 * Find where an item would go in a grid container (for placement previews)
+	 * @param ContainerName - Grid container
+	 * @param ItemSize - Footprint to place
+	 * @param bAllowRotation - Also try the footprint turned 90 degrees
+	 * @param OutPosition - Receives the top-left cell
+	 * @param bOutRotated - Receives whether the footprint was rotated
+	 * @return False if it fits nowhere
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool FindGridPlacement(FName ContainerName, FIntPoint ItemSize, bool bAllowRotation, FIntPoint& OutPosition, bool& bOutRotated) const;
+	
+	/**
+	 * Put an item (from any container) at a cell of a grid container
+	 * @param ItemGUID - Unique identifier of the item
+	 * @param ContainerName - Grid container
+	 * @param Position - Top-left cell
+	 * @param bRotated - Turn the footprint 90 degrees
+	 * @return True if moved, false if the area isn't free
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool MoveItemInGrid(FGuid ItemGUID, FName ContainerName, FIntPoint Position, bool bRotated);
+	
+	/**
+	 * Get an item's cells in its grid container
+	 * @param ItemGUID - Unique identifier of the item
+	 * @param OutPosition - Receives the top-left cell
+	 * @param OutSize - Receives the footprint as placed (rotation applied)
+	 * @return False if the item isn't in a grid container
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool GetItemGridPlacement(FGuid ItemGUID, FIntPoint& OutPosition, FIntPoint& OutSize) const;
+	
+	/**
+	 * Repack a grid container - largest items first, each in the first spot that fits (rotating if needed)
+	 * Leaves the container untouched if the items wouldn't all fit in the new layout.
+	 * @param ContainerName - Grid container
+	 * @return True if the container was repacked
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Containers")
+	bool CompactGridContainer(FName ContainerName);
+	
+	// ITEM DEFINITIONS
+	
+	/**
+	 * Register a shared item definition so it can be looked up by ID
+	 * @param Definition - The definition to register
+	 * @return True if registered, false if invalid or the ID is taken by a different definition
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Definitions")
+	bool RegisterItemDefinition(UInventoryItemDefinition* Definition);
+	
+	/**
+	 * Find a registered item definition
+	 * @param DefinitionId - ID of the definition
+	 * @return The definition, or nullptr if none is registered under that ID
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Definitions")
+	UInventoryItemDefinition* FindItemDefinition(FName DefinitionId) const;
+	
+	// REPLICATION
+	// Used by UInventoryReplicationComponent to mirror the server's items into a client's inventory.
+	// Items keep their server GUIDs and are never auto-stacked; the usual item events fire.
+	
+	/**
+	 * Add a copy of a server item
+	 * @param Instance - Definition, GUID, stack and durability of the server item
+	 * @return The local item, or nullptr if it has no definition or the GUID is already held
+	 */
+	UInventoryItemData* ApplyReplicatedAdd(const FInventoryItemInstance& Instance);
+	
+	/**
+	 * Remove a mirrored item
+	 * @param ItemGUID - GUID of the server item
+	 * @return True if the item was held
+	 */
+	bool ApplyReplicatedRemove(const FGuid& ItemGUID);
+	
+	/**
+	 * Update a mirrored item's stack and durability
+	 * @param Instance - New state of the server item
+	 * @return True if the item was held
+	 */
+	bool ApplyReplicatedState(const FInventoryItemInstance& Instance);
+	
+	// SORTING
+	
+	/**
+	 * Reorder the inventory (stable - items that compare equal keep their order)
+	 * Also becomes the order kept by auto-sort when it is on.
+	 * @param Criteria - Keys to sort by, most significant first (e.g. rarity, category, name)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Sort")
+	void SortInventory(const TArray<FInventorySortCriterion>& Criteria);
+	
+	/**
+	 * Keep the inventory sorted - sorts now, then inserts each new item at its sorted position
+	 * Manual moves, swap-removal (bPreserveOrderOnRemove off) and stack changes under a StackSize
+	 * key are left as they are until the next full sort.
+	 * @param bEnabled - Turn auto-sort on or off
+	 * @param Criteria - Keys to sort by when enabling
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Sort")
+	void SetAutoSort(bool bEnabled, const TArray<FInventorySortCriterion>& Criteria);
+	
+	/**
+	 * Check if new items are inserted in sorted order
+	 * @return True while auto-sort is on
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Sort")
+	bool IsAutoSortEnabled() const { return bKeepSorted; }
+	
+	// SAVE / LOAD
+	
+	/**
+	 * Write the inventory to a compact binary save file
+	 * Saves each item's definition ID, GUID, stack count and durability, plus the container and slot of items
+	 * in named containers. Items without a definition are skipped.
+	 * @param FilePath - Destination file (empty = GetDefaultSaveFilePath)
+	 * @return True if the file was written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool SaveInventory(const FString& FilePath = TEXT("")) const;
+	
+	/**
+	 * Save the inventory without stalling the game thread
+	 * Captures a snapshot of the items now; serializing, compressing and writing happen on a
+	 * background task, so later changes to the inventory are not included in this save.
+	 * Saves run one at a time in the order they were requested.
+	 * @param FilePath - Destination file (empty = GetDefaultSaveFilePath)
+	 * @param bCompress - Compress the file (smaller, but LoadInventory can no longer read it in place)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	void SaveInventoryAsync(const FString& FilePath = TEXT(""), bool bCompress = true);
+	
+	/**
+	 * Check if any SaveInventoryAsync calls are still running
+	 * @return True until the last OnInventorySaveCompleted has fired
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool IsSaveInProgress() const { return NumSavesInFlight > 0; }
+	
+	/**
+	 * Replace the inventory with the contents of a save file
+	 * The file is memory-mapped and its records are read in place (compressed saves are expanded first).
+	 * Definitions must already be registered. Named containers are emptied and refilled from the save; an item
+	 * whose container doesn't exist (or no longer has room) goes into the default inventory instead.
+	 * @param FilePath - Source file (empty = GetDefaultSaveFilePath)
+	 * @return True if the file was valid and loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool LoadInventory(const FString& FilePath = TEXT(""));
+	
+	/**
+	 * Restore the inventory from a save plus its journal, then start journaling every change
+	 * Loads the save (if it exists), replays the journal written next to it, folds both into a
+	 * fresh save and opens an empty journal. From then on each add, removal, stack change and
+	 * reorder is appended to the journal instead of rewriting the whole save.
+	 * Definitions that aren't registered are loaded or rebuilt from the saved definition data.
+	 * If any saved item still can't be restored - including one whose named container hasn't been
+	 * created - the open fails and both files are left as they are, since folding them into a new
+	 * save would lose that item (or its place) for good.
+	 * @param FilePath - Save file the journal belongs to (empty = GetDefaultSaveFilePath)
+	 * @return True if the journal is open
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool OpenJournal(const FString& FilePath = TEXT(""));
+	
+	/**
+	 * Flush and stop journaling (the save + journal on disk stay valid)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	void CloseJournal();
+	
+	/**
+	 * Write the current inventory as a full save and start a new, empty journal
+	 * Happens automatically once the journal reaches JournalCompactionThreshold records
+	 * @return True if compacted
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool CompactJournal();
+	
+	/**
+	 * Check if changes are being journaled
+	 * @return True between OpenJournal and CloseJournal
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool IsJournalOpen() const { return Journal.IsOpen(); }
+	
+	/**
+	 * Get the file SaveInventory/LoadInventory use when no path is given
+	 * @return Saved/Inventory/Inventory.inv under the project directory
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	static FString GetDefaultSaveFilePath();
+	
 	// CONFIGURATION
 	
 	/**
@@ -162,6 +815,76 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	int32 GetMaxInventorySlots() const { return MaxInventorySlots; }
 	
+	/**
+	 * Set the weight above which the inventory counts as over-encumbered
+	 * @param NewMax - Weight limit (0 = no limit)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void SetMaxCarryWeight(float NewMax);
+	
+	/**
+	 * Get the over-encumbrance weight limit
+	 * @return Weight limit (0 = no limit)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	float GetMaxCarryWeight() const { return MaxCarryWeight; }
+	
+	/**
+	 * Choose between stable removal and swap-removal
+	 * @param bPreserve - Keep item order on removal (O(n) shift) rather than swap-remove (O(1))
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void SetPreserveOrderOnRemove(bool bPreserve) { bPreserveOrderOnRemove = bPreserve; }
+	
+	// ICONS
+	
+	/**
+	 * Set how many item icons may stay loaded (icons on screen are kept even above this)
+	 * @param NewMax - Resident icon budget
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Icons")
+	void SetMaxResidentIcons(int32 NewMax);
+	
+	/**
+	 * Get the resident icon budget
+	 * @return Max icons kept loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Icons")
+	int32 GetMaxResidentIcons() const { return MaxResidentIcons; }
+	
+	/**
+	 * Get how many icons are loaded or loading
+	 * @return Resident icon count
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Icons")
+	int32 GetNumResidentIcons() const { return IconCache ? IconCache->GetNumResidentIcons() : 0; }
+	
+	/** Streams item icons for slots; shared with widgets (valid between Initialize and Deinitialize) */
+	TSharedPtr<FInventoryIconCache> GetIconCache() const { return IconCache; }
+	
+	// READ SNAPSHOTS
+	
+	/**
+	 * Turn read snapshots on or off. While on, every batch of changes ends by publishing a new
+	 * FInventorySnapshot (one pass over the items; unchanged items are shared with the last one).
+	 * @param bEnabled - Publish snapshots
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Snapshots")
+	void SetReadSnapshotsEnabled(bool bEnabled);
+	
+	/**
+	 * Are read snapshots being published
+	 * @return True if enabled
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Snapshots")
+	bool AreReadSnapshotsEnabled() const { return bPublishReadSnapshots; }
+	
+	/**
+	 * Get the latest published snapshot - callable from any thread
+	 * @return The snapshot, or null when read snapshots are off
+	 */
+	FInventorySnapshotPtr AcquireSnapshot() const;
+	
 protected:
 	
 	// INTERNAL DATA
@@ -170,6 +893,14 @@ protected:
 	UPROPERTY()
 	TArray<UInventoryItemData*> Items;
 	
+	// Named containers (the default inventory is Items)
+	UPROPERTY()
+	TMap<FName, FInventoryContainer> Containers;
+	
+	// Shared item definitions by ID (also keeps runtime-created definitions alive)
+	UPROPERTY()
+	TMap<FName, TObjectPtr<UInventoryItemDefinition>> ItemDefinitions;
+	
 	// Maximum number of item slots
 	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config")
 	int32 MaxInventorySlots = 100;
@@ -177,10 +908,336 @@ protected:
 	// Whether to automatically stack items
 	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config")
 	bool bAutoStack = true;
+	
+	// Keep item order stable on removal (O(n) shift). Disable for O(1) swap-remove when order doesn't matter.
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config")
+	bool bPreserveOrderOnRemove = true;
+	
+	// Total weight above which OnEncumbranceChanged reports over-encumbered. 0 = no limit.
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config", meta = (ClampMin = "0.0"))
+	float MaxCarryWeight = 0.0f;
+	
+	// Item icons kept loaded after their slots scroll away, least recently used dropped first
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config|Icons", meta = (ClampMin = "0"))
+	int32 MaxResidentIcons = 256;
+	
+	// Publish an immutable snapshot for other threads after every batch (costs a pass over the items)
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config|Snapshots")
+	bool bPublishReadSnapshots = false;
+	
+	// Seconds between journal writes; each write is fsynced. 0 = write and fsync after every change.
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config|Journal", meta = (ClampMin = "0.0"))
+	float JournalSyncInterval = 1.0f;
+	
+	// Fold the journal into a full save once it holds this many records
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory Config|Journal", meta = (ClampMin = "1"))
+	int32 JournalCompactionThreshold = 2000;
 
 private:
+	// GUID -> index into Items, kept in sync with every add/remove/reorder
+	TMap<FGuid, int32> ItemIndexByGUID;
+	
+	// GUID -> slot for items held in named containers
+	TMap<FGuid, FInventoryItemLocation> ItemLocations;
+	
+	// Substring index over normalized item names
+	FInventorySearchIndex SearchIndex;
+	
+	// Membership buckets per category and rarity, in inventory order
+	TMap<EItemCategory, TArray<UInventoryItemData*>> ItemsByCategory;
+	TMap<EItemRarity, TArray<UInventoryItemData*>> ItemsByRarity;
+	
+	// Running totals over Items, adjusted by every add/remove/stack change (item weight and category
+	// are treated as fixed while the item is stored, same as the buckets above)
+	int32 TotalQuantity = 0;
+	double TotalWeight = 0.0;
+	TMap<EItemCategory, int32> QuantityByCategory;
+	
+	// TotalWeight was above MaxCarryWeight at the last check
+	bool bOverEncumbered = false;
+	
+	// Merge key -> stackable items that still have room, in the order they became open
+	TMap<FInventoryStackKey, TArray<UInventoryItemData*>> OpenStacksByKey;
+	
+	// Open BeginBatch calls
+	int32 BatchDepth = 0;
+	
+	// Changes accumulated since the last flush
+	FInventoryChangeDelta PendingDelta;
+	
+	// What each PendingDelta list currently holds, so recording a change never scans a list.
+	// Entries are only dropped from the sets; the lists are compacted against them on flush.
+	TSet<FGuid> PendingAddedSet;
+	TSet<FGuid> PendingRemovedSet;
+	TSet<FGuid> PendingRestackedSet;
+	TSet<FGuid> PendingDurabilitySet;
+	
+	// Something changed since the last flush (covers clears/reorders with an empty delta)
+	bool bPendingInventoryChange = false;
+	
+	// Background saves run through this pipe so two writes never overlap
+	UE::Tasks::FPipe SavePipe{ TEXT("InventorySavePipe") };
+	
+	// Most recently launched save (the pipe runs them in order, so waiting on it waits for all)
+	UE::Tasks::FTask LastSaveTask;
+	
+	// Async saves whose completion event hasn't fired yet
+	int32 NumSavesInFlight = 0;
+	
+	// Append-only change log (open between OpenJournal and CloseJournal)
+	FInventoryJournal Journal;
+	
+	// Save file the open journal applies to
+	FString JournalSavePath;
+	
+	// Periodic journal flush/compaction
+	FTSTicker::FDelegateHandle JournalTickerHandle;
+	
+	// Replaying a journal - its changes must not be journaled again
+	bool bReplayingJournal = false;
+	
+	// Inside a container move - journaled as one record, not the removal and add it is made of
+	bool bMovingToContainer = false;
+	
+	// Packed-key sorter (keeps its name collation cache between sorts)
+	FInventorySorter Sorter;
+	
+	// Insert new items at their sorted position instead of appending
+	bool bKeepSorted = false;
+	
+	// Async icon loads and the resident icon LRU
+	TSharedPtr<FInventoryIconCache> IconCache;
+	
+	// Latest read snapshot - only the pointer swap/copy happens under SnapshotLock
+	FInventorySnapshotPtr PublishedSnapshot;
+	mutable FRWLock SnapshotLock;
+	
+	// Captured items by GUID, reused by the next snapshot unless the item changed
+	TMap<FGuid, FInventorySnapshotItemRef> SnapshotItems;
+	
+	// Version of the last published snapshot
+	uint64 SnapshotVersion = 0;
+	
+	// Compiled filter expressions by their text
+	mutable TMap<FString, TSharedPtr<const FInventoryFilterProgram>> CompiledFilters;
+	
+	// Columns of Items for filter expressions, rebuilt on the first filter after a change
+	mutable FInventoryColumnarView FilterView;
+	mutable bool bFilterViewDirty = true;
+	
+	// EVENT HELPERS
+	
+	/** Broadcast the pending delta and OnInventoryChanged, then reset */
+	void FlushPendingChanges();
+	
+	/** Record an added item and broadcast OnItemAdded */
+	void NotifyItemAdded(UInventoryItemData* Item);
+	
+	/** Record a removed item and broadcast OnItemRemoved */
+	void NotifyItemRemoved(const FGuid& ItemGUID);
+	
+	/** Record a stack size change and broadcast OnItemStackChanged */
+	void NotifyItemStackChanged(UInventoryItemData* Item);
+	
+	/** Record a reorder, flushing immediately when not batching */
+	void NotifyOrderChanged();
+	
+	/**
+	 * Build and publish a new read snapshot
+	 * @param Delta - What changed since the last one (null recaptures every item)
+	 */
+	void PublishSnapshot(const FInventoryChangeDelta* Delta);
+	
+	/**
+	 * Compile a filter expression, or take it from the cache
+	 * @param OutError - Why it failed to compile
+	 * @return The program, or null on an error
+	 */
+	TSharedPtr<const FInventoryFilterProgram> GetCompiledFilter(const FString& Expression, FString& OutError) const;
+	
+	/** Fold a removal into the pending delta */
+	void RecordRemoved(const FGuid& ItemGUID);
+	
+	/** Fold a stack size change into the pending delta */
+	void RecordRestacked(const FGuid& ItemGUID);
+	
+	/** Fold a durability change into the pending delta */
+	void RecordDurabilityChanged(const FGuid& ItemGUID);
+	
+	/** Drop the entries of the pending delta lists that were cancelled later in the batch */
+	void CompactPendingDelta();
+	
+	// JOURNAL HELPERS
+	
+	/** Is there an open journal that should record changes right now */
+	bool ShouldJournal() const { return Journal.IsOpen() && !bReplayingJournal && !bMovingToContainer; }
+	
+	/** Flush after a journal record when writing through (JournalSyncInterval == 0) outside a batch */
+	void OnJournalRecordAppended();
+	
+	/** Ticker callback - flushes buffered records and compacts when the journal grows too long */
+	bool TickJournal(float DeltaTime);
+	
+	/**
+	 * Apply journal records on top of the current inventory
+	 * Every added item's definition is resolved and every named container checked first; nothing is
+	 * applied if one is missing.
+	 * @return False if some records couldn't be replayed
+	 */
+	bool ReplayJournal(TConstArrayView<FInventoryJournal::FEntry> Entries);
+	
+	/** Write a full save to JournalSavePath and restart the journal on top of it */
+	bool WriteJournalBase();
+	
+	/** Journal an item that went straight into a named container - an add, then a move to its slot */
+	void JournalContainerAdd(const UInventoryItemData* Item);
+	
+	/**
+	 * Collect every item held in a named container, for a save
+	 * @param OutItems - Receives each item with its container and slot
+	 */
+	void CaptureContainerItems(TArray<FInventorySaveContainerItem>& OutItems) const;
+	
 	// INTERNAL HELPERS
 	
+	/**
+	 * Append an item to the store and index it
+	 * @param Item - Item to append (must already be validated)
+	 */
+	void AddItemToStore(UInventoryItemData* Item);
+	
+	/**
+	 * Remove the item at an index from the store and keep the GUID index correct
+	 * Uses swap-remove unless bPreserveOrderOnRemove is set (a swap that moves an item marks the pending delta reordered)
+	 * @param Index - Index of the item to remove
+	 */
+	void RemoveItemFromStoreAt(int32 Index);
+	
+	/**
+	 * Re-write GUID index entries for a range of items after they shifted
+	 * @param FirstIndex - First index to re-write
+	 * @param LastIndex - Last index to re-write (inclusive)
+	 */
+	void ReindexItems(int32 FirstIndex, int32 LastIndex);
+	
+	/**
+	 * Replace the inventory with the items described by a parsed save file
+	 * @param SaveView - Parsed save contents
+	 * @param bRequireAll - Leave the inventory untouched and fail if any record can't be restored
+	 * @return Number of items restored, or INDEX_NONE if bRequireAll failed
+	 */
+	int32 RestoreFromSave(const FInventorySaveView& SaveView, bool bRequireAll = false);
+	
+	/**
+	 * Read and restore a save file
+	 * @param SavePath - File to load
+	 * @param OutPayloadCrc - Optionally receives the save's payload CRC
+	 * @param bRequireAll - Fail rather than drop items that can't be restored
+	 * @return True if the file was valid and loaded
+	 */
+	bool LoadSaveFile(const FString& SavePath, uint32* OutPayloadCrc = nullptr, bool bRequireAll = false);
+	
+	/**
+	 * Find a saved definition, or bring it back from its saved data and register it
+	 * @param DefinitionId - ID it was saved under
+	 * @param Saved - Saved definition data (null for saves that only stored the ID)
+	 * @return The definition, or null if it isn't registered and can't be rebuilt
+	 */
+	UInventoryItemDefinition* ResolveSavedDefinition(FName DefinitionId, const FInventorySavedDefinition* Saved);
+	
+	/**
+	 * Recreate a saved item exactly as it was (no re-stacking) and add it to the store
+	 * @param ContainerName - Named container it was saved in (None = default inventory)
+	 * @param SlotIndex - Its saved slot; any free one is used if that is taken, the default inventory if none is
+	 * @param bRotated - Its saved footprint rotation
+	 * @return The new item
+	 */
+	UInventoryItemData* RestoreItem(UInventoryItemDefinition* Definition, const FGuid& ItemGUID, int32 StackCount, float Durability,
+		FName ContainerName = NAME_None, int32 SlotIndex = INDEX_NONE, bool bRotated = false);
+	
+	/**
+	 * Put an item into a named container slot and announce it
+	 * @param SlotIndex - Slot (top-left cell for grid containers), or INDEX_NONE to pick one
+	 * @param bRotated - Rotate the footprint when SlotIndex is given (grid containers)
+	 * @return False if the slot is invalid or taken
+	 */
+	bool PlaceInContainer(FName ContainerName, int32 SlotIndex, UInventoryItemData* Item, bool bRotated = false);
+	
+	/**
+	 * Check where an item can go in a container
+	 * @param InOutSlotIndex - Requested slot, or INDEX_NONE to pick one; receives the slot to use
+	 * @param InOutRotated - Requested rotation; receives the rotation to use
+	 * @return True if the item fits
+	 */
+	bool FindContainerPlacement(const FInventoryContainer& Container, const UInventoryItemData* Item, int32& InOutSlotIndex, bool& InOutRotated) const;
+	
+	/** Move an item to a container slot with a given rotation (shared by the container and grid moves) */
+	bool MoveItemToContainerSlot(const FGuid& ItemGUID, FName TargetContainer, int32 TargetSlot, bool bRotated);
+	
+	/** Top-left cell of a grid container slot */
+	static FIntPoint SlotToCell(const FInventoryContainer& Container, int32 SlotIndex);
+	
+	/** Footprint of an item as placed */
+	static FIntPoint GetPlacedSize(const UInventoryItemData* Item, bool bRotated);
+	
+	/**
+	 * Take an item out of its named container slot and announce it
+	 * @return The item, or nullptr if it isn't in a named container
+	 */
+	UInventoryItemData* TakeFromContainer(const FGuid& ItemGUID);
+	
+	/** Rebuild the category/rarity buckets from Items (after a sort) */
+	void RebuildBuckets();
+	
+	/**
+	 * Find where the item at an inventory index sits in an inventory-ordered bucket
+	 * @return Bucket position (the insertion point if that item isn't in the bucket)
+	 */
+	int32 FindBucketPosition(const TArray<UInventoryItemData*>& Bucket, int32 ItemIndex) const;
+	
+	/**
+	 * Reposition one item within a bucket for a move from OldIndex to NewIndex - O(log n) lookups
+	 * instead of a full RebuildBuckets. Call before Items and the GUID index change.
+	 * @param bShiftsBetween - True for MoveItem (the items in between shift by one), false for a swap
+	 *                         or for the last item filling a swap-removed slot
+	 */
+	void MoveBucketEntry(TArray<UInventoryItemData*>& Bucket, int32 OldIndex, int32 NewIndex, bool bShiftsBetween);
+	
+	/** Keep the buckets holding two items in order across SwapItems (they may be the same bucket). Call before the swap. */
+	void SwapBucketEntries(TArray<UInventoryItemData*>& FirstBucket, TArray<UInventoryItemData*>& SecondBucket,
+		int32 FirstIndex, int32 SecondIndex);
+	
+	/**
+	 * Add an item to a list in inventory order - appended, or at its sorted position under auto-sort
+	 * @return Index the item was placed at
+	 */
+	int32 InsertInOrder(TArray<UInventoryItemData*>& List, UInventoryItemData* Item);
+	
+	/**
+	 * Add or remove an item from the open-stack index based on its current fullness
+	 * @param Item - Item whose stack state may have changed
+	 */
+	void UpdateOpenStackEntry(UInventoryItemData* Item);
+	
+	/**
+	 * Drop an item from the open-stack index
+	 * @param Item - Item leaving the inventory
+	 */
+	void RemoveOpenStackEntry(UInventoryItemData* Item);
+	
+	/**
+	 * Apply a change in a stored item's quantity to the running totals
+	 * @param Item - Item whose quantity changed
+	 * @param QuantityDelta - Units added (negative when removed)
+	 */
+	void AdjustAggregates(const UInventoryItemData* Item, int32 QuantityDelta);
+	
+	/** Compare the total weight against MaxCarryWeight and fire OnEncumbranceChanged on a crossing */
+	void UpdateEncumbrance();
+	
+	/** Keeps the indices, totals and pending delta current when a stored item's stack size changes, even through direct AddToStack calls */
+	void HandleItemStackSizeChanged(UInventoryItemData* Item, int32 OldSize, int32 NewSize);
+	
 	/**
 	 * Try to stack a new item with existing items
 	 * Distributes items across multiple matching stacks if needed
@@ -195,4 +1252,36 @@ private:
 	 * @return True if valid
 	 */
 	bool IsItemValid(UInventoryItemData* Item) const;
+};
+
+/**
+ * RAII helper that keeps an inventory batch open for its lifetime
+ *
+ * Usage:
+ *   {
+ *       FInventoryBatchScope Batch(InventoryManager);
+ *       for (UInventoryItemData* Item : Loot) { InventoryManager->AddItem(Item); }
+ *   } // one OnInventoryBatchChanged + OnInventoryChanged here
+ */
+struct FInventoryBatchScope : public FNoncopyable
+{
+	explicit FInventoryBatchScope(UInventoryManagerSubsystem* InInventoryManager)
+		: InventoryManager(InInventoryManager)
+	{
+		if (InventoryManager)
+		{
+			InventoryManager->BeginBatch();
+		}
+	}
+
+	~FInventoryBatchScope()
+	{
+		if (InventoryManager)
+		{
+			InventoryManager->EndBatch();
+		}
+	}
+
+private:
+	UInventoryManagerSubsystem* InventoryManager;
 };
\ No newline at end of file
@@ -0,0 +1,119 @@
+// InventoryQuery.h
+// Composable item predicates and a chunked parallel scan for large item sets
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemData.h"
+#include "InventoryQuery.generated.h"
+
+/**
+ * Numeric item property a predicate can compare against
+ */
+UENUM(BlueprintType)
+enum class EInventoryItemStat : uint8
+{
+	StackSize   UMETA(DisplayName = "Stack Size"),
+	MinDamage   UMETA(DisplayName = "Min Damage"),
+	MaxDamage   UMETA(DisplayName = "Max Damage"),
+	AttackSpeed UMETA(DisplayName = "Attack Speed"),
+	Durability  UMETA(DisplayName = "Durability"),
+	Weight      UMETA(DisplayName = "Weight")
+};
+
+/**
+ * Filter over items, built from simple conditions and combined with && || !
+ *
+ * Usage:
+ *   const FInventoryItemPredicate Predicate =
+ *       FInventoryItemPredicate::Category(EItemCategory::Weapon) &&
+ *       FInventoryItemPredicate::RarityBetween(EItemRarity::Rare, EItemRarity::Legendary) &&
+ *       FInventoryItemPredicate::StatAtLeast(EInventoryItemStat::MinDamage, 20.0f);
+ *
+ * Predicates are evaluated on worker threads by FInventoryQuery and must only read items.
+ * A default-constructed predicate matches everything.
+ */
+class ADAPTIVEINVENTORY_API FInventoryItemPredicate
+{
+public:
+	FInventoryItemPredicate();
+
+	static FInventoryItemPredicate Category(EItemCategory InCategory);
+
+	/** Rarity within [Min, Max] */
+	static FInventoryItemPredicate RarityBetween(EItemRarity Min, EItemRarity Max);
+
+	static FInventoryItemPredicate StatAtLeast(EInventoryItemStat Stat, float Value);
+	static FInventoryItemPredicate StatAtMost(EInventoryItemStat Stat, float Value);
+
+	/** Partial, case-insensitive name match */
+	static FInventoryItemPredicate NameContains(const FString& SearchText);
+
+	/** Arbitrary test - must be safe to call from several threads at once */
+	static FInventoryItemPredicate Custom(TFunction<bool(const UInventoryItemData&)> InTest);
+
+	FInventoryItemPredicate operator&&(const FInventoryItemPredicate& Other) const;
+	FInventoryItemPredicate operator||(const FInventoryItemPredicate& Other) const;
+	FInventoryItemPredicate operator!() const;
+
+	bool Matches(const UInventoryItemData& Item) const { return Test(Item); }
+
+	/** Reads item names (which are normalized lazily, so must be warmed before going wide) */
+	bool UsesName() const { return bUsesName; }
+
+	static float GetStat(const UInventoryItemData& Item, EInventoryItemStat Stat);
+
+private:
+	FInventoryItemPredicate(TFunction<bool(const UInventoryItemData&)>&& InTest, bool bInUsesName);
+
+	TFunction<bool(const UInventoryItemData&)> Test;
+	bool bUsesName = false;
+};
+
+/** How FInventoryQuery splits a scan */
+struct FInventoryQueryOptions
+{
+	/** Inputs smaller than this are scanned on the calling thread */
+	int32 MinItemsPerChunk = 4096;
+
+	/** Keep the scan on the calling thread (chunking is unchanged - useful as a baseline) */
+	bool bSingleThreaded = false;
+
+	/** Most threads working on the scan at once, the calling thread included (0 = as many as the task graph has) */
+	int32 MaxThreads = 0;
+
+	/** Normalize names up front when the predicate uses them (skip when the items were already indexed) */
+	bool bWarmNameCaches = true;
+};
+
+/**
+ * Bulk scans over item arrays for server-side work on very large stores
+ *
+ * The input is cut into contiguous chunks that run across the task graph with ParallelFor.
+ * Each chunk collects into its own buffer, and the buffers are joined in chunk order,
+ * so results are in input order whatever the thread count.
+ *
+ * Items must not be changed while a scan runs; the calling thread blocks until it's done.
+ */
+struct ADAPTIVEINVENTORY_API FInventoryQuery
+{
+	/**
+	 * Collect the items matching a predicate
+	 * @param Items - Items to scan (null entries are skipped)
+	 * @param Predicate - Conditions to match
+	 * @param OutMatches - Receives the matches in input order
+	 * @param Options - Chunking
+	 */
+	static void FindItems(TConstArrayView<UInventoryItemData*> Items, const FInventoryItemPredicate& Predicate,
+		TArray<UInventoryItemData*>& OutMatches, const FInventoryQueryOptions& Options = FInventoryQueryOptions());
+
+	/**
+	 * Sum the stack sizes of the items matching a predicate
+	 * @return Total quantity of the matches
+	 */
+	static int64 SumQuantity(TConstArrayView<UInventoryItemData*> Items, const FInventoryItemPredicate& Predicate,
+		const FInventoryQueryOptions& Options = FInventoryQueryOptions());
+
+	/** How many chunks a scan of NumItems is split into */
+	static int32 GetNumChunks(int32 NumItems, const FInventoryQueryOptions& Options);
+};
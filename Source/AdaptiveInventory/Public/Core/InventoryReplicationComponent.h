@@ -0,0 +1,281 @@
+// InventoryReplicationComponent.h
+// Replicates the server's inventory to clients as a fast-array delta list
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "InventoryItemDefinition.h"
+#include "InventoryManagerSubsystem.h"
+#include "InventoryCommand.h"
+#include "InventoryReplicationComponent.generated.h"
+
+class UInventoryReplicationComponent;
+struct FInventoryReplicatedList;
+
+/** One replicated item - just the per-instance state, the definition replicates as an asset reference */
+USTRUCT()
+struct ADAPTIVEINVENTORY_API FInventoryReplicatedEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FInventoryItemInstance Instance;
+
+	//~ Begin FFastArraySerializerItem (client callbacks)
+	void PreReplicatedRemove(const FInventoryReplicatedList& InArraySerializer);
+	void PostReplicatedAdd(const FInventoryReplicatedList& InArraySerializer);
+	void PostReplicatedChange(const FInventoryReplicatedList& InArraySerializer);
+	//~ End FFastArraySerializerItem
+};
+
+/** Delta-serialized item list - only entries marked dirty since the last update are sent */
+USTRUCT()
+struct ADAPTIVEINVENTORY_API FInventoryReplicatedList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FInventoryReplicatedEntry> Entries;
+
+	/** Component the list belongs to (receives the client callbacks) */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UInventoryReplicationComponent> Owner = nullptr;
+
+	/** Called once after all item callbacks of one update */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FInventoryReplicatedEntry, FInventoryReplicatedList>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryReplicatedList> : public TStructOpsTypeTraitsBase2<FInventoryReplicatedList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/** Client-side counters for the command buffer */
+USTRUCT(BlueprintType)
+struct ADAPTIVEINVENTORY_API FInventoryCommandStats
+{
+	GENERATED_BODY()
+
+	/** Commands queued (and predicted) */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Replication")
+	int32 CommandsQueued = 0;
+
+	/** Server RPCs sent - one per tick with queued commands */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Replication")
+	int32 RPCsSent = 0;
+
+	/** Commands the server has acked (applied or rejected) */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Replication")
+	int32 CommandsAcknowledged = 0;
+
+	/** Acks after which the authoritative state differed from what was predicted */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Replication")
+	int32 Corrections = 0;
+};
+
+/**
+ * Server-authoritative inventory replication
+ *
+ * On the server the component mirrors the default inventory of the server's
+ * UInventoryManagerSubsystem into a fast-array list, updated from OnInventoryBatchChanged.
+ * The subsystem belongs to the game instance, so every player's component mirrors the same
+ * inventory - nothing here tells one player's items from another's.
+ * An add, remove, stack or durability change dirties only that entry, so only it is sent.
+ *
+ * On clients the received changes are applied to the local subsystem, which fires the usual
+ * OnItemAdded / OnItemRemoved / OnItemStackChanged events (one OnInventoryChanged per update),
+ * so existing widgets work unchanged. The client's own items are replaced by the server's on
+ * the first update. Item order is not replicated.
+ *
+ * Only definition-based items replicate (standalone items have nothing the client could
+ * rebuild them from), and definitions must be assets both sides can load.
+ *
+ * Clients change the inventory through the Queue* functions rather than the subsystem.
+ * Each command is applied locally straight away (predicted) and buffered; the buffer goes
+ * to the server as one RPC per tick. The server validates the whole batch, then applies it
+ * inside one inventory batch, so it produces a single replication update. The last command
+ * processed is acked through a replicated sequence number that arrives with that update,
+ * and the client then rebuilds its inventory from the authoritative list plus the commands
+ * still in flight - rejected or mispredicted commands are undone there. Since the inventory
+ * is shared, the server refuses every client command unless ValidateCommand is overridden
+ * with the game's own rules for who may add or remove what.
+ *
+ * Add to an actor owned by the player's connection (the PlayerState or PlayerController);
+ * the list only replicates to the owner. On the server, or without networking, the Queue*
+ * functions apply immediately.
+ */
+UCLASS(ClassGroup = (Inventory), meta = (BlueprintSpawnableComponent))
+class ADAPTIVEINVENTORY_API UInventoryReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryReplicationComponent();
+
+	//~ Begin UActorComponent Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+	/**
+	 * Add items from a definition (predicted on clients)
+	 * The server refuses client commands unless ValidateCommand is overridden to allow them,
+	 * so without that a client's add shows briefly and is rolled back.
+	 * @param Definition - Definition to create the item from
+	 * @param Quantity - Stack size
+	 * @return GUID the new item gets (if it doesn't stack into an existing one), invalid on failure
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	FGuid QueueAddItem(UInventoryItemDefinition* Definition, int32 Quantity = 1);
+
+	/**
+	 * Remove an item (predicted on clients)
+	 * Refused by the server like adds unless ValidateCommand accepts it.
+	 * @param ItemGUID - Item to remove
+	 * @return True if the removal was applied locally and queued
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	bool QueueRemoveItem(FGuid ItemGUID);
+
+	/**
+	 * Remove part of a stack (predicted on clients)
+	 * Refused by the server like adds unless ValidateCommand accepts it.
+	 * @param ItemGUID - Item to remove from
+	 * @param Quantity - Amount to remove
+	 * @return True if the removal was applied locally and queued
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	bool QueueRemoveItemQuantity(FGuid ItemGUID, int32 Quantity);
+
+	/**
+	 * Get the command buffer counters (client)
+	 * @return RPC, command and correction counts
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	FInventoryCommandStats GetCommandStats() const { return CommandStats; }
+
+	/**
+	 * Get how many commands are predicted but not yet acked (client)
+	 * @return Commands in flight
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	int32 GetNumPendingCommands() const { return PendingCommands.Num(); }
+
+	/** Most commands the server accepts in one RPC */
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory|Replication", meta = (ClampMin = "1"))
+	int32 MaxCommandsPerBatch = 64;
+
+	/**
+	 * Rebuild the replicated list from the subsystem (server only)
+	 * Done automatically on BeginPlay - only needed if the inventory changed without events.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	void ResyncFromInventory();
+
+	/**
+	 * Get how many items are in the replicated list
+	 * @return Replicated item count
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replication")
+	int32 GetNumReplicatedItems() const { return ReplicatedItems.Entries.Num(); }
+
+protected:
+	UFUNCTION()
+	void HandleInventoryBatchChanged(const FInventoryChangeDelta& Delta);
+
+	/**
+	 * Game-specific check for a client command, run on the server before the batch is applied
+	 * (e.g. that the loot being picked up is in reach). A failure rejects the whole batch.
+	 * Only the game knows where an added item could have come from, and which of the shared
+	 * inventory's items a player may take, so every command is refused unless an override
+	 * accepts it.
+	 * @param Command - Command to check
+	 * @return True if the command may be applied
+	 */
+	virtual bool ValidateCommand(const FInventoryCommand& Command) const;
+
+	/** One batch of client commands, sent once per tick */
+	UFUNCTION(Server, Reliable)
+	void ServerApplyCommands(const TArray<FInventoryCommand>& Commands);
+
+	UFUNCTION()
+	void OnRep_LastAppliedCommand();
+
+private:
+	friend struct FInventoryReplicatedEntry;
+	friend struct FInventoryReplicatedList;
+
+	// Server side
+
+	/** Add or refresh an item's entry */
+	void AddEntry(const UInventoryItemData* Item);
+	void RemoveEntry(const FGuid& ItemGUID);
+
+	/** Copy an item's stack and durability into its entry, dirtying it only if they changed */
+	void UpdateEntry(const UInventoryItemData* Item);
+
+	/** Check a batch against the current inventory, following stack counts through the batch */
+	bool ValidateCommands(UInventoryManagerSubsystem& Manager, const TArray<FInventoryCommand>& Commands) const;
+
+	// Client side
+
+	void HandleEntryAdded(const FInventoryReplicatedEntry& Entry);
+	void HandleEntryChanged(const FInventoryReplicatedEntry& Entry);
+	void HandleEntryRemoved(const FInventoryReplicatedEntry& Entry);
+	void HandleReceiveFinished();
+
+	/** Open a batch on the client's subsystem for the current update (clearing local items first time) */
+	UInventoryManagerSubsystem* BeginReceive();
+
+	/** Apply a command locally and buffer it for the server (or just apply it with authority) */
+	bool QueueCommand(FInventoryCommand Command);
+
+	/** Drop acked commands and rebuild the local inventory from the server's plus those still in flight */
+	void Reconcile(UInventoryManagerSubsystem& Manager);
+
+	UInventoryManagerSubsystem* GetInventoryManager() const;
+
+	UPROPERTY(Replicated)
+	FInventoryReplicatedList ReplicatedItems;
+
+	/** Sequence of the last client command the server processed */
+	UPROPERTY(ReplicatedUsing = OnRep_LastAppliedCommand)
+	uint32 LastAppliedCommand = 0;
+
+	/** GUID -> index into ReplicatedItems.Entries (server) */
+	TMap<FGuid, int32> EntryIndexByGUID;
+
+	/** Subsystem whose batch event is bound (server) */
+	TWeakObjectPtr<UInventoryManagerSubsystem> BoundManager;
+
+	/** Subsystem with a batch open for the update being received (client) */
+	TWeakObjectPtr<UInventoryManagerSubsystem> ReceivingManager;
+
+	/** The first update has replaced the client's local items */
+	bool bReceivedInitialState = false;
+
+	/** Predicted commands not yet acked, oldest first - the last NumUnsentCommands haven't been sent (client) */
+	TArray<FInventoryCommand> PendingCommands;
+	int32 NumUnsentCommands = 0;
+
+	/** Sequence given to the last queued command (client) */
+	uint32 LastQueuedCommand = 0;
+
+	/** Ack the local inventory was last reconciled against (client) */
+	uint32 ReconciledCommand = 0;
+
+	FInventoryCommandStats CommandStats;
+};
@@ -0,0 +1,267 @@
+// InventorySaveFormat.h
+// Compact, versioned binary layout for inventory save files
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UInventoryItemData;
+class UInventoryItemDefinition;
+
+/**
+ * On-disk layout (all fields little-endian, every section 4-byte aligned):
+ *
+ *   FInventorySaveHeader
+ *   Definition table  - NumDefinitions x { uint16 Length, UTF-8 bytes, uint32 DataSize, data }, padded to 4 bytes
+ *   Container table   - uint32 NumContainers, NumContainers x { uint16 Length, UTF-8 bytes }, padded to 4 bytes
+ *   Record table      - NumRecords x FInventorySaveRecord
+ *
+ * Records are fixed-size PODs, so a loader can read them straight out of a memory-mapped
+ * file without per-field deserialization. Definition IDs are written once and referenced
+ * by index from each record. Since version 2 each ID is followed by an FInventorySavedDefinition,
+ * so definitions that were created at runtime can be rebuilt by a process that never made them.
+ * Since version 3 the container table names the named containers, and a record in one of them
+ * carries its container and slot (older files only hold the default inventory).
+ *
+ * A file may instead be a compressed wrapper (FInventoryCompressedHeader + zlib data)
+ * around that same image; it has to be decompressed before it can be parsed.
+ */
+
+/** Fixed file header */
+struct FInventorySaveHeader
+{
+	/** Always FInventorySaveFormat::Magic */
+	uint32 Magic = 0;
+
+	/** Layout version the file was written with */
+	uint16 Version = 0;
+
+	/** Size of this header in bytes (lets newer versions grow it) */
+	uint16 HeaderSize = 0;
+
+	uint32 NumDefinitions = 0;
+	uint32 NumRecords = 0;
+
+	/** Byte offsets from the start of the file */
+	uint32 DefinitionTableOffset = 0;
+	uint32 RecordTableOffset = 0;
+
+	/** Total file size, to reject truncated files */
+	uint32 FileSize = 0;
+
+	/** CRC32 of everything after the header */
+	uint32 PayloadCrc = 0;
+};
+static_assert(sizeof(FInventorySaveHeader) == 32, "FInventorySaveHeader layout is part of the file format");
+
+/** Header of a compressed save file */
+struct FInventoryCompressedHeader
+{
+	/** Always FInventorySaveFormat::CompressedMagic */
+	uint32 Magic = 0;
+
+	uint32 UncompressedSize = 0;
+	uint32 CompressedSize = 0;
+
+	/** Unused */
+	uint32 Reserved = 0;
+};
+static_assert(sizeof(FInventoryCompressedHeader) == 16, "FInventoryCompressedHeader layout is part of the file format");
+
+/** Per-item record - the state that differs between two stacks of the same definition */
+struct FInventorySaveRecord
+{
+	/** FGuid components A-D */
+	uint32 Guid[4] = {};
+
+	/** Index into the definition table */
+	uint32 DefinitionIndex = 0;
+
+	int32 StackCount = 1;
+	float Durability = 0.0f;
+
+	/** Since version 3: 1 + index into the container table, or 0 for the default inventory (older files wrote 0 here) */
+	uint16 ContainerIndex = 0;
+
+	/** Since version 3: slot in that container (top-left cell in a grid container), RotatedSlotBit set if the footprint is turned */
+	uint16 ContainerSlot = 0;
+
+	static constexpr uint16 RotatedSlotBit = 0x8000;
+
+	/** Slots a record can address - no container may have more */
+	static constexpr int32 MaxContainerSlots = RotatedSlotBit;
+
+	int32 GetSlotIndex() const { return ContainerSlot & ~RotatedSlotBit; }
+	bool IsRotated() const { return (ContainerSlot & RotatedSlotBit) != 0; }
+};
+static_assert(sizeof(FInventorySaveRecord) == 32, "FInventorySaveRecord layout is part of the file format");
+
+/**
+ * Enough about a definition to get it back in a fresh process
+ * Definition assets are saved by path; definitions created at runtime have no asset to load,
+ * so their fields are saved instead (text as plain strings - runtime definitions aren't localized).
+ */
+struct ADAPTIVEINVENTORY_API FInventorySavedDefinition
+{
+	/** Object path of a definition asset - the fields below are unused when this is set */
+	FString AssetPath;
+
+	FString DisplayName;
+	FString Description;
+	FString IconPath;
+	uint8 Category = 0;
+	uint8 Rarity = 0;
+	bool bIsStackable = false;
+	int32 MaxStackSize = 1;
+	int32 GridWidth = 1;
+	int32 GridHeight = 1;
+	float MinDamage = 0.0f;
+	float MaxDamage = 0.0f;
+	float AttackSpeed = 1.0f;
+	float MaxDurability = 100.0f;
+	float Weight = 1.0f;
+
+	/** Capture a definition (by path if it is an asset) */
+	static FInventorySavedDefinition Capture(const UInventoryItemDefinition& Definition);
+
+	/**
+	 * Load the asset, or build a new definition from the saved fields
+	 * @param DefinitionId - ID the definition was saved under
+	 * @param Outer - Outer for a rebuilt runtime definition
+	 * @return The definition, or null if the asset couldn't be loaded
+	 */
+	UInventoryItemDefinition* Rebuild(FName DefinitionId, UObject* Outer) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FInventorySavedDefinition& Saved);
+};
+
+/** An item held in a named container, as passed to BuildSaveData */
+struct FInventorySaveContainerItem
+{
+	const UInventoryItemData* Item = nullptr;
+	FName ContainerName;
+
+	/** Below FInventorySaveRecord::MaxContainerSlots */
+	int32 SlotIndex = 0;
+	bool bRotated = false;
+};
+
+/** Save contents in memory - cheap to build on the game thread, serialized separately */
+struct ADAPTIVEINVENTORY_API FInventorySaveData
+{
+	/** Distinct definition IDs, referenced by FInventorySaveRecord::DefinitionIndex */
+	TArray<FName> DefinitionIds;
+
+	/** How to rebuild each entry of DefinitionIds */
+	TArray<FInventorySavedDefinition> Definitions;
+
+	/** Named containers, referenced by FInventorySaveRecord::ContainerIndex (1-based) */
+	TArray<FName> ContainerNames;
+
+	/** One record per item - the default inventory in order, then the named containers */
+	TArray<FInventorySaveRecord> Records;
+
+	/** Items skipped because they have no definition to save by */
+	int32 NumSkippedItems = 0;
+};
+
+/** Parsed view over a save file (records point into the source buffer) */
+struct ADAPTIVEINVENTORY_API FInventorySaveView
+{
+	uint16 Version = 0;
+
+	/** Identifies this exact save (journals record which save they apply to) */
+	uint32 PayloadCrc = 0;
+
+	TArray<FName> DefinitionIds;
+
+	/** Parallel to DefinitionIds - empty for version 1 files, which only stored the IDs */
+	TArray<FInventorySavedDefinition> Definitions;
+
+	/** Empty before version 3, when only the default inventory was saved */
+	TArray<FName> ContainerNames;
+
+	TConstArrayView<FInventorySaveRecord> Records;
+
+	/** Container a record was saved in (None = default inventory) */
+	FName GetContainerName(const FInventorySaveRecord& Record) const
+	{
+		return ContainerNames.IsValidIndex(Record.ContainerIndex - 1) ? ContainerNames[Record.ContainerIndex - 1] : NAME_None;
+	}
+};
+
+/**
+ * Reads and writes the inventory save layout
+ * Knows nothing about the subsystem - it converts between items, records and bytes.
+ */
+struct ADAPTIVEINVENTORY_API FInventorySaveFormat
+{
+	/** 'AINV' */
+	static constexpr uint32 Magic = 0x564E4941;
+
+	/** 'AINZ' - compressed wrapper */
+	static constexpr uint32 CompressedMagic = 0x5A4E4941;
+
+	/** Bump when the layout changes; Parse must keep reading older versions */
+	static constexpr uint16 CurrentVersion = 3;
+
+	/**
+	 * Capture the saved state of a list of items
+	 * @param Items - Items to capture, in order
+	 * @param OutData - Receives the definition table, container table and records
+	 * @param ContainerItems - Items held in named containers, recorded after Items with their slots
+	 */
+	static void BuildSaveData(TConstArrayView<UInventoryItemData*> Items, FInventorySaveData& OutData,
+		TConstArrayView<FInventorySaveContainerItem> ContainerItems = {});
+
+	/**
+	 * Write save data in the binary layout
+	 * @param Data - Data to write
+	 * @param OutBytes - Receives the file contents
+	 */
+	static void Serialize(const FInventorySaveData& Data, TArray<uint8>& OutBytes);
+
+	/**
+	 * Validate a file image and expose its contents
+	 * The buffer must stay alive (and 4-byte aligned) while the view is used.
+	 * @param Bytes - Complete file contents
+	 * @param OutView - Receives the definition IDs and a view of the records
+	 * @return False if the file is not a valid inventory save
+	 */
+	static bool Parse(TConstArrayView<uint8> Bytes, FInventorySaveView& OutView);
+
+	/**
+	 * Wrap a file image in a compressed container
+	 * @param Image - Output of Serialize
+	 * @param OutBytes - Receives the compressed file contents
+	 * @return False if compression failed
+	 */
+	static bool Compress(TConstArrayView<uint8> Image, TArray<uint8>& OutBytes);
+
+	/** Does a file start with the compressed wrapper header */
+	static bool IsCompressed(TConstArrayView<uint8> Bytes);
+
+	/**
+	 * Unwrap a compressed file back into a parseable image
+	 * @param Bytes - Complete compressed file contents
+	 * @param OutImage - Receives the uncompressed image
+	 * @return False if the wrapper is invalid or decompression failed
+	 */
+	static bool Decompress(TConstArrayView<uint8> Bytes, TArray<uint8>& OutImage);
+
+	/**
+	 * Serialize (and optionally compress) save data and write it to disk
+	 * Writes to a temporary file and renames it over the target, so a failed write never
+	 * leaves a half-written save behind. Safe to call from any thread.
+	 * @param Data - Data to write
+	 * @param FilePath - Destination file
+	 * @param bCompress - Write the compressed wrapper instead of the mappable image
+	 * @param OutPayloadCrc - Optionally receives the payload CRC of the written image
+	 * @return True if the file was written
+	 */
+	static bool WriteToFile(const FInventorySaveData& Data, const FString& FilePath, bool bCompress, uint32* OutPayloadCrc = nullptr);
+
+	/** Convert between FGuid and the record's packed form */
+	static void PackGuid(const FGuid& Guid, uint32 OutGuid[4]);
+	static FGuid UnpackGuid(const uint32 Guid[4]);
+};
@@ -0,0 +1,64 @@
+// InventorySearchIndex.h
+// Trigram index over normalized item names for fast substring search
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UInventoryItemData;
+
+/**
+ * Persistent substring-search index used by UInventoryManagerSubsystem
+ *
+ * Items are grouped by their normalized (lower-cased) name, so 10k stacks of "iron ore"
+ * are one name entry. Each distinct name is posted under every trigram it contains.
+ * A query of 3+ characters only looks at the names in its rarest trigram's posting list;
+ * shorter queries scan the distinct names instead of every item.
+ *
+ * Not a UObject - the owning subsystem keeps the items alive.
+ */
+class ADAPTIVEINVENTORY_API FInventorySearchIndex
+{
+public:
+	/** Index an item under its normalized name */
+	void AddItem(UInventoryItemData* Item);
+
+	/** Remove an item from the index */
+	void RemoveItem(UInventoryItemData* Item);
+
+	/** Drop everything */
+	void Reset();
+
+	/**
+	 * Find all items whose normalized name contains the query
+	 * @param NormalizedQuery - Lower-cased, non-empty search text
+	 * @param OutItems - Receives the matches (appended, in no particular order)
+	 */
+	void Search(const FString& NormalizedQuery, TArray<UInventoryItemData*>& OutItems) const;
+
+	/** Number of distinct names in the index */
+	int32 GetNumNames() const { return NameEntries.Num(); }
+
+private:
+	/** One distinct normalized name and every item carrying it */
+	struct FNameEntry
+	{
+		FString Name;
+		TSet<UInventoryItemData*> Items;
+	};
+
+	/** Pack three characters into a single key */
+	static uint64 MakeTrigram(const TCHAR* Chars);
+
+	/** Collect the distinct trigrams of a string */
+	static void GatherTrigrams(const FString& Text, TSet<uint64>& OutTrigrams);
+
+	/** Distinct names (ids are stable while the name is in use) */
+	TSparseArray<FNameEntry> NameEntries;
+
+	/** Normalized name -> id in NameEntries */
+	TMap<FString, int32> NameToEntry;
+
+	/** Trigram -> ids of names containing it */
+	TMap<uint64, TArray<int32>> TrigramPostings;
+};
@@ -0,0 +1,83 @@
+// InventorySnapshot.h
+// Immutable copy of the inventory that any thread can query
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemData.h"
+
+/** One item as it was when the snapshot was taken - plain data, no UObject access */
+struct ADAPTIVEINVENTORY_API FInventorySnapshotItem
+{
+	FGuid ItemGUID;
+	FName DefinitionId;
+	FString DisplayName;
+
+	/** Lower-cased name, what name searches match against */
+	FString NormalizedName;
+
+	EItemCategory Category = EItemCategory::Material;
+	EItemRarity Rarity = EItemRarity::Common;
+
+	int32 StackSize = 1;
+	int32 MaxStackSize = 1;
+	float Durability = 0.0f;
+	float MaxDurability = 0.0f;
+	float MinDamage = 0.0f;
+	float MaxDamage = 0.0f;
+	float AttackSpeed = 0.0f;
+	float Weight = 0.0f;
+
+	/** Copy an item's current state (game thread) */
+	static FInventorySnapshotItem Capture(const UInventoryItemData& Item);
+};
+
+/** Items are shared between snapshots - a new snapshot only copies the ones that changed */
+using FInventorySnapshotItemRef = TSharedRef<const FInventorySnapshotItem, ESPMode::ThreadSafe>;
+
+/**
+ * Read-only view of the default inventory at one point in time
+ *
+ * Published by UInventoryManagerSubsystem after each batch of changes (when read snapshots
+ * are enabled) and never modified afterwards, so a snapshot can be queried from any thread
+ * while the game thread keeps changing the inventory. Hold the pointer for as long as the
+ * query needs it; the next batch publishes a new snapshot rather than touching this one.
+ *
+ * Queries are plain scans in inventory order - the subsystem's indices aren't copied.
+ */
+class ADAPTIVEINVENTORY_API FInventorySnapshot
+{
+public:
+	FInventorySnapshot(uint64 InVersion, TArray<FInventorySnapshotItemRef>&& InItems);
+
+	/** Increases by one with every snapshot the subsystem publishes */
+	uint64 GetVersion() const { return Version; }
+
+	TConstArrayView<FInventorySnapshotItemRef> GetItems() const { return Items; }
+	int32 GetItemCount() const { return Items.Num(); }
+
+	/** Sum of stack sizes */
+	int32 GetTotalItemQuantity() const { return TotalQuantity; }
+
+	/** Sum of weight * stack size */
+	float GetTotalWeight() const { return static_cast<float>(TotalWeight); }
+
+	/** Linear lookup by GUID (null if the item wasn't in the inventory) */
+	const FInventorySnapshotItem* FindItemByGUID(const FGuid& ItemGUID) const;
+
+	// Queries - pointers stay valid while the snapshot is held
+	TArray<const FInventorySnapshotItem*> GetItemsByCategory(EItemCategory Category) const;
+	TArray<const FInventorySnapshotItem*> GetItemsByRarity(EItemRarity Rarity) const;
+
+	/** Partial, case-insensitive name match - all items for an empty search, like the subsystem's */
+	TArray<const FInventorySnapshotItem*> SearchItemsByName(const FString& SearchText) const;
+
+private:
+	const uint64 Version;
+	const TArray<FInventorySnapshotItemRef> Items;
+
+	int32 TotalQuantity = 0;
+	double TotalWeight = 0.0;
+};
+
+using FInventorySnapshotPtr = TSharedPtr<const FInventorySnapshot, ESPMode::ThreadSafe>;
@@ -0,0 +1,120 @@
+// InventorySort.h
+// Packed-key radix sort for ordering inventory items
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventorySort.generated.h"
+
+class UInventoryItemData;
+
+/**
+ * Item property an inventory sort can order by
+ */
+UENUM(BlueprintType)
+enum class EInventorySortKey : uint8
+{
+	Rarity      UMETA(DisplayName = "Rarity"),
+	Category    UMETA(DisplayName = "Category"),
+	Name        UMETA(DisplayName = "Name"),
+	StackSize   UMETA(DisplayName = "Stack Size"),
+	Weight      UMETA(DisplayName = "Weight")
+};
+
+/**
+ * One level of a multi-key sort (e.g. rarity descending, then category, then name)
+ */
+USTRUCT(BlueprintType)
+struct ADAPTIVEINVENTORY_API FInventorySortCriterion
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory|Sort")
+	EInventorySortKey Key = EInventorySortKey::Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory|Sort")
+	bool bDescending = false;
+};
+
+/**
+ * Stable multi-key sort over inventory items
+ *
+ * Every criterion becomes a fixed-width integer field, packed most significant first into
+ * one or two 64-bit words per item, so items are ordered by comparing words - never FText or
+ * FString. Names are mapped to their rank in a cached, collated list of the distinct
+ * normalized names; only a name that hasn't been seen before re-collates the list.
+ * Sorting is an LSD radix sort over item indices that skips every byte that is the same
+ * for all items, so a rarity/category/name sort is usually only a handful of passes.
+ *
+ * Not a UObject - owned by whoever sorts (the subsystem, a grid widget).
+ */
+class ADAPTIVEINVENTORY_API FInventorySorter
+{
+public:
+	/** Replace the criteria (an empty list means no sort) */
+	void SetCriteria(TConstArrayView<FInventorySortCriterion> InCriteria);
+
+	const TArray<FInventorySortCriterion>& GetCriteria() const { return Criteria; }
+
+	bool HasCriteria() const { return Criteria.Num() > 0; }
+
+	/** Does the order depend on a key that changes while an item is stored */
+	bool UsesStackSize() const;
+
+	/**
+	 * Sort items (stable - equal items keep their relative order)
+	 * @param Items - Items to order
+	 * @param OutOrder - Receives indices into Items, in sorted order
+	 */
+	void Sort(TConstArrayView<UInventoryItemData*> Items, TArray<int32>& OutOrder);
+
+	/**
+	 * Find where an item goes in a list that is already sorted by the current criteria
+	 * @param SortedItems - Sorted list
+	 * @param Item - Item to insert
+	 * @return Index after every item that sorts equal to it
+	 */
+	int32 FindInsertIndex(TConstArrayView<UInventoryItemData*> SortedItems, const UInventoryItemData* Item);
+
+private:
+	/** Where a criterion lives in the packed key */
+	struct FField
+	{
+		EInventorySortKey Key;
+		bool bDescending;
+		int32 Word;
+		int32 Shift;
+		int32 Bits;
+	};
+
+	/** Packed key words for one item, most significant word first */
+	void MakeKey(const UInventoryItemData* Item, uint64* OutWords) const;
+
+	/** Does any criterion sort by name */
+	bool UsesName() const;
+
+	/** Add any names not yet in the collation cache */
+	void RegisterNames(TConstArrayView<UInventoryItemData*> Items);
+
+	/** Add one name to the cache (uncollated) - returns false if it was already known */
+	bool AddName(const FString& NormalizedName);
+
+	/** Sort the cached names and renumber their ranks */
+	void CollateNames();
+
+	/** Position of a normalized name in the collated list */
+	uint32 GetNameRank(const FString& NormalizedName) const;
+
+	/** Orderable integer for a float (negative values before positive) */
+	static uint32 FloatToOrderedBits(float Value);
+
+	TArray<FInventorySortCriterion> Criteria;
+	TArray<FField> Fields;
+	int32 NumWords = 0;
+
+	/** Distinct normalized names, collated */
+	TArray<FString> SortedNames;
+
+	/** Normalized name -> index in SortedNames */
+	TMap<FString, uint32> NameRanks;
+};
@@ -0,0 +1,96 @@
+// InventorySpatialGrid.h
+// Bitset occupancy grid for Tetris-style item placement
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventorySpatialGrid.generated.h"
+
+/**
+ * How a grid container picks a spot for an item when no position is given
+ */
+UENUM(BlueprintType)
+enum class EInventoryPlacementMode : uint8
+{
+	// Top-most, then left-most free spot
+	FirstFit    UMETA(DisplayName = "First Fit"),
+	// Free spot touching the most edges and items (keeps open space in one piece)
+	BestFit     UMETA(DisplayName = "Best Fit")
+};
+
+/**
+ * Occupancy of a W x H cell grid, one 64-bit word per row
+ *
+ * Bit X of Rows[Y] is set when cell (X, Y) is taken. A free-rectangle test is one AND per row,
+ * and finding every position in a row band where a W-wide item fits is a handful of
+ * shift-and-ANDs over the combined row word, so placement never visits individual cells.
+ *
+ * Grids are at most 64 columns wide. Not a UObject - owned by the container using it.
+ */
+class ADAPTIVEINVENTORY_API FInventorySpatialGrid
+{
+public:
+	/** Widest supported grid (one word per row) */
+	static constexpr int32 MaxWidth = 64;
+
+	/**
+	 * Size the grid and mark every cell free
+	 * @param InWidth - Columns (1 to MaxWidth)
+	 * @param InHeight - Rows
+	 */
+	void Init(int32 InWidth, int32 InHeight);
+
+	/** Mark every cell free */
+	void Reset();
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	/** Is the rectangle inside the grid and completely free */
+	bool IsAreaFree(FIntPoint Position, FIntPoint Size) const;
+
+	/** Mark a rectangle taken (must be inside the grid) */
+	void Fill(FIntPoint Position, FIntPoint Size);
+
+	/** Mark a rectangle free (must be inside the grid) */
+	void Clear(FIntPoint Position, FIntPoint Size);
+
+	/** Number of free cells */
+	int32 GetNumFreeCells() const;
+
+	/**
+	 * Find a spot for an item
+	 * @param Size - Item footprint (columns, rows)
+	 * @param bAllowRotation - Also try the footprint turned 90 degrees
+	 * @param Mode - First-fit or best-fit
+	 * @param OutPosition - Receives the top-left cell
+	 * @param bOutRotated - Receives whether the rotated footprint was used
+	 * @return False if the item fits nowhere
+	 */
+	bool FindPlacement(FIntPoint Size, bool bAllowRotation, EInventoryPlacementMode Mode, FIntPoint& OutPosition, bool& bOutRotated) const;
+
+private:
+	/** Bits X..X+W-1 */
+	static uint64 MakeRowMask(int32 X, int32 W);
+
+	/** Bitmask of every column where a W x H rectangle starting on row Y is free */
+	uint64 FindFreeRunStarts(int32 Y, int32 W, int32 H) const;
+
+	/** Top-most, left-most free spot */
+	bool FindFirstFit(int32 W, int32 H, FIntPoint& OutPosition) const;
+
+	/** Free spot with the highest contact score */
+	bool FindBestFit(int32 W, int32 H, FIntPoint& OutPosition, int32& OutScore) const;
+
+	/** Grid edges and taken cells bordering a rectangle */
+	int32 CalculateContactScore(int32 X, int32 Y, int32 W, int32 H) const;
+
+	/** Occupancy bits, one word per row */
+	TArray<uint64> Rows;
+
+	/** Bits that lie inside the grid */
+	uint64 FullRowMask = 0;
+
+	int32 Width = 0;
+	int32 Height = 0;
+};
@@ -111,6 +111,18 @@ struct FInventorySlotStyle
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Colors|StackCount")
 	FLinearColor StackCountFullText = FLinearColor(0.290f, 0.871f, 0.502f, 1.0f);
 
+	// ----------------------------------------
+	// Icons
+	// ----------------------------------------
+
+	/** Shown while an item's icon is streaming in (none = dimmed empty icon) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
+	TObjectPtr<UTexture2D> PlaceholderIcon = nullptr;
+
+	/** Tint for the placeholder icon */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
+	FLinearColor PlaceholderTint = FLinearColor(0.5f, 0.5f, 0.5f, 0.5f);
+
 	// ----------------------------------------
 	// Rarity Colors
 	// ----------------------------------------
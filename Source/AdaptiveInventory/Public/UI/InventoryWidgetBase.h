@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Core/InventoryManagerSubsystem.h"
 #include "InventoryWidgetBase.generated.h"
 
 // Forward declarations
@@ -100,6 +101,11 @@ protected:
 	void OnItemStackChanged(FGuid ItemGUID, int32 NewStackSize);
 	virtual void OnItemStackChanged_Implementation(FGuid ItemGUID, int32 NewStackSize);
 	
+	/** Called once per batch of mutations with everything that changed (just before OnInventoryChanged) */
+	UFUNCTION(BlueprintNativeEvent, Category = "Inventory Widget|Events")
+	void OnInventoryBatchChanged(const FInventoryChangeDelta& Delta);
+	virtual void OnInventoryBatchChanged_Implementation(const FInventoryChangeDelta& Delta);
+	
 private:
 	/** Cached reference to the inventory manager subsystem */
 	UPROPERTY()
@@ -0,0 +1,261 @@
+// InventoryGridPanel.cpp
+// UMG wrapper for SInventoryGrid
+
+#include "UI/InventoryGridPanel.h"
+#include "UI/SInventoryGrid.h"
+#include "UI/InventoryStyleData.h"
+#include "Core/InventoryManagerSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+
+#define LOCTEXT_NAMESPACE "InventoryGridPanel"
+
+// ----------------------------------------
+// Widget Lifecycle
+// ----------------------------------------
+
+TSharedRef<SWidget> UInventoryGridPanel::RebuildWidget()
+{
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+
+	MyGrid = SNew(SInventoryGrid)
+		.Columns(GridColumns)
+		.MinimumSlots(MinimumSlots)
+		.SlotStyle(GetSlotStyle())
+		.IconCache(Manager ? Manager -> GetIconCache() : nullptr)
+		.OnSlotClicked(FOnInventoryGridSlotEvent::CreateUObject(this, &UInventoryGridPanel::HandleSlotClicked));
+
+	BindInventoryEvents();
+	Refresh();
+
+	return MyGrid.ToSharedRef();
+}
+
+void UInventoryGridPanel::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+
+	if (MyGrid)
+	{
+		MyGrid -> SetColumns(GridColumns);
+		MyGrid -> SetMinimumSlots(MinimumSlots);
+		MyGrid -> SetSlotStyle(GetSlotStyle());
+	}
+}
+
+void UInventoryGridPanel::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	UnbindInventoryEvents();
+	MyGrid.Reset();
+}
+
+#if WITH_EDITOR
+const FText UInventoryGridPanel::GetPaletteCategory()
+{
+	return LOCTEXT("Inventory", "Inventory");
+}
+#endif
+
+// ----------------------------------------
+// Content
+// ----------------------------------------
+
+void UInventoryGridPanel::Refresh()
+{
+	// One copy, into the list the panel keeps anyway
+	TArray<UInventoryItemData*>& SourceItems = ToRawPtrTArrayUnsafe(DisplayItems);
+	SourceItems.Reset();
+	if (UInventoryManagerSubsystem* Manager = GetInventoryManager())
+	{
+		if (SourceContainer.IsNone())
+		{
+			SourceItems.Append(Manager -> GetItems());
+		}
+		else
+		{
+			SourceItems = Manager -> GetContainerItems(SourceContainer);
+		}
+	}
+
+	SlotsByGUID.Reset();
+	for (int32 i = 0; i < SourceItems.Num(); i++)
+	{
+		SlotsByGUID.Add(SourceItems[i] -> GetItemGUID(), i);
+	}
+
+	if (SelectedItem && !SlotsByGUID.Contains(SelectedItem -> GetItemGUID()))
+	{
+		SelectedItem = nullptr;
+	}
+
+	if (MyGrid)
+	{
+		MyGrid -> SetItems(SourceItems);
+		const int32* SelectedSlot = SelectedItem ? SlotsByGUID.Find(SelectedItem -> GetItemGUID()) : nullptr;
+		MyGrid -> SetSelectedIndex(SelectedSlot ? *SelectedSlot : INDEX_NONE);
+	}
+}
+
+void UInventoryGridPanel::ApplyChangeDelta(const FInventoryChangeDelta& Delta)
+{
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	const TConstArrayView<UInventoryItemData*> Items = Manager ? Manager -> GetItems() : TConstArrayView<UInventoryItemData*>();
+
+	// A reorder can put any item in any slot, and a count that doesn't add up means the delta doesn't describe the list
+	if (!MyGrid || Delta.bOrderChanged || DisplayItems.Num() - Delta.RemovedItems.Num() + Delta.AddedItems.Num() != Items.Num())
+	{
+		Refresh();
+		return;
+	}
+
+	// Without a reorder, adds land at the end and a removal only shifts the slots after its own down
+	// (a swap-remove that moves the last item forward is reported as a reorder)
+	int32 FirstChangedSlot = DisplayItems.Num();
+	for (const FGuid& ItemGUID : Delta.RemovedItems)
+	{
+		if (const int32* SlotIndex = SlotsByGUID.Find(ItemGUID))
+		{
+			FirstChangedSlot = FMath::Min(FirstChangedSlot, *SlotIndex);
+		}
+	}
+
+	// Stack changes were already shown by HandleItemStackChanged, and durability isn't drawn
+	ChangedSlots.Reset();
+	for (int32 i = FirstChangedSlot; i < Items.Num(); i++)
+	{
+		if (!DisplayItems.IsValidIndex(i) || DisplayItems[i] != Items[i])
+		{
+			ChangedSlots.Add(i);
+		}
+	}
+	if (ChangedSlots.IsEmpty() && DisplayItems.Num() == Items.Num())
+	{
+		return;
+	}
+
+	// Forget what left those slots before recording what arrived, since an item can shift from one changed slot to another
+	for (const int32 SlotIndex : ChangedSlots)
+	{
+		if (DisplayItems.IsValidIndex(SlotIndex))
+		{
+			SlotsByGUID.Remove(DisplayItems[SlotIndex] -> GetItemGUID());
+		}
+	}
+	for (int32 i = Items.Num(); i < DisplayItems.Num(); i++)
+	{
+		SlotsByGUID.Remove(DisplayItems[i] -> GetItemGUID());
+	}
+
+	DisplayItems.SetNum(Items.Num(), EAllowShrinking::No);
+	for (const int32 SlotIndex : ChangedSlots)
+	{
+		DisplayItems[SlotIndex] = Items[SlotIndex];
+		SlotsByGUID.Add(Items[SlotIndex] -> GetItemGUID(), SlotIndex);
+	}
+
+	MyGrid -> UpdateSlots(Items, ChangedSlots);
+
+	const int32* SelectedSlot = SelectedItem ? SlotsByGUID.Find(SelectedItem -> GetItemGUID()) : nullptr;
+	if (!SelectedSlot)
+	{
+		SelectedItem = nullptr;
+	}
+	MyGrid -> SetSelectedIndex(SelectedSlot ? *SelectedSlot : INDEX_NONE);
+}
+
+void UInventoryGridPanel::SelectItem(UInventoryItemData* Item)
+{
+	const int32* SlotIndex = Item ? SlotsByGUID.Find(Item -> GetItemGUID()) : nullptr;
+	SelectedItem = SlotIndex ? Item : nullptr;
+
+	if (MyGrid)
+	{
+		MyGrid -> SetSelectedIndex(SlotIndex ? *SlotIndex : INDEX_NONE);
+	}
+
+	OnItemSelected.Broadcast(SelectedItem);
+}
+
+void UInventoryGridPanel::HandleSlotClicked(int32 SlotIndex)
+{
+	SelectItem(DisplayItems.IsValidIndex(SlotIndex) ? DisplayItems[SlotIndex].Get() : nullptr);
+}
+
+const FInventorySlotStyle& UInventoryGridPanel::GetSlotStyle() const
+{
+	return StyleData ? StyleData -> GetSlotStyle() : SlotStyle;
+}
+
+// ----------------------------------------
+// Inventory Events
+// ----------------------------------------
+
+UInventoryManagerSubsystem* UInventoryGridPanel::GetInventoryManager() const
+{
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GetWorld());
+	return GameInstance ? GameInstance -> GetSubsystem<UInventoryManagerSubsystem>() : nullptr;
+}
+
+void UInventoryGridPanel::BindInventoryEvents()
+{
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!Manager || BoundManager == Manager) return;
+
+	UnbindInventoryEvents();
+
+	Manager -> OnInventoryBatchChanged.AddDynamic(this, &UInventoryGridPanel::HandleInventoryBatchChanged);
+	Manager -> OnItemStackChanged.AddDynamic(this, &UInventoryGridPanel::HandleItemStackChanged);
+	Manager -> OnContainerItemAdded.AddDynamic(this, &UInventoryGridPanel::HandleContainerItemAdded);
+	Manager -> OnContainerItemRemoved.AddDynamic(this, &UInventoryGridPanel::HandleContainerItemRemoved);
+	BoundManager = Manager;
+}
+
+void UInventoryGridPanel::UnbindInventoryEvents()
+{
+	if (UInventoryManagerSubsystem* Manager = BoundManager.Get())
+	{
+		Manager -> OnInventoryBatchChanged.RemoveDynamic(this, &UInventoryGridPanel::HandleInventoryBatchChanged);
+		Manager -> OnItemStackChanged.RemoveDynamic(this, &UInventoryGridPanel::HandleItemStackChanged);
+		Manager -> OnContainerItemAdded.RemoveDynamic(this, &UInventoryGridPanel::HandleContainerItemAdded);
+		Manager -> OnContainerItemRemoved.RemoveDynamic(this, &UInventoryGridPanel::HandleContainerItemRemoved);
+	}
+	BoundManager.Reset();
+}
+
+void UInventoryGridPanel::HandleInventoryBatchChanged(const FInventoryChangeDelta& Delta)
+{
+	// Fires once per batch; container moves also pass through here when they touch the default inventory
+	if (SourceContainer.IsNone())
+	{
+		ApplyChangeDelta(Delta);
+	}
+}
+
+void UInventoryGridPanel::HandleItemStackChanged(FGuid ItemGUID, int32 NewStackSize)
+{
+	// Only the one slot is re-read
+	const int32* SlotIndex = SlotsByGUID.Find(ItemGUID);
+	if (SlotIndex && MyGrid)
+	{
+		MyGrid -> RefreshSlot(*SlotIndex, DisplayItems[*SlotIndex]);
+	}
+}
+
+void UInventoryGridPanel::HandleContainerItemAdded(FName ContainerName, UInventoryItemData* Item, int32 SlotIndex)
+{
+	if (!SourceContainer.IsNone() && ContainerName == SourceContainer)
+	{
+		Refresh();
+	}
+}
+
+void UInventoryGridPanel::HandleContainerItemRemoved(FName ContainerName, FGuid ItemGUID, int32 SlotIndex)
+{
+	if (!SourceContainer.IsNone() && ContainerName == SourceContainer)
+	{
+		Refresh();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
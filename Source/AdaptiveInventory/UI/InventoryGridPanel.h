@@ -0,0 +1,124 @@
+// InventoryGridPanel.h
+// UMG wrapper for SInventoryGrid
+// Fast-path alternative to UInventoryGridWidget for large inventories
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "UI/InventoryStyleTypes.h"
+#include "UI/InventoryGridWidget.h"
+#include "InventoryGridPanel.generated.h"
+
+class SInventoryGrid;
+class UInventoryManagerSubsystem;
+class UInventoryStyleData;
+
+/**
+ * Inventory grid drawn by a single Slate widget
+ *
+ * Shows the same items as UInventoryGridWidget (default inventory or a named container, in
+ * order) and listens to the same subsystem events, but has no per-slot UUserWidgets - slots
+ * are painted directly by SInventoryGrid. Uses the same FInventorySlotStyle / style asset.
+ * Changes to the default inventory are applied from the batch delta, re-reading only the
+ * slots whose item changed; a reorder or a named container re-reads everything.
+ * Place it inside a ScrollBox for long inventories; only visible rows are painted.
+ */
+UCLASS()
+class ADAPTIVEINVENTORY_API UInventoryGridPanel : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWidget Interface
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+#if WITH_EDITOR
+	virtual const FText GetPaletteCategory() override;
+#endif
+	//~ End UWidget Interface
+
+	/** Re-read every item from the subsystem */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid Panel")
+	void Refresh();
+
+	/** Select an item (highlights its slot, broadcasts OnItemSelected) */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid Panel")
+	void SelectItem(UInventoryItemData* Item);
+
+	/** Get currently selected item */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid Panel")
+	UInventoryItemData* GetSelectedItem() const { return SelectedItem; }
+
+	/** Fired when an item is selected (nullptr when an empty slot is clicked) */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory Grid Panel|Events")
+	FOnItemSelected OnItemSelected;
+
+	/** Number of slots per row */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Grid Panel", meta = (ClampMin = "1"))
+	int32 GridColumns = 5;
+
+	/** Slots shown even when there are fewer items (empty slots) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Grid Panel", meta = (ClampMin = "0"))
+	int32 MinimumSlots = 20;
+
+	/** Container to display (None = the default inventory) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Grid Panel")
+	FName SourceContainer;
+
+	/** Shared style asset - takes priority over SlotStyle */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Grid Panel|Style")
+	TObjectPtr<UInventoryStyleData> StyleData;
+
+	/** Slot style used when no style asset is set */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory Grid Panel|Style")
+	FInventorySlotStyle SlotStyle;
+
+protected:
+	//~ Begin UWidget Interface
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	//~ End UWidget Interface
+
+	UFUNCTION()
+	void HandleInventoryBatchChanged(const FInventoryChangeDelta& Delta);
+
+	UFUNCTION()
+	void HandleItemStackChanged(FGuid ItemGUID, int32 NewStackSize);
+
+	UFUNCTION()
+	void HandleContainerItemAdded(FName ContainerName, UInventoryItemData* Item, int32 SlotIndex);
+
+	UFUNCTION()
+	void HandleContainerItemRemoved(FName ContainerName, FGuid ItemGUID, int32 SlotIndex);
+
+private:
+	void HandleSlotClicked(int32 SlotIndex);
+
+	/** Update only the slots a batch of default-inventory changes touched (falls back to Refresh on a reorder) */
+	void ApplyChangeDelta(const FInventoryChangeDelta& Delta);
+
+	UInventoryManagerSubsystem* GetInventoryManager() const;
+
+	void BindInventoryEvents();
+	void UnbindInventoryEvents();
+
+	const FInventorySlotStyle& GetSlotStyle() const;
+
+	TSharedPtr<SInventoryGrid> MyGrid;
+
+	/** Items in slot order, as last pushed to the Slate grid */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInventoryItemData>> DisplayItems;
+
+	/** GUID -> slot, for single-slot stack updates and locating removals */
+	TMap<FGuid, int32> SlotsByGUID;
+
+	/** Slots a change touched, kept between changes so applying one doesn't allocate */
+	TArray<int32> ChangedSlots;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInventoryItemData> SelectedItem;
+
+	/** Subsystem whose events are bound */
+	TWeakObjectPtr<UInventoryManagerSubsystem> BoundManager;
+};
@@ -6,6 +6,13 @@
 #include "Core/InventoryManagerSubsystem.h"
 #include "Components/UniformGridPanel.h"
 #include "Components/ScrollBox.h"
+#include "Components/ScrollBoxSlot.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+TRACE_DECLARE_INT_COUNTER(InventoryGridSlotsUpdated, TEXT("Inventory/GridSlotsUpdated"));
 
 // ----------------------------------------
 // Lifecycle
@@ -23,24 +30,61 @@ void UInventoryGridWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
 	
+	if (ScrollBox)
+	{
+		ScrollBox -> OnUserScrolled.AddDynamic(this, &UInventoryGridWidget::HandleUserScrolled);
+	}
+	
+	// Container items don't go through the default inventory events
+	if (UInventoryManagerSubsystem* Manager = GetInventoryManager(); Manager && !SourceContainer.IsNone())
+	{
+		Manager -> OnContainerItemAdded.AddDynamic(this, &UInventoryGridWidget::HandleContainerItemAdded);
+		Manager -> OnContainerItemRemoved.AddDynamic(this, &UInventoryGridWidget::HandleContainerItemRemoved);
+	}
+	
 	CreateSlots();
 	PopulateGrid();
 }
 
 void UInventoryGridWidget::NativeDestruct()
 {
+	if (ScrollBox)
+	{
+		ScrollBox -> OnUserScrolled.RemoveDynamic(this, &UInventoryGridWidget::HandleUserScrolled);
+	}
+	
+	if (UInventoryManagerSubsystem* Manager = GetInventoryManager())
+	{
+		Manager -> OnContainerItemAdded.RemoveDynamic(this, &UInventoryGridWidget::HandleContainerItemAdded);
+		Manager -> OnContainerItemRemoved.RemoveDynamic(this, &UInventoryGridWidget::HandleContainerItemRemoved);
+	}
+	
+	CancelPendingRefresh();
 	ClearAllSlots();
 	PooledSlots.Empty();
 	
 	Super::NativeDestruct();
 }
 
+void UInventoryGridWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+	
+	// Continue a time-sliced refresh where the last frame's budget ran out
+	if (IsRefreshPending())
+	{
+		ProcessPendingSlots();
+	}
+}
+
 // ----------------------------------------
 // Refresh & Events
 // ----------------------------------------
 
 void UInventoryGridWidget::RefreshWidget_Implementation()
 {
+	// Explicit refresh - rebuild the filtered view from scratch
+	bFilteredViewDirty = true;
 	PopulateGrid();
 }
 
@@ -49,11 +93,41 @@ void UInventoryGridWidget::OnInventoryChanged_Implementation()
 	PopulateGrid();
 }
 
-void UInventoryGridWidget::OnItemAdded_Implementation(UInventoryItemData* AddedItem)
+void UInventoryGridWidget::OnInventoryBatchChanged_Implementation(const FInventoryChangeDelta& Delta)
 {
+	// OnInventoryChanged follows and pushes the patched view into the slots
+	if (SourceContainer.IsNone())
+	{
+		ApplyDeltaToFilteredView(Delta);
+	}
+}
+
+void UInventoryGridWidget::HandleContainerItemAdded(FName ContainerName, UInventoryItemData* Item, int32 SlotIndex)
+{
+	if (ContainerName != SourceContainer) return;
+	
+	bFilteredViewDirty = true;
+	PopulateGrid();
+}
+
+void UInventoryGridWidget::HandleContainerItemRemoved(FName ContainerName, FGuid ItemGUID, int32 SlotIndex)
+{
+	if (ContainerName != SourceContainer) return;
+	
+	if (SelectedItem && SelectedItem -> GetItemGUID() == ItemGUID)
+	{
+		ClearSelection();
+	}
+	
+	bFilteredViewDirty = true;
 	PopulateGrid();
 }
 
+void UInventoryGridWidget::OnItemAdded_Implementation(UInventoryItemData* AddedItem)
+{
+	// OnInventoryChanged follows once per batch and repopulates the grid
+}
+
 void UInventoryGridWidget::OnItemRemoved_Implementation(FGuid ItemGUID)
 {
 	// If removed item was selected, clear selection
@@ -62,7 +136,7 @@ void UInventoryGridWidget::OnItemRemoved_Implementation(FGuid ItemGUID)
 		ClearSelection();
 	}
 	
-	PopulateGrid();
+	// OnInventoryChanged follows once per batch and repopulates the grid
 }
 
 void UInventoryGridWidget::OnItemStackChanged_Implementation(FGuid ItemGUID, int32 NewStackSize)
@@ -81,27 +155,127 @@ void UInventoryGridWidget::OnItemStackChanged_Implementation(FGuid ItemGUID, int
 
 void UInventoryGridWidget::CreateSlots_Implementation()
 {
-	if (!SlotGrid) return;
+	if (!SlotGrid && !IsSpatial()) return;
 	if (!SlotWidgetClass) return;
 	
+	// Spatial mode creates one slot per item as the container fills
+	if (IsSpatial()) return;
+	
 	// Create Initial Slots
-	for (int32 i = 0; i < TotalSlots; i++)
+	EnsureSlotCount(IsVirtualized() ? CalculateVirtualSlotCount() : TotalSlots);
+}
+
+UInventorySlotWidget* UInventoryGridWidget::AddSlotToGrid()
+{
+	UInventorySlotWidget* Slot = GetOrCreateSlot();
+	if (!Slot) return nullptr;
+	
+	const int32 i = ActiveSlots.Num();
+	Slot -> SetSlotIndex(i);
+	
+	// Bind Events
+	Slot -> OnSlotClicked.AddDynamic(this, &UInventoryGridWidget::HandleSlotClicked);
+	Slot -> OnSlotHovered.AddDynamic(this, &UInventoryGridWidget::HandleSlotHovered);
+	
+	// Add to grid - spatial slots are positioned per item in RefreshVisibleSlots
+	if (IsSpatial())
 	{
-		UInventorySlotWidget* Slot = GetOrCreateSlot();
-		if (!Slot) continue;
-		
-		Slot -> SetSlotIndex(i);
-		
-		// Bind Events
-		Slot -> OnSlotClicked.AddDynamic(this, &UInventoryGridWidget::HandleSlotClicked);
-		Slot -> OnSlotHovered.AddDynamic(this, &UInventoryGridWidget::HandleSlotHovered);
-		
-		// Add to grid
-		int32 Row = i / GridColumns;
-		int32 Column = i % GridColumns;
+		SpatialCanvas -> AddChildToCanvas(Slot);
+	}
+	else
+	{
+		const int32 Columns = FMath::Max(1, GridColumns);
+		int32 Row = i / Columns;
+		int32 Column = i % Columns;
 		SlotGrid -> AddChildToUniformGrid(Slot, Row, Column);
-		
-		ActiveSlots.Add(Slot);
+	}
+	
+	ActiveSlots.Add(Slot);
+	return Slot;
+}
+
+void UInventoryGridWidget::EnsureSlotCount(int32 DesiredCount)
+{
+	if ((!SlotGrid && !IsSpatial()) || !SlotWidgetClass) return;
+	
+	// Grow from the pool
+	while (ActiveSlots.Num() < DesiredCount)
+	{
+		if (!AddSlotToGrid()) break;
+	}
+	
+	// Shrink back into the pool
+	while (ActiveSlots.Num() > DesiredCount)
+	{
+		UInventorySlotWidget* Slot = ActiveSlots.Pop();
+		if (Slot)
+		{
+			Slot -> OnSlotClicked.RemoveDynamic(this, &UInventoryGridWidget::HandleSlotClicked);
+			Slot -> OnSlotHovered.RemoveDynamic(this, &UInventoryGridWidget::HandleSlotHovered);
+			if (Slot == SelectedSlot)
+			{
+				SelectedSlot = nullptr;
+			}
+			ReturnSlotToPool(Slot);
+		}
+	}
+}
+
+// ----------------------------------------
+// Virtualization
+// ----------------------------------------
+
+int32 UInventoryGridWidget::CalculateVirtualSlotCount() const
+{
+	const int32 Columns = FMath::Max(1, GridColumns);
+	const float ViewportHeight = ScrollBox ? ScrollBox -> GetCachedGeometry().GetLocalSize().Y : 0.0f;
+	
+	// Before the first layout pass the viewport has no size yet - fall back to TotalSlots
+	int32 VisibleRows = FMath::DivideAndRoundUp(FMath::Max(1, TotalSlots), Columns);
+	if (ViewportHeight > 0.0f)
+	{
+		// +1 for the partially visible row at the bottom
+		VisibleRows = FMath::CeilToInt(ViewportHeight / FMath::Max(1.0f, SlotRowHeight)) + 1;
+	}
+	
+	return (VisibleRows + OverscanRows * 2) * Columns;
+}
+
+void UInventoryGridWidget::UpdateVirtualPadding()
+{
+	UScrollBoxSlot* GridSlot = SlotGrid ? Cast<UScrollBoxSlot>(SlotGrid -> Slot) : nullptr;
+	if (!GridSlot) return;
+	
+	const int32 Columns = FMath::Max(1, GridColumns);
+	const int32 SlotRows = FMath::DivideAndRoundUp(ActiveSlots.Num(), Columns);
+	const int32 ContentRows = FMath::DivideAndRoundUp(DisplayItems.Num(), Columns);
+	const int32 RowsBelow = FMath::Max(0, ContentRows - FirstVirtualRow - SlotRows);
+	
+	const FMargin Padding(0.0f, FirstVirtualRow * SlotRowHeight, 0.0f, RowsBelow * SlotRowHeight);
+	if (GridSlot -> GetPadding() != Padding)
+	{
+		GridSlot -> SetPadding(Padding);
+	}
+}
+
+void UInventoryGridWidget::HandleUserScrolled(float CurrentOffset)
+{
+	if (!IsVirtualized()) return;
+	
+	// Viewport may have been resized since the slots were created
+	EnsureSlotCount(CalculateVirtualSlotCount());
+	
+	// Scroll offset -> first row is a single division
+	const int32 Columns = FMath::Max(1, GridColumns);
+	const int32 SlotRows = FMath::DivideAndRoundUp(ActiveSlots.Num(), Columns);
+	const int32 ContentRows = FMath::DivideAndRoundUp(DisplayItems.Num(), Columns);
+	const int32 ScrolledRow = FMath::FloorToInt(CurrentOffset / FMath::Max(1.0f, SlotRowHeight));
+	const int32 NewFirstRow = FMath::Clamp(ScrolledRow - OverscanRows, 0, FMath::Max(0, ContentRows - SlotRows));
+	
+	if (NewFirstRow != FirstVirtualRow)
+	{
+		FirstVirtualRow = NewFirstRow;
+		RefreshVisibleSlots();
 	}
 }
 
@@ -135,6 +309,8 @@ void UInventoryGridWidget::ReturnSlotToPool(UInventorySlotWidget* Slot)
 
 void UInventoryGridWidget::ClearAllSlots()
 {
+	CancelPendingRefresh();
+	
 	for (UInventorySlotWidget* Slot : ActiveSlots)
 	{
 		if (Slot)
@@ -145,6 +321,7 @@ void UInventoryGridWidget::ClearAllSlots()
 		}
 	}
 	ActiveSlots.Empty();
+	SlotsByGUID.Empty();
 }
 
 // ----------------------------------------
@@ -153,68 +330,320 @@ void UInventoryGridWidget::ClearAllSlots()
 
 void UInventoryGridWidget::PopulateGrid_Implementation()
 {
-	// Items to display
-	TArray<UInventoryItemData*> Items = GetFilteredItems();
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryGridWidget::PopulateGrid);
+	
+	// Items to display - the cached view is only rebuilt when the filter (or order) changed
+	if (bFilteredViewDirty)
+	{
+		GatherFilteredItems(DisplayItems);
+		SortDisplayItems();
+		bFilteredViewDirty = false;
+	}
 	
-	// Update each slot
-	for (int32 i = 0; i < ActiveSlots.Num(); i++)
+	if (IsSpatial())
 	{
-		UInventorySlotWidget* Slot = ActiveSlots[i];
-		if (!Slot) continue;
+		// One slot per item - empty cells are drawn by the canvas background
+		EnsureSlotCount(DisplayItems.Num());
+		FirstVirtualRow = 0;
+	}
+	else if (IsVirtualized())
+	{
+		EnsureSlotCount(CalculateVirtualSlotCount());
 		
-		if (i < Items.Num())
+		// Keep the first row in range if the list shrank
+		const int32 Columns = FMath::Max(1, GridColumns);
+		const int32 MaxFirstRow = FMath::Max(0, FMath::DivideAndRoundUp(DisplayItems.Num(), Columns) - FMath::DivideAndRoundUp(ActiveSlots.Num(), Columns));
+		FirstVirtualRow = FMath::Clamp(FirstVirtualRow, 0, MaxFirstRow);
+	}
+	else
+	{
+		FirstVirtualRow = 0;
+	}
+	
+	RefreshVisibleSlots();
+}
+
+void UInventoryGridWidget::RefreshVisibleSlots()
+{
+	// A refresh still in progress is based on an outdated list - start over
+	CancelPendingRefresh();
+	
+	// In virtualized mode ActiveSlots[0] shows the first item of FirstVirtualRow
+	RefreshFirstItemIndex = FirstVirtualRow * FMath::Max(1, GridColumns);
+	
+	SlotsByGUID.Reset();
+	SelectedSlot = nullptr;
+	SlotsUpdatedThisRefresh = 0;
+	
+	// Scroll extent only depends on the list length, so it is right from the first frame
+	if (IsVirtualized())
+	{
+		UpdateVirtualPadding();
+	}
+	
+	if (bTimeSlicePopulate)
+	{
+		BuildRefreshOrder(PendingSlotOrder, NumPendingVisibleSlots);
+	}
+	else
+	{
+		PendingSlotOrder.Reset(ActiveSlots.Num());
+		for (int32 i = 0; i < ActiveSlots.Num(); i++)
 		{
-			// Slot has an item
-			Slot -> SetItem(Items[i]);
-			Slot -> SetVisibility(ESlateVisibility::Visible);
+			PendingSlotOrder.Add(i);
 		}
-		else if (bShowEmptySlots)
+		NumPendingVisibleSlots = PendingSlotOrder.Num();
+	}
+	
+	ProcessPendingSlots();
+}
+
+bool UInventoryGridWidget::RefreshSlot(int32 SlotIndex)
+{
+	UInventorySlotWidget* Slot = ActiveSlots.IsValidIndex(SlotIndex) ? ActiveSlots[SlotIndex].Get() : nullptr;
+	if (!Slot) return false;
+	
+	const int32 ItemIndex = RefreshFirstItemIndex + SlotIndex;
+	UInventoryItemData* Item = DisplayItems.IsValidIndex(ItemIndex) ? DisplayItems[ItemIndex] : nullptr;
+	const bool bSelected = Item && Item == SelectedItem;
+	
+	// Diff the slot against what it already shows - only a changed slot is touched
+	const bool bUpdated = Slot -> SetItemIfChanged(Item, bSelected);
+	
+	if (IsSpatial())
+	{
+		LayoutSpatialSlot(Slot, Item);
+	}
+	
+	// Slot has an item, or is an empty slot we still show
+	const ESlateVisibility DesiredVisibility = (Item || bShowEmptySlots)
+		? ESlateVisibility::Visible
+		: ESlateVisibility::Collapsed;
+	if (Slot -> GetVisibility() != DesiredVisibility)
+	{
+		Slot -> SetVisibility(DesiredVisibility);
+	}
+	
+	if (Item)
+	{
+		SlotsByGUID.Add(Item -> GetItemGUID(), Slot);
+	}
+	if (bSelected)
+	{
+		SelectedSlot = Slot;
+	}
+	return bUpdated;
+}
+
+void UInventoryGridWidget::BuildRefreshOrder(TArray<int32>& OutOrder, int32& OutNumVisible) const
+{
+	const int32 NumSlots = ActiveSlots.Num();
+	int32 FirstVisible = 0;
+	int32 EndVisible = NumSlots;
+	
+	// Rows inside the scroll viewport, relative to ActiveSlots[0]
+	const float ViewportHeight = ScrollBox ? ScrollBox -> GetCachedGeometry().GetLocalSize().Y : 0.0f;
+	if (ViewportHeight > 0.0f && !IsSpatial())
+	{
+		const int32 Columns = FMath::Max(1, GridColumns);
+		const float RowHeight = FMath::Max(1.0f, SlotRowHeight);
+		const int32 FirstRow = FMath::FloorToInt(ScrollBox -> GetScrollOffset() / RowHeight) - FirstVirtualRow;
+		const int32 NumRows = FMath::CeilToInt(ViewportHeight / RowHeight) + 1;
+		FirstVisible = FMath::Clamp(FirstRow * Columns, 0, NumSlots);
+		EndVisible = FMath::Clamp((FirstRow + NumRows) * Columns, FirstVisible, NumSlots);
+	}
+	
+	// On-screen slots, then the ones below, then the ones above
+	OutOrder.Reset(NumSlots);
+	for (int32 i = FirstVisible; i < EndVisible; i++)
+	{
+		OutOrder.Add(i);
+	}
+	OutNumVisible = OutOrder.Num();
+	for (int32 i = EndVisible; i < NumSlots; i++)
+	{
+		OutOrder.Add(i);
+	}
+	for (int32 i = 0; i < FirstVisible; i++)
+	{
+		OutOrder.Add(i);
+	}
+}
+
+void UInventoryGridWidget::ProcessPendingSlots()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UInventoryGridWidget::ProcessPendingSlots);
+	
+	const double Deadline = FPlatformTime::Seconds() + PopulateFrameBudgetMicroseconds * 1.0e-6;
+	
+	while (NextPendingSlot < PendingSlotOrder.Num())
+	{
+		// On-screen slots always go out this frame; the rest only while there's budget left
+		if (NextPendingSlot >= NumPendingVisibleSlots && FPlatformTime::Seconds() >= Deadline)
 		{
-			// Empty Slot
-			Slot -> ClearSlot();
-			Slot -> SetVisibility(ESlateVisibility::Visible);
+			return;
 		}
-		else
+		
+		if (RefreshSlot(PendingSlotOrder[NextPendingSlot++]))
 		{
-			// Hide unused slots
-			Slot -> ClearSlot();
-			Slot -> SetVisibility(ESlateVisibility::Collapsed);
+			SlotsUpdatedThisRefresh++;
 		}
 	}
+	
+	// Finished
+	SlotsUpdatedLastRefresh = SlotsUpdatedThisRefresh;
+	TRACE_COUNTER_SET(InventoryGridSlotsUpdated, SlotsUpdatedThisRefresh);
+	CancelPendingRefresh();
+}
+
+void UInventoryGridWidget::CancelPendingRefresh()
+{
+	PendingSlotOrder.Reset();
+	NextPendingSlot = 0;
+	NumPendingVisibleSlots = 0;
+}
+
+void UInventoryGridWidget::LayoutSpatialSlot(UInventorySlotWidget* Slot, const UInventoryItemData* Item) const
+{
+	UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Slot -> Slot);
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!CanvasSlot || !Manager || !Item) return;
+	
+	FIntPoint Cell;
+	FIntPoint Size;
+	if (!Manager -> GetItemGridPlacement(Item -> GetItemGUID(), Cell, Size)) return;
+	
+	const FVector2D Position = FVector2D(Cell) * SpatialCellSize;
+	const FVector2D Extent = FVector2D(Size) * SpatialCellSize;
+	if (CanvasSlot -> GetPosition() != Position)
+	{
+		CanvasSlot -> SetPosition(Position);
+	}
+	if (CanvasSlot -> GetSize() != Extent)
+	{
+		CanvasSlot -> SetSize(Extent);
+	}
 }
 
 TArray<UInventoryItemData*> UInventoryGridWidget::GetFilteredItems() const
 {
+	TArray<UInventoryItemData*> Items;
+	GatherFilteredItems(Items);
+	return Items;
+}
+
+void UInventoryGridWidget::GatherFilteredItems(TArray<UInventoryItemData*>& OutItems) const
+{
+	OutItems.Reset();
+	
 	UInventoryManagerSubsystem* Manager = GetInventoryManager();
-	if (!Manager) return TArray<UInventoryItemData*>();
+	if (!Manager) return;
 	
-	TArray<UInventoryItemData*> Items = Manager -> GetAllItems();
+	// A named container is gathered in slot order
+	if (!SourceContainer.IsNone())
+	{
+		OutItems = Manager -> GetContainerItems(SourceContainer);
+		if (HasActiveFilter())
+		{
+			OutItems.RemoveAll([this](const UInventoryItemData* Item) { return !PassesFilter(Item); });
+		}
+		return;
+	}
 	
-	// Apply category filter
-	if (CategoryFilter.IsSet())
+	// Read straight from the subsystem's storage - no intermediate copy
+	TConstArrayView<UInventoryItemData*> Items = Manager -> GetItems();
+	if (!HasActiveFilter())
 	{
-		Items = Items.FilterByPredicate([this](UInventoryItemData* Item)
+		OutItems.Append(Items);
+		return;
+	}
+	
+	// Apply category and search filters in a single pass
+	for (UInventoryItemData* Item : Items)
+	{
+		if (PassesFilter(Item))
 		{
-			return Item && Item -> GetItemCategory() == CategoryFilter.GetValue();
-		});
+			OutItems.Add(Item);
+		}
+	}
+}
+
+void UInventoryGridWidget::SortDisplayItems()
+{
+	if (!DisplaySorter.HasCriteria()) return;
+	
+	TArray<int32> Order;
+	DisplaySorter.Sort(DisplayItems, Order);
+	
+	TArray<UInventoryItemData*> SortedItems;
+	SortedItems.Reserve(Order.Num());
+	for (const int32 Index : Order)
+	{
+		SortedItems.Add(DisplayItems[Index]);
+	}
+	DisplayItems = MoveTemp(SortedItems);
+}
+
+bool UInventoryGridWidget::PassesFilter(const UInventoryItemData* Item) const
+{
+	if (!Item) return false;
+	
+	if (CategoryFilter.IsSet() && Item -> GetItemCategory() != CategoryFilter.GetValue())
+	{
+		return false;
 	}
 	
-	// Apply search filter
-	if (!SearchFilter.IsEmpty())
+	// Both sides are already lower-cased, so a case-sensitive compare is enough
+	if (!NormalizedSearchFilter.IsEmpty() &&
+		!Item -> GetNormalizedName().Contains(NormalizedSearchFilter, ESearchCase::CaseSensitive))
 	{
-		Items = Items.FilterByPredicate([this](UInventoryItemData* Item)
+		return false;
+	}
+	return true;
+}
+
+void UInventoryGridWidget::ApplyDeltaToFilteredView(const FInventoryChangeDelta& Delta)
+{
+	// Reorders can't be patched - rebuild on the next populate
+	if (bFilteredViewDirty || Delta.bOrderChanged)
+	{
+		bFilteredViewDirty = true;
+		return;
+	}
+	
+	if (Delta.RemovedItems.Num() > 0)
+	{
+		TSet<FGuid> RemovedGUIDs(Delta.RemovedItems);
+		DisplayItems.RemoveAll([&RemovedGUIDs](const UInventoryItemData* Item)
 		{
-			if (!Item) return false;
-			FString ItemName = Item -> GetItemName().ToString().ToLower();
-			return ItemName.Contains(SearchFilter.ToLower());
+			return RemovedGUIDs.Contains(Item -> GetItemGUID());
 		});
 	}
-	return Items;
+	
+	UInventoryManagerSubsystem* Manager = GetInventoryManager();
+	if (!Manager) return;
+	
+	// New items land at the end of the inventory, so appending keeps the view in order
+	// (or, when the view is sorted, they go straight to their sorted position)
+	for (const FGuid& AddedGUID : Delta.AddedItems)
+	{
+		UInventoryItemData* Item = Manager -> FindItemByGUID(AddedGUID);
+		if (PassesFilter(Item))
+		{
+			DisplayItems.Insert(Item, DisplaySorter.FindInsertIndex(DisplayItems, Item));
+		}
+	}
+	
+	// Restacked items keep their place - stack size doesn't affect filtering, only a stack-size sort
+	if (Delta.RestackedItems.Num() > 0 && DisplaySorter.UsesStackSize())
+	{
+		bFilteredViewDirty = true;
+	}
 }
 
 TArray<UInventoryItemData*> UInventoryGridWidget::GetDisplayedItems() const
 {
-	return GetFilteredItems();
+	return DisplayItems;
 }
 
 // ----------------------------------------
@@ -224,12 +653,15 @@ TArray<UInventoryItemData*> UInventoryGridWidget::GetDisplayedItems() const
 void UInventoryGridWidget::SetCategoryFilter(EItemCategory NewCategory)
 {
 	CategoryFilter = NewCategory;
+	bFilteredViewDirty = true;
 	PopulateGrid();
 }
 
 void UInventoryGridWidget::SetSearchFilter(const FString& SearchText)
 {
 	SearchFilter = SearchText;
+	NormalizedSearchFilter = SearchText.ToLower();
+	bFilteredViewDirty = true;
 	PopulateGrid();
 }
 
@@ -237,6 +669,8 @@ void UInventoryGridWidget::ClearAllFilters()
 {
 	CategoryFilter.Reset();
 	SearchFilter.Empty();
+	NormalizedSearchFilter.Empty();
+	bFilteredViewDirty = true;
 	PopulateGrid();
 }
 
@@ -245,6 +679,24 @@ bool UInventoryGridWidget::HasActiveFilter() const
 	return CategoryFilter.IsSet() || !SearchFilter.IsEmpty();
 }
 
+// ----------------------------------------
+// Sorting
+// ----------------------------------------
+
+void UInventoryGridWidget::SetSortCriteria(const TArray<FInventorySortCriterion>& Criteria)
+{
+	DisplaySorter.SetCriteria(Criteria);
+	bFilteredViewDirty = true;
+	PopulateGrid();
+}
+
+void UInventoryGridWidget::ClearSort()
+{
+	DisplaySorter.SetCriteria({});
+	bFilteredViewDirty = true;
+	PopulateGrid();
+}
+
 // ----------------------------------------
 // Selection
 // ----------------------------------------
@@ -338,28 +790,12 @@ UInventorySlotWidget* UInventoryGridWidget::FindSlotForItem(UInventoryItemData*
 {
 	if (!Item) return nullptr;
 	
-	for (UInventorySlotWidget* Slot : ActiveSlots)
-	{
-		if (Slot && Slot -> GetItem() == Item)
-		{
-			return Slot;
-		}
-	}
-	return nullptr;
+	UInventorySlotWidget* Slot = FindSlotForGUID(Item -> GetItemGUID());
+	return (Slot && Slot -> GetItem() == Item) ? Slot : nullptr;
 }
 
 UInventorySlotWidget* UInventoryGridWidget::FindSlotForGUID(const FGuid& ItemGUID) const
 {
-	for (UInventorySlotWidget* Slot : ActiveSlots)
-	{
-		if (Slot && Slot->HasItem())
-		{
-			if (Slot->GetItem()->GetItemGUID() == ItemGUID)
-			{
-				return Slot;
-			}
-		}
-	}
-	
-	return nullptr;
+	UInventorySlotWidget* const* FoundSlot = SlotsByGUID.Find(ItemGUID);
+	return FoundSlot ? *FoundSlot : nullptr;
 }
@@ -7,12 +7,14 @@
 #include "CoreMinimal.h"
 #include "UI/InventoryWidgetBase.h"
 #include "Core/InventoryItemData.h"
+#include "Core/InventorySort.h"
 #include "InventoryGridWidget.generated.h"
 
 // Forward declarations
 class UInventorySlotWidget;
 class UUniformGridPanel;
 class UScrollBox;
+class UCanvasPanel;
 
 // Delegate for item selection
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemSelected, UInventoryItemData*, SelectedItem);
@@ -32,6 +34,7 @@ public:
 	//~ Begin UUserWidget Interface
 	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	//~ End UUserWidget Interface
 
 	//~ Begin UInventoryWidgetBase Interface
@@ -40,6 +43,7 @@ public:
 	virtual void OnItemAdded_Implementation(UInventoryItemData* AddedItem) override;
 	virtual void OnItemRemoved_Implementation(FGuid ItemGUID) override;
 	virtual void OnItemStackChanged_Implementation(FGuid ItemGUID, int32 NewStackSize) override;
+	virtual void OnInventoryBatchChanged_Implementation(const FInventoryChangeDelta& Delta) override;
 	//~ End UInventoryWidgetBase Interface
 
 	// ----------------------------------------
@@ -62,6 +66,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory Grid|Filtering")
 	bool HasActiveFilter() const;
 
+	// ----------------------------------------
+	// Sorting
+	// ----------------------------------------
+
+	/** Sort the displayed items (view only - the inventory order is left alone) */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid|Sorting")
+	void SetSortCriteria(const TArray<FInventorySortCriterion>& Criteria);
+
+	/** Show items in inventory order again */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid|Sorting")
+	void ClearSort();
+
+	/** Check if the displayed items are sorted */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid|Sorting")
+	bool HasActiveSort() const { return DisplaySorter.HasCriteria(); }
+
 	// ----------------------------------------
 	// Selection
 	// ----------------------------------------
@@ -98,6 +118,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory Grid")
 	UInventorySlotWidget* GetSlotAtIndex(int32 Index) const;
 
+	/** Number of slots whose visuals were actually touched by the last PopulateGrid (for profiling) */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid|Profiling")
+	int32 GetSlotsUpdatedLastRefresh() const { return SlotsUpdatedLastRefresh; }
+
+	/** Is a time-sliced refresh still filling slots over the coming frames */
+	UFUNCTION(BlueprintCallable, Category = "Inventory Grid")
+	bool IsRefreshPending() const { return NextPendingSlot < PendingSlotOrder.Num(); }
+
 protected:
 	// ----------------------------------------
 	// Configuration
@@ -115,6 +143,41 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config")
 	bool bShowEmptySlots = true;
 
+	/**
+	 * Only create slots for the rows visible in ScrollBox (plus overscan) and recycle
+	 * them while scrolling, so widget count depends on viewport size, not inventory size
+	 * When enabled, TotalSlots is only the fallback slot count before the viewport has been measured
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Virtualization")
+	bool bVirtualizeSlots = false;
+
+	/** Height of one grid row in slate units, including padding (used to map scroll offset to rows) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Virtualization", meta = (ClampMin = "1.0", EditCondition = "bVirtualizeSlots"))
+	float SlotRowHeight = 92.0f;
+
+	/** Extra rows kept alive above and below the viewport */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Virtualization", meta = (ClampMin = "0", EditCondition = "bVirtualizeSlots"))
+	int32 OverscanRows = 2;
+
+	/** Container to display (None = the default inventory) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config")
+	FName SourceContainer;
+
+	/** Size of one cell in slate units when showing a grid container on SpatialCanvas */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config", meta = (ClampMin = "1.0"))
+	float SpatialCellSize = 64.0f;
+
+	/**
+	 * Spread slot updates over several frames: slots in the viewport are filled at once,
+	 * the rest within PopulateFrameBudgetMicroseconds per frame. A new refresh cancels one in progress.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Time Slicing")
+	bool bTimeSlicePopulate = false;
+
+	/** Time per frame spent on off-screen slot updates in time-sliced mode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Time Slicing", meta = (ClampMin = "50.0", EditCondition = "bTimeSlicePopulate"))
+	float PopulateFrameBudgetMicroseconds = 1000.0f;
+
 	/** Slot widget class to spawn */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory Grid|Config")
 	TSubclassOf<UInventorySlotWidget> SlotWidgetClass;
@@ -131,6 +194,10 @@ protected:
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget, OptionalWidget = true), Category = "Inventory Grid|Widgets")
 	TObjectPtr<UScrollBox> ScrollBox;
 
+	/** Optional canvas for grid containers - each item's slot is placed over the cells it covers */
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidget, OptionalWidget = true), Category = "Inventory Grid|Widgets")
+	TObjectPtr<UCanvasPanel> SpatialCanvas;
+
 	// ----------------------------------------
 	// Grid Management
 	// ----------------------------------------
@@ -145,10 +212,41 @@ protected:
 	void PopulateGrid();
 	virtual void PopulateGrid_Implementation();
 
-	/** Get filtered list of items to display */
+	/** Push the cached display list into the active slots, diffing against what each shows (restarts any time-sliced refresh) */
+	void RefreshVisibleSlots();
+
+	/**
+	 * Bring one slot in line with the display list
+	 * @param SlotIndex - Index into ActiveSlots
+	 * @return True if its visuals were touched
+	 */
+	bool RefreshSlot(int32 SlotIndex);
+
+	/** Slot indices in refresh order - on-screen slots first; OutNumVisible receives how many lead the list */
+	void BuildRefreshOrder(TArray<int32>& OutOrder, int32& OutNumVisible) const;
+
+	/** Work through the pending slots (all on-screen ones, then the rest until the frame budget runs out) */
+	void ProcessPendingSlots();
+
+	/** Drop a time-sliced refresh in progress */
+	void CancelPendingRefresh();
+
+	/** Get filtered list of items to display (full recompute - the grid itself uses the cached view) */
 	UFUNCTION(BlueprintCallable, Category = "Inventory Grid")
 	TArray<UInventoryItemData*> GetFilteredItems() const;
 
+	/** Reset and fill an array with the items passing the filters (reuses its allocation) */
+	void GatherFilteredItems(TArray<UInventoryItemData*>& OutItems) const;
+
+	/** Does an item pass the active category and search filters */
+	bool PassesFilter(const UInventoryItemData* Item) const;
+
+	/** Reorder DisplayItems by the active sort */
+	void SortDisplayItems();
+
+	/** Patch the cached filtered view with a batch delta instead of recomputing it */
+	void ApplyDeltaToFilteredView(const FInventoryChangeDelta& Delta);
+
 	/** Handle slot click event */
 	UFUNCTION()
 	void HandleSlotClicked(UInventorySlotWidget* ClickedSlot);
@@ -157,6 +255,18 @@ protected:
 	UFUNCTION()
 	void HandleSlotHovered(UInventorySlotWidget* HoveredSlot);
 
+	/** Repopulate when the displayed container changes */
+	UFUNCTION()
+	void HandleContainerItemAdded(FName ContainerName, UInventoryItemData* Item, int32 SlotIndex);
+
+	/** Repopulate when the displayed container changes */
+	UFUNCTION()
+	void HandleContainerItemRemoved(FName ContainerName, FGuid ItemGUID, int32 SlotIndex);
+
+	/** Handle scroll box scrolling (virtualized mode) */
+	UFUNCTION()
+	void HandleUserScrolled(float CurrentOffset);
+
 	// ----------------------------------------
 	// Slot Pooling
 	// ----------------------------------------
@@ -170,6 +280,31 @@ protected:
 	/** Clear all slots back to pool */
 	void ClearAllSlots();
 
+	/** Take a slot from the pool, bind it and add it to the grid at the next index */
+	UInventorySlotWidget* AddSlotToGrid();
+
+	// ----------------------------------------
+	// Virtualization
+	// ----------------------------------------
+
+	/** Is the grid running in virtualized mode */
+	bool IsVirtualized() const { return bVirtualizeSlots && ScrollBox && SlotGrid && !IsSpatial(); }
+
+	/** Is the grid showing a grid container on SpatialCanvas (one slot per item, sized to its footprint) */
+	bool IsSpatial() const { return SpatialCanvas && !SourceContainer.IsNone(); }
+
+	/** Place and size a slot over the cells its item covers (spatial mode) */
+	void LayoutSpatialSlot(UInventorySlotWidget* Slot, const UInventoryItemData* Item) const;
+
+	/** Slots needed to cover the viewport plus overscan */
+	int32 CalculateVirtualSlotCount() const;
+
+	/** Grow or shrink the active slot set to the given count, recycling through the pool */
+	void EnsureSlotCount(int32 DesiredCount);
+
+	/** Pad the grid inside the scroll box so the scrollbar spans the whole inventory */
+	void UpdateVirtualPadding();
+
 private:
 	/** Currently active slots in the grid */
 	UPROPERTY()
@@ -187,12 +322,49 @@ private:
 	UPROPERTY()
 	TObjectPtr<UInventorySlotWidget> SelectedSlot;
 
+	/** GUID -> slot currently displaying that item, rebuilt on each populate */
+	TMap<FGuid, UInventorySlotWidget*> SlotsByGUID;
+
+	/** Cached filtered view - the items the grid is currently displaying */
+	UPROPERTY()
+	TArray<UInventoryItemData*> DisplayItems;
+
+	/** Sorts DisplayItems when sort criteria are set (keeps its name collation cache) */
+	FInventorySorter DisplaySorter;
+
+	/** DisplayItems must be rebuilt from scratch (filter changed or order changed) */
+	bool bFilteredViewDirty = true;
+
+	/** First row of DisplayItems shown by ActiveSlots[0] (virtualized mode) */
+	int32 FirstVirtualRow = 0;
+
+	/** Slots touched by the last PopulateGrid */
+	int32 SlotsUpdatedLastRefresh = 0;
+
+	/** Slots the current refresh still has to visit, in order (time-sliced mode) */
+	TArray<int32> PendingSlotOrder;
+
+	/** Next entry of PendingSlotOrder to visit */
+	int32 NextPendingSlot = 0;
+
+	/** Leading entries of PendingSlotOrder that are on screen and can't wait for a later frame */
+	int32 NumPendingVisibleSlots = 0;
+
+	/** Index into DisplayItems shown by ActiveSlots[0] for the current refresh */
+	int32 RefreshFirstItemIndex = 0;
+
+	/** Slots touched so far by the current refresh */
+	int32 SlotsUpdatedThisRefresh = 0;
+
 	/** Active category filter (None = no filter) */
 	TOptional<EItemCategory> CategoryFilter;
 
 	/** Active search filter */
 	FString SearchFilter;
 
+	/** Lower-cased SearchFilter, compared against each item's cached normalized name */
+	FString NormalizedSearchFilter;
+
 	/** Find slot displaying a specific item */
 	UInventorySlotWidget* FindSlotForItem(UInventoryItemData* Item) const;
 
@@ -7,6 +7,8 @@
 #include "Components/TextBlock.h"
 #include "Components/Border.h"
 #include "UI/InventoryStyleData.h"
+#include "Core/InventoryIconCache.h"
+#include "Core/InventoryManagerSubsystem.h"
 
 UInventorySlotWidget::UInventorySlotWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -18,7 +20,13 @@ UInventorySlotWidget::UInventorySlotWidget(const FObjectInitializer& ObjectIniti
 void UInventorySlotWidget::NativeConstruct()
 {
     Super::NativeConstruct();
-    UpdateVisuals();
+    ApplyVisuals();
+}
+
+void UInventorySlotWidget::NativeDestruct()
+{
+    ReleaseIcon();
+    Super::NativeDestruct();
 }
 
 void UInventorySlotWidget::NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
@@ -49,20 +57,49 @@ FReply UInventorySlotWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry
 
 void UInventorySlotWidget::RefreshWidget_Implementation()
 {
-    UpdateVisuals();
+    ApplyVisuals();
 }
 
 void UInventorySlotWidget::SetItem(UInventoryItemData* NewItem)
 {
     CurrentItem = NewItem;
-    UpdateVisuals();
+    ApplyVisuals();
+}
+
+bool UInventorySlotWidget::SetItemIfChanged(UInventoryItemData* NewItem, bool bShouldBeSelected)
+{
+    const bool bSelectionChanged = bIsSelected != bShouldBeSelected;
+
+    if (NewItem == CurrentItem)
+    {
+        // Same item - only touch the visuals if something it displays changed
+        if (GatherDisplayData() == LastDisplayData)
+        {
+            if (bSelectionChanged)
+            {
+                SetSelected(bShouldBeSelected);
+            }
+            return bSelectionChanged;
+        }
+    }
+
+    CurrentItem = NewItem;
+    bIsSelected = bShouldBeSelected;
+    ApplyVisuals();
+    return true;
 }
 
 void UInventorySlotWidget::ClearSlot()
 {
     CurrentItem = nullptr;
     bIsSelected = false;
+    ApplyVisuals();
+}
+
+void UInventorySlotWidget::ApplyVisuals()
+{
     UpdateVisuals();
+    LastDisplayData = GatherDisplayData();
 }
 
 void UInventorySlotWidget::SetSelected(bool bNewSelected)
@@ -113,16 +150,21 @@ void UInventorySlotWidget::UpdateIcon_Implementation()
 {
     if (!ItemIcon) return;
 
-    if (CurrentItem && CurrentItem->GetItemIcon())
+    UTexture2D* IconTexture = PinIcon(CurrentItem ? CurrentItem->GetItemIconAsset() : TSoftObjectPtr<UTexture2D>());
+
+    if (IconTexture)
     {
-        ItemIcon->SetBrushFromTexture(CurrentItem->GetItemIcon());
+        ItemIcon->SetBrushFromTexture(IconTexture);
         ItemIcon->SetVisibility(ESlateVisibility::HitTestInvisible);
         ItemIcon->SetColorAndOpacity(FLinearColor::White);
     }
     else if (CurrentItem)
     {
+        // Icon not loaded yet (or the item has none) - HandleIconLoaded swaps it in
+        const FInventorySlotStyle& Style = GetSlotStyle();
+        ItemIcon->SetBrushFromTexture(Style.PlaceholderIcon);
         ItemIcon->SetVisibility(ESlateVisibility::HitTestInvisible);
-        ItemIcon->SetColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 0.5f));
+        ItemIcon->SetColorAndOpacity(Style.PlaceholderTint);
     }
     else
     {
@@ -130,6 +172,53 @@ void UInventorySlotWidget::UpdateIcon_Implementation()
     }
 }
 
+UTexture2D* UInventorySlotWidget::PinIcon(const TSoftObjectPtr<UTexture2D>& NewIcon)
+{
+    TSharedPtr<FInventoryIconCache> Cache = IconCache.Pin();
+    if (!Cache && GetInventoryManager())
+    {
+        Cache = GetInventoryManager()->GetIconCache();
+        if (Cache)
+        {
+            IconCache = Cache;
+            IconLoadedHandle = Cache->OnIconLoaded.AddUObject(this, &UInventorySlotWidget::HandleIconLoaded);
+        }
+    }
+
+    // Without the cache (not constructed yet) only icons something else loaded can show
+    if (!Cache || NewIcon == PinnedIcon)
+    {
+        return NewIcon.Get();
+    }
+
+    // Pin before unpinning so an icon shared by both items isn't dropped in between
+    UTexture2D* IconTexture = Cache->Acquire(NewIcon);
+    Cache->Release(PinnedIcon);
+    PinnedIcon = NewIcon;
+    return IconTexture;
+}
+
+void UInventorySlotWidget::ReleaseIcon()
+{
+    if (TSharedPtr<FInventoryIconCache> Cache = IconCache.Pin())
+    {
+        Cache->Release(PinnedIcon);
+        Cache->OnIconLoaded.Remove(IconLoadedHandle);
+    }
+    PinnedIcon.Reset();
+    IconCache.Reset();
+    IconLoadedHandle.Reset();
+}
+
+void UInventorySlotWidget::HandleIconLoaded(const FSoftObjectPath& IconPath)
+{
+    if (CurrentItem && IconPath == PinnedIcon.ToSoftObjectPath())
+    {
+        UpdateIcon();
+        LastDisplayData.Icon = CurrentItem->GetItemIcon();
+    }
+}
+
 void UInventorySlotWidget::UpdateStackCount_Implementation()
 {
     if (!StackCountText) return;
@@ -15,6 +15,7 @@ class UImage;
 class UTextBlock;
 class UBorder;
 class UInventoryStyleData;
+class FInventoryIconCache;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSlotClicked, UInventorySlotWidget * , Slot);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSlotHovered, UInventorySlotWidget * , Slot);
@@ -28,6 +29,7 @@ class ADAPTIVEINVENTORY_API UInventorySlotWidget: public UInventoryWidgetBase {
         UInventorySlotWidget(const FObjectInitializer & ObjectInitializer);
 
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
     virtual void NativeOnMouseEnter(const FGeometry & InGeometry,
         const FPointerEvent & InMouseEvent) override;
     virtual void NativeOnMouseLeave(const FPointerEvent & InMouseEvent) override;
@@ -39,6 +41,14 @@ class ADAPTIVEINVENTORY_API UInventorySlotWidget: public UInventoryWidgetBase {
     UFUNCTION(BlueprintCallable, Category = "Inventory Slot")
     void SetItem(UInventoryItemData * NewItem);
 
+    /**
+     * Show an item, skipping all visual updates if the slot already shows it
+     * with the same stack count, rarity and selection
+     * @return True if the slot's visuals were updated
+     */
+    UFUNCTION(BlueprintCallable, Category = "Inventory Slot")
+    bool SetItemIfChanged(UInventoryItemData * NewItem, bool bShouldBeSelected);
+
     UFUNCTION(BlueprintCallable, Category = "Inventory Slot")
     UInventoryItemData * GetItem() const {
         return CurrentItem;
@@ -143,8 +153,36 @@ class ADAPTIVEINVENTORY_API UInventorySlotWidget: public UInventoryWidgetBase {
         int32 MaxStack = 1;
         EItemRarity Rarity = EItemRarity::Common;
         UTexture2D * Icon = nullptr;
+
+        bool operator == (const FSlotDisplayData & Other) const {
+            return bHasItem == Other.bHasItem && StackCount == Other.StackCount &&
+                MaxStack == Other.MaxStack && Rarity == Other.Rarity && Icon == Other.Icon;
+        }
     };
 
+    /** What the visuals were last built from - used to skip redundant updates */
+    FSlotDisplayData LastDisplayData;
+
+    /** Icon this slot holds pinned in the icon cache */
+    TSoftObjectPtr < UTexture2D > PinnedIcon;
+
+    TWeakPtr < FInventoryIconCache > IconCache;
+    FDelegateHandle IconLoadedHandle;
+
+    /**
+     * Pin a new icon (unpinning the previous one), starting its async load
+     * @return The icon texture if it is already loaded
+     */
+    UTexture2D * PinIcon(const TSoftObjectPtr < UTexture2D > & NewIcon);
+
+    /** Unpin the icon and stop listening for loads */
+    void ReleaseIcon();
+
+    void HandleIconLoaded(const FSoftObjectPath & IconPath);
+
+    /** Run UpdateVisuals and remember what it was built from */
+    void ApplyVisuals();
+
     FSlotDisplayData GatherDisplayData() const;
     FLinearColor CalculateBorderColor(const FSlotDisplayData & Data) const;
 };
\ No newline at end of file
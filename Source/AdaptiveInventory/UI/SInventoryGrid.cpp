@@ -0,0 +1,532 @@
+// SInventoryGrid.cpp
+// Native Slate grid that paints inventory slots directly
+
+#include "UI/SInventoryGrid.h"
+#include "Core/InventoryItemData.h"
+#include "Core/InventoryIconCache.h"
+#include "Engine/Texture2D.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+void SInventoryGrid::Construct(const FArguments& InArgs)
+{
+	Columns = FMath::Max(1, InArgs._Columns);
+	MinimumSlots = FMath::Max(0, InArgs._MinimumSlots);
+	Style = InArgs._SlotStyle;
+	OnSlotClicked = InArgs._OnSlotClicked;
+	OnSlotHovered = InArgs._OnSlotHovered;
+
+	StackCountFont = FCoreStyle::GetDefaultFontStyle("Bold", 10);
+	UpdateBrushes();
+	SetIconCache(InArgs._IconCache);
+}
+
+SInventoryGrid::~SInventoryGrid()
+{
+	// The cache can outlive the grid - hand the pins back
+	TArray<TSoftObjectPtr<UTexture2D>> ReleasedPins;
+	TakeIconPins(ReleasedPins);
+	ReleaseIconPins(ReleasedPins);
+	if (TSharedPtr<FInventoryIconCache> Cache = IconCache.Pin())
+	{
+		Cache -> OnIconLoaded.Remove(IconLoadedHandle);
+	}
+}
+
+// ----------------------------------------
+// Content
+// ----------------------------------------
+
+void SInventoryGrid::SetItems(TConstArrayView<UInventoryItemData*> Items)
+{
+	const int32 OldNumSlots = GetNumSlots();
+
+	// Re-pin the painted slots before the old pins go back, so icons that stay on screen never unload
+	TArray<TSoftObjectPtr<UTexture2D>> ReleasedPins;
+	TakeIconPins(ReleasedPins);
+
+	Slots.SetNum(Items.Num());
+	for (int32 i = 0; i < Items.Num(); i++)
+	{
+		FillSlot(Slots[i], Items[i], ReleasedPins);
+	}
+
+	UpdateIconPins();
+	ReleaseIconPins(ReleasedPins);
+
+	if (!Slots.IsValidIndex(SelectedIndex))
+	{
+		SelectedIndex = INDEX_NONE;
+	}
+
+	// Only a change in row count affects desired size
+	Invalidate(GetNumSlots() != OldNumSlots ? EInvalidateWidgetReason::Layout : EInvalidateWidgetReason::Paint);
+}
+
+void SInventoryGrid::RefreshSlot(int32 SlotIndex, const UInventoryItemData* Item)
+{
+	if (!Slots.IsValidIndex(SlotIndex)) return;
+
+	TArray<TSoftObjectPtr<UTexture2D>> ReleasedPins;
+	FillSlot(Slots[SlotIndex], Item, ReleasedPins);
+	UpdateIconPins();
+	ReleaseIconPins(ReleasedPins);
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SInventoryGrid::UpdateSlots(TConstArrayView<UInventoryItemData*> Items, TConstArrayView<int32> ChangedSlots)
+{
+	const int32 OldNumSlots = GetNumSlots();
+
+	// Slots cut off the end give their pins back along with those FillSlot replaces
+	TArray<TSoftObjectPtr<UTexture2D>> ReleasedPins;
+	for (int32 i = Items.Num(); i < Slots.Num(); i++)
+	{
+		if (Slots[i].bIconPinned)
+		{
+			ReleasedPins.Add(Slots[i].Icon);
+		}
+	}
+
+	Slots.SetNum(Items.Num(), EAllowShrinking::No);
+	for (const int32 SlotIndex : ChangedSlots)
+	{
+		if (Slots.IsValidIndex(SlotIndex))
+		{
+			FillSlot(Slots[SlotIndex], Items[SlotIndex], ReleasedPins);
+		}
+	}
+
+	UpdateIconPins();
+	ReleaseIconPins(ReleasedPins);
+
+	if (!Slots.IsValidIndex(SelectedIndex))
+	{
+		SelectedIndex = INDEX_NONE;
+	}
+
+	Invalidate(GetNumSlots() != OldNumSlots ? EInvalidateWidgetReason::Layout : EInvalidateWidgetReason::Paint);
+}
+
+void SInventoryGrid::FillSlot(FSlotDrawData& Slot, const UInventoryItemData* Item, TArray<TSoftObjectPtr<UTexture2D>>& OutReleasedPins) const
+{
+	const TSoftObjectPtr<UTexture2D> Icon = Item ? Item->GetItemIconAsset() : TSoftObjectPtr<UTexture2D>();
+	if (Slot.Icon != Icon)
+	{
+		if (Slot.bIconPinned)
+		{
+			OutReleasedPins.Add(Slot.Icon);
+			Slot.bIconPinned = false;
+		}
+		Slot.Icon = Icon;
+
+		// With a cache the brush waits for UpdateIconPins; without one only already-loaded icons show
+		Slot.IconBrush.SetResourceObject(IconCache.IsValid() ? nullptr : Icon.Get());
+	}
+	Slot.IconBrush.ImageSize = FVector2D(Style.SlotSize, Style.SlotSize);
+
+	Slot.bHasItem = Item != nullptr;
+	if (!Item)
+	{
+		Slot.bShowStackCount = false;
+		return;
+	}
+
+	Slot.Rarity = Item->GetItemRarity();
+
+	const int32 StackSize = Item->GetCurrentStackSize();
+	const int32 MaxStack = Item->GetMaxStackSize();
+	Slot.bShowStackCount = MaxStack > 1;
+	Slot.bFullStack = StackSize >= MaxStack;
+	if (Slot.bShowStackCount)
+	{
+		Slot.StackCountText = FText::AsNumber(StackSize);
+		Slot.StackCountSize = FSlateApplication::IsInitialized()
+			? FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->Measure(Slot.StackCountText, StackCountFont)
+			: FVector2D::ZeroVector;
+	}
+}
+
+void SInventoryGrid::SetSelectedIndex(int32 SlotIndex)
+{
+	const int32 NewIndex = Slots.IsValidIndex(SlotIndex) ? SlotIndex : INDEX_NONE;
+	if (NewIndex != SelectedIndex)
+	{
+		SelectedIndex = NewIndex;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+void SInventoryGrid::SetColumns(int32 InColumns)
+{
+	InColumns = FMath::Max(1, InColumns);
+	if (InColumns != Columns)
+	{
+		Columns = InColumns;
+		Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+void SInventoryGrid::SetMinimumSlots(int32 InMinimumSlots)
+{
+	InMinimumSlots = FMath::Max(0, InMinimumSlots);
+	if (InMinimumSlots != MinimumSlots)
+	{
+		MinimumSlots = InMinimumSlots;
+		Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+void SInventoryGrid::SetSlotStyle(const FInventorySlotStyle& InStyle)
+{
+	Style = InStyle;
+	UpdateBrushes();
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SInventoryGrid::UpdateBrushes()
+{
+	BackgroundBrush = FSlateRoundedBoxBrush(FLinearColor::White, Style.CornerRadius);
+	SelectionBrush = FSlateRoundedBoxBrush(FLinearColor::Transparent, Style.CornerRadius, FLinearColor::White, Style.BorderWidth);
+	PlaceholderBrush.SetResourceObject(Style.PlaceholderIcon);
+	PlaceholderBrush.ImageSize = FVector2D(Style.SlotSize, Style.SlotSize);
+}
+
+// ----------------------------------------
+// Icon Streaming
+// ----------------------------------------
+
+void SInventoryGrid::SetIconCache(const TSharedPtr<FInventoryIconCache>& InIconCache)
+{
+	TSharedPtr<FInventoryIconCache> OldCache = IconCache.Pin();
+	if (InIconCache == OldCache) return;
+
+	// Pins belong to the old cache
+	TArray<TSoftObjectPtr<UTexture2D>> ReleasedPins;
+	TakeIconPins(ReleasedPins);
+	ReleaseIconPins(ReleasedPins);
+	if (OldCache)
+	{
+		OldCache -> OnIconLoaded.Remove(IconLoadedHandle);
+	}
+	IconLoadedHandle.Reset();
+
+	IconCache = InIconCache;
+	if (InIconCache)
+	{
+		IconLoadedHandle = InIconCache -> OnIconLoaded.AddSP(this, &SInventoryGrid::HandleIconLoaded);
+	}
+
+	// Painted slots pin through the new cache on the next tick
+	for (FSlotDrawData& Slot : Slots)
+	{
+		Slot.IconBrush.SetResourceObject(InIconCache ? nullptr : Slot.Icon.Get());
+	}
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SInventoryGrid::UpdateIconPins()
+{
+	TSharedPtr<FInventoryIconCache> Cache = IconCache.Pin();
+	if (!Cache) return;
+
+	const int32 FirstSlot = PaintedFirstSlot;
+	const int32 LastSlot = FMath::Min(PaintedLastSlot, Slots.Num() - 1);
+
+	// Pin what's on screen first, so an icon that only moved to another slot stays loaded
+	bool bIconsChanged = false;
+	for (int32 i = FirstSlot; i <= LastSlot; i++)
+	{
+		FSlotDrawData& Slot = Slots[i];
+		if (!Slot.bIconPinned && !Slot.Icon.IsNull())
+		{
+			Slot.bIconPinned = true;
+			Slot.IconBrush.SetResourceObject(Cache -> Acquire(Slot.Icon));
+			bIconsChanged |= Slot.IconBrush.GetResourceObject() != nullptr;
+		}
+	}
+
+	// Slots that scrolled away - their icons stay resident until the cache needs the room
+	const int32 OldLastSlot = FMath::Min(PinnedLastSlot, Slots.Num() - 1);
+	for (int32 i = PinnedFirstSlot; i <= OldLastSlot; i++)
+	{
+		FSlotDrawData& Slot = Slots[i];
+		if (Slot.bIconPinned && (i < FirstSlot || i > LastSlot))
+		{
+			Cache -> Release(Slot.Icon);
+			Slot.bIconPinned = false;
+			Slot.IconBrush.SetResourceObject(nullptr);
+		}
+	}
+
+	PinnedFirstSlot = FirstSlot;
+	PinnedLastSlot = LastSlot;
+
+	if (bIconsChanged)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+void SInventoryGrid::TakeIconPins(TArray<TSoftObjectPtr<UTexture2D>>& OutReleasedPins)
+{
+	const int32 LastSlot = FMath::Min(PinnedLastSlot, Slots.Num() - 1);
+	for (int32 i = PinnedFirstSlot; i <= LastSlot; i++)
+	{
+		FSlotDrawData& Slot = Slots[i];
+		if (Slot.bIconPinned)
+		{
+			OutReleasedPins.Add(Slot.Icon);
+			Slot.bIconPinned = false;
+			Slot.IconBrush.SetResourceObject(nullptr);
+		}
+	}
+
+	PinnedFirstSlot = 0;
+	PinnedLastSlot = INDEX_NONE;
+}
+
+void SInventoryGrid::ReleaseIconPins(TConstArrayView<TSoftObjectPtr<UTexture2D>> Pins) const
+{
+	if (TSharedPtr<FInventoryIconCache> Cache = IconCache.Pin())
+	{
+		for (const TSoftObjectPtr<UTexture2D>& Icon : Pins)
+		{
+			Cache -> Release(Icon);
+		}
+	}
+}
+
+void SInventoryGrid::HandleIconLoaded(const FSoftObjectPath& IconPath)
+{
+	bool bIconsChanged = false;
+	const int32 LastSlot = FMath::Min(PinnedLastSlot, Slots.Num() - 1);
+	for (int32 i = PinnedFirstSlot; i <= LastSlot; i++)
+	{
+		FSlotDrawData& Slot = Slots[i];
+		if (Slot.bIconPinned && Slot.Icon.ToSoftObjectPath() == IconPath)
+		{
+			Slot.IconBrush.SetResourceObject(Slot.Icon.Get());
+			bIconsChanged = true;
+		}
+	}
+
+	if (bIconsChanged)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+// ----------------------------------------
+// Layout & Paint
+// ----------------------------------------
+
+void SInventoryGrid::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SLeafWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Pins follow the last paint, so newly scrolled-in rows start streaming one frame later
+	if ((PaintedFirstSlot != PinnedFirstSlot || PaintedLastSlot != PinnedLastSlot) && IconCache.IsValid())
+	{
+		UpdateIconPins();
+	}
+}
+
+FVector2D SInventoryGrid::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	const int32 NumRows = FMath::DivideAndRoundUp(GetNumSlots(), Columns);
+	const float Pitch = GetSlotPitch();
+
+	// No trailing padding after the last column/row
+	return FVector2D(
+		FMath::Max(0.0f, Columns * Pitch - Style.SlotPadding),
+		FMath::Max(0.0f, NumRows * Pitch - Style.SlotPadding));
+}
+
+int32 SInventoryGrid::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SInventoryGrid::OnPaint);
+
+	const int32 NumSlots = GetNumSlots();
+	if (NumSlots == 0)
+	{
+		PaintedFirstSlot = 0;
+		PaintedLastSlot = INDEX_NONE;
+		return LayerId;
+	}
+
+	const float Pitch = GetSlotPitch();
+	const float Size = Style.SlotSize;
+	const ESlateDrawEffect DrawEffect = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+
+	// Only rows inside the culling rect (e.g. a scroll box viewport) are painted
+	const FVector2D CullTop = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft());
+	const FVector2D CullBottom = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight());
+	const int32 NumRows = FMath::DivideAndRoundUp(NumSlots, Columns);
+	const int32 FirstRow = FMath::Clamp(FMath::FloorToInt(CullTop.Y / Pitch), 0, NumRows - 1);
+	const int32 LastRow = FMath::Clamp(FMath::FloorToInt(CullBottom.Y / Pitch), FirstRow, NumRows - 1);
+	PaintedFirstSlot = FirstRow * Columns;
+	PaintedLastSlot = FMath::Min((LastRow + 1) * Columns, Slots.Num()) - 1;
+
+	const int32 BackgroundLayer = LayerId;
+	const int32 ContentLayer = LayerId + 1;
+	const int32 TextLayer = LayerId + 2;
+	const int32 SelectionLayer = LayerId + 3;
+
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+	const float IconSize = Size * 0.7f;
+	const float IconInset = (Size - IconSize) * 0.5f;
+	const float BarInset = FMath::Min(Style.CornerRadius, Size * 0.5f);
+
+	for (int32 Row = FirstRow; Row <= LastRow; Row++)
+	{
+		for (int32 Column = 0; Column < Columns; Column++)
+		{
+			const int32 SlotIndex = Row * Columns + Column;
+			if (SlotIndex >= NumSlots)
+			{
+				break;
+			}
+
+			const FSlotDrawData* Slot = Slots.IsValidIndex(SlotIndex) ? &Slots[SlotIndex] : nullptr;
+			const bool bHasItem = Slot && Slot->bHasItem;
+			const bool bSelected = SlotIndex == SelectedIndex;
+			const bool bHovered = SlotIndex == HoveredIndex;
+			const FVector2D SlotPosition(Column * Pitch, Row * Pitch);
+
+			// Background - same color rules as UInventorySlotWidget
+			FLinearColor BackgroundColor = Style.EmptyBorder;
+			if (bSelected)
+			{
+				BackgroundColor = Style.SelectedBorder * 0.3f;
+			}
+			else if (bHasItem)
+			{
+				const FLinearColor RarityColor = Style.GetRarityColors(Slot->Rarity).Primary;
+				BackgroundColor = RarityColor * (bHovered ? 0.4f : 0.15f);
+				BackgroundColor.A = bHovered ? 0.8f : 0.6f;
+			}
+			FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer,
+				AllottedGeometry.ToPaintGeometry(FVector2D(Size, Size), FSlateLayoutTransform(SlotPosition)),
+				&BackgroundBrush, DrawEffect, BackgroundColor * Tint);
+
+			if (!bHasItem)
+			{
+				continue;
+			}
+
+			// Icon, or the placeholder while it streams in (a dimmed box when the style has none)
+			const FSlateBrush* IconBrush = &Slot->IconBrush;
+			FLinearColor IconColor = FLinearColor::White;
+			if (!Slot->IconBrush.GetResourceObject())
+			{
+				IconBrush = PlaceholderBrush.GetResourceObject() ? &PlaceholderBrush : static_cast<const FSlateBrush*>(&SolidBrush);
+				IconColor = Style.PlaceholderTint;
+			}
+			FSlateDrawElement::MakeBox(OutDrawElements, ContentLayer,
+				AllottedGeometry.ToPaintGeometry(FVector2D(IconSize, IconSize), FSlateLayoutTransform(SlotPosition + FVector2D(IconInset, IconInset))),
+				IconBrush, DrawEffect, IconColor * Tint);
+
+			// Rarity bar along the bottom edge
+			const float BarHeight = Style.RarityBarHeight;
+			FSlateDrawElement::MakeBox(OutDrawElements, ContentLayer,
+				AllottedGeometry.ToPaintGeometry(FVector2D(Size - BarInset * 2.0f, BarHeight), FSlateLayoutTransform(SlotPosition + FVector2D(BarInset, Size - BarHeight))),
+				&SolidBrush, DrawEffect, Style.GetRarityColors(Slot->Rarity).Primary * Tint);
+
+			// Stack count, bottom-right above the bar
+			if (Slot->bShowStackCount)
+			{
+				const FVector2D TextPosition = SlotPosition + FVector2D(
+					Size - Slot->StackCountSize.X - Style.BorderWidth * 2.0f,
+					Size - Slot->StackCountSize.Y - BarHeight - Style.BorderWidth);
+				FSlateDrawElement::MakeBox(OutDrawElements, ContentLayer,
+					AllottedGeometry.ToPaintGeometry(Slot->StackCountSize + FVector2D(4.0f, 0.0f), FSlateLayoutTransform(TextPosition - FVector2D(2.0f, 0.0f))),
+					&SolidBrush, DrawEffect, Style.StackCountBackground * Tint);
+				FSlateDrawElement::MakeText(OutDrawElements, TextLayer,
+					AllottedGeometry.ToPaintGeometry(Slot->StackCountSize, FSlateLayoutTransform(TextPosition)),
+					Slot->StackCountText, StackCountFont, DrawEffect,
+					(Slot->bFullStack ? Style.StackCountFullText : Style.StackCountText) * Tint);
+			}
+		}
+	}
+
+	// Selection outline on top
+	if (SelectedIndex != INDEX_NONE && SelectedIndex / Columns >= FirstRow && SelectedIndex / Columns <= LastRow)
+	{
+		const FVector2D SlotPosition((SelectedIndex % Columns) * Pitch, (SelectedIndex / Columns) * Pitch);
+		FSlateDrawElement::MakeBox(OutDrawElements, SelectionLayer,
+			AllottedGeometry.ToPaintGeometry(FVector2D(Size, Size), FSlateLayoutTransform(SlotPosition)),
+			&SelectionBrush, DrawEffect, Style.SelectedBorder * Tint);
+	}
+
+	return SelectionLayer;
+}
+
+// ----------------------------------------
+// Input
+// ----------------------------------------
+
+int32 SInventoryGrid::GetSlotIndexAt(const FVector2D& LocalPosition) const
+{
+	if (LocalPosition.X < 0.0f || LocalPosition.Y < 0.0f)
+	{
+		return INDEX_NONE;
+	}
+
+	const float Pitch = GetSlotPitch();
+	const int32 Column = FMath::FloorToInt(LocalPosition.X / Pitch);
+	const int32 Row = FMath::FloorToInt(LocalPosition.Y / Pitch);
+
+	// Inside the padding between two slots
+	if (LocalPosition.X - Column * Pitch >= Style.SlotSize || LocalPosition.Y - Row * Pitch >= Style.SlotSize)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 SlotIndex = Row * Columns + Column;
+	return (Column < Columns && SlotIndex < GetNumSlots()) ? SlotIndex : INDEX_NONE;
+}
+
+FReply SInventoryGrid::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton)
+	{
+		return FReply::Unhandled();
+	}
+
+	const int32 SlotIndex = GetSlotIndexAt(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+	if (SlotIndex == INDEX_NONE)
+	{
+		return FReply::Unhandled();
+	}
+
+	OnSlotClicked.ExecuteIfBound(SlotIndex);
+	return FReply::Handled();
+}
+
+FReply SInventoryGrid::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	SetHoveredIndex(GetSlotIndexAt(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition())));
+	return FReply::Unhandled();
+}
+
+void SInventoryGrid::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+	SetHoveredIndex(INDEX_NONE);
+}
+
+void SInventoryGrid::SetHoveredIndex(int32 SlotIndex)
+{
+	if (SlotIndex != HoveredIndex)
+	{
+		HoveredIndex = SlotIndex;
+		OnSlotHovered.ExecuteIfBound(SlotIndex);
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
@@ -0,0 +1,172 @@
+// SInventoryGrid.h
+// Native Slate grid that paints inventory slots directly
+// One widget for the whole grid - no per-slot widget tree
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Brushes/SlateRoundedBoxBrush.h"
+#include "Brushes/SlateColorBrush.h"
+#include "UI/InventoryStyleTypes.h"
+
+class UInventoryItemData;
+class UTexture2D;
+class FInventoryIconCache;
+
+DECLARE_DELEGATE_OneParam(FOnInventoryGridSlotEvent, int32 /*SlotIndex*/);
+
+/**
+ * Fast-path inventory grid
+ *
+ * Every slot (background, rarity bar, icon, stack count, selection outline) is emitted as
+ * draw elements from OnPaint, so hundreds of slots cost one widget's prepass and paint.
+ * Only rows inside the culling rect are painted. Hit testing is arithmetic on the local
+ * cursor position (column/row from the slot pitch), not a widget hierarchy walk.
+ *
+ * Slots hold copies of what they display, refreshed through SetItems/RefreshSlot, so paint
+ * never touches UObjects. Wrapped for UMG by UInventoryGridPanel.
+ *
+ * With an icon cache, icons are pinned only for the rows that were last painted and streamed
+ * in asynchronously (a placeholder is drawn until they arrive); rows that scroll away unpin
+ * theirs, leaving the cache to evict them once over its budget.
+ */
+class ADAPTIVEINVENTORY_API SInventoryGrid : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SInventoryGrid)
+		: _Columns(5)
+		, _MinimumSlots(0)
+	{}
+		/** Slots per row */
+		SLATE_ARGUMENT(int32, Columns)
+		/** Empty slots shown when there are fewer items */
+		SLATE_ARGUMENT(int32, MinimumSlots)
+		/** Colors and dimensions shared with UInventorySlotWidget */
+		SLATE_ARGUMENT(FInventorySlotStyle, SlotStyle)
+		/** Where icons are streamed from (none = only icons that are already loaded show) */
+		SLATE_ARGUMENT(TSharedPtr<FInventoryIconCache>, IconCache)
+		/** Left click on a slot */
+		SLATE_EVENT(FOnInventoryGridSlotEvent, OnSlotClicked)
+		/** Cursor moved onto a slot (INDEX_NONE when it leaves the slots) */
+		SLATE_EVENT(FOnInventoryGridSlotEvent, OnSlotHovered)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SInventoryGrid() override;
+
+	/** Show a list of items, one per slot */
+	void SetItems(TConstArrayView<UInventoryItemData*> Items);
+
+	/** Re-read one slot's item (stack count, icon, rarity) */
+	void RefreshSlot(int32 SlotIndex, const UInventoryItemData* Item);
+
+	/**
+	 * Resize to a new item list but only re-read the slots that changed
+	 * @param Items - Every item, one per slot, as SetItems takes them
+	 * @param ChangedSlots - Slots whose item differs from what they show, including every slot past the old end
+	 */
+	void UpdateSlots(TConstArrayView<UInventoryItemData*> Items, TConstArrayView<int32> ChangedSlots);
+
+	void SetSelectedIndex(int32 SlotIndex);
+	int32 GetSelectedIndex() const { return SelectedIndex; }
+
+	void SetColumns(int32 InColumns);
+	void SetMinimumSlots(int32 InMinimumSlots);
+	void SetSlotStyle(const FInventorySlotStyle& InStyle);
+	void SetIconCache(const TSharedPtr<FInventoryIconCache>& InIconCache);
+
+	/** Slot under a local-space position, or INDEX_NONE (gaps between slots don't count) */
+	int32 GetSlotIndexAt(const FVector2D& LocalPosition) const;
+
+	//~ Begin SWidget Interface
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+	//~ End SWidget Interface
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	/** What one slot paints */
+	struct FSlotDrawData
+	{
+		bool bHasItem = false;
+		EItemRarity Rarity = EItemRarity::Common;
+		bool bShowStackCount = false;
+		bool bFullStack = false;
+		FText StackCountText;
+		/** Measured once when the count changes, so paint can right-align without measuring */
+		FVector2D StackCountSize = FVector2D::ZeroVector;
+		TSoftObjectPtr<UTexture2D> Icon;
+		/** Holds a pin on Icon in the icon cache (the brush only points at pinned textures) */
+		bool bIconPinned = false;
+		FSlateBrush IconBrush;
+	};
+
+	/**
+	 * Copy what an item displays into a slot
+	 * @param OutReleasedPins - Receives the slot's pinned icon if the item shows a different one
+	 */
+	void FillSlot(FSlotDrawData& Slot, const UInventoryItemData* Item, TArray<TSoftObjectPtr<UTexture2D>>& OutReleasedPins) const;
+
+	/** Pin icons for the painted slots and unpin those no longer painted */
+	void UpdateIconPins();
+
+	/** Unpin every slot's icon, adding them to OutReleasedPins */
+	void TakeIconPins(TArray<TSoftObjectPtr<UTexture2D>>& OutReleasedPins);
+
+	/** Hand pins back to the cache (after the replacements are pinned, so shared icons stay loaded) */
+	void ReleaseIconPins(TConstArrayView<TSoftObjectPtr<UTexture2D>> Pins) const;
+
+	void HandleIconLoaded(const FSoftObjectPath& IconPath);
+
+	/** Rebuild the brushes that depend on the style */
+	void UpdateBrushes();
+
+	int32 GetNumSlots() const { return FMath::Max(Slots.Num(), MinimumSlots); }
+	float GetSlotPitch() const { return Style.SlotSize + Style.SlotPadding; }
+
+	void SetHoveredIndex(int32 SlotIndex);
+
+	TArray<FSlotDrawData> Slots;
+
+	FInventorySlotStyle Style;
+	int32 Columns = 5;
+	int32 MinimumSlots = 0;
+
+	int32 SelectedIndex = INDEX_NONE;
+	int32 HoveredIndex = INDEX_NONE;
+
+	/** Filled rounded rectangle (tinted per slot) */
+	FSlateRoundedBoxBrush BackgroundBrush = FSlateRoundedBoxBrush(FLinearColor::White, 10.0f);
+
+	/** Rounded outline for the selected slot */
+	FSlateRoundedBoxBrush SelectionBrush = FSlateRoundedBoxBrush(FLinearColor::Transparent, 10.0f, FLinearColor::White, 2.0f);
+
+	/** Plain rectangle for the rarity bar and the stack count backing */
+	FSlateColorBrush SolidBrush = FSlateColorBrush(FLinearColor::White);
+
+	/** Style's placeholder icon, drawn while an icon streams in */
+	FSlateBrush PlaceholderBrush;
+
+	TWeakPtr<FInventoryIconCache> IconCache;
+	FDelegateHandle IconLoadedHandle;
+
+	/** Slots inside the culling rect at the last paint (inclusive, empty when Last < First) */
+	mutable int32 PaintedFirstSlot = 0;
+	mutable int32 PaintedLastSlot = INDEX_NONE;
+
+	/** Range whose icons are currently pinned - every pinned slot is inside it */
+	int32 PinnedFirstSlot = 0;
+	int32 PinnedLastSlot = INDEX_NONE;
+
+	FSlateFontInfo StackCountFont;
+
+	FOnInventoryGridSlotEvent OnSlotClicked;
+	FOnInventoryGridSlotEvent OnSlotHovered;
+};